@@ -0,0 +1,219 @@
+/**
+ * @file flat_ast_bench.cc
+ * @author kmc7468
+ * @brief FlatAST의 preprocess, evaluate 함수와 포인터로 연결된 추상 구문 트리의 Node::preprocess, Expression::evaluate 함수를 비교하는 벤치마크입니다.
+ * @details 깊게 중첩된 상수 식을 가진 함수들로 이루어진 Dlink 코드를 만들어 파싱하고 FlatAST로 변환한 뒤, 두 방법의 결과가 같은지 확인하고 각각 걸린 시간을 출력합니다.
+ * 사용법: flat_ast_bench [함수 개수] [식의 깊이] [반복 횟수]
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "Assembler.hh"
+#include "CompileOptions.hh"
+#include "FlatAST.hh"
+#include "Lexer.hh"
+#include "Optimizer.hh"
+#include "Parser.hh"
+#include "SourceFile.hh"
+
+namespace
+{
+	// 0으로 나누거나 값이 넘치지 않도록, 피연산자의 크기를 늘리지 않는 연산자와 1 이상의 상수만 사용합니다.
+	std::string make_expression(std::mt19937& random, std::size_t depth, bool is_constant)
+	{
+		static const char* const operators[] = { " + ", " - ", " & ", " | ", " ^ ", " / ", " % " };
+		std::uniform_int_distribution<std::size_t> op(0, sizeof(operators) / sizeof(*operators) - 1);
+		std::uniform_int_distribution<int> literal(1, 9);
+		std::uniform_int_distribution<int> unary(0, 7);
+
+		std::string result = std::to_string(literal(random));
+		for (std::size_t i = 0; i < depth; ++i)
+		{
+			const std::string rhs = !is_constant && i == depth / 2 ? std::string("a") : std::to_string(literal(random));
+
+			switch (unary(random))
+			{
+			case 0:
+				result = "-(" + result + operators[op(random)] + rhs + ")";
+				break;
+			case 1:
+				result = "~(" + result + operators[op(random)] + rhs + ")";
+				break;
+			default:
+				result = "(" + result + operators[op(random)] + rhs + ")";
+				break;
+			}
+		}
+		return result;
+	}
+	std::string make_source(std::size_t function_count, std::size_t depth)
+	{
+		std::mt19937 random(7468);
+		std::string result;
+
+		for (std::size_t i = 0; i < function_count; ++i)
+		{
+			result += "int f" + std::to_string(i) + "(int a)\n{\n";
+			result += "\tint x = " + make_expression(random, depth, true) + ";\n";
+			result += "\tint y = " + make_expression(random, depth, false) + ";\n";
+			result += "\treturn x + y;\n}\n";
+		}
+		result += "int main()\n{\n\treturn 0;\n}\n";
+		return result;
+	}
+
+	bool is_same(bool lhs_ok, const Dlink::Any& lhs, bool rhs_ok, const Dlink::Any& rhs)
+	{
+		if (lhs_ok != rhs_ok) return false;
+		if (!lhs_ok) return true;
+		if (lhs.type() != rhs.type()) return false;
+
+		if (lhs.type() == typeid(std::int64_t)) return lhs.get<std::int64_t>() == rhs.get<std::int64_t>();
+		if (lhs.type() == typeid(std::uint64_t)) return lhs.get<std::uint64_t>() == rhs.get<std::uint64_t>();
+		return true;
+	}
+
+	template<typename Function_>
+	double measure(std::size_t repeat, Function_&& function)
+	{
+		double nanoseconds = 0;
+		for (std::size_t r = 0; r < repeat; ++r)
+		{
+			nanoseconds += function();
+		}
+		return nanoseconds / static_cast<double>(repeat) / 1000000.0;
+	}
+	template<typename Function_>
+	double elapsed(Function_&& function)
+	{
+		const auto begin = std::chrono::steady_clock::now();
+		function();
+		const auto end = std::chrono::steady_clock::now();
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const std::size_t function_count = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 2000;
+	const std::size_t depth = argc > 2 ? static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10)) : 64;
+	const std::size_t repeat = argc > 3 ? static_cast<std::size_t>(std::strtoull(argv[3], nullptr, 10)) : 20;
+
+	Dlink::SourceFile source(make_source(function_count, depth));
+	Dlink::Lexer lexer(source);
+	Dlink::Parser parser(lexer);
+	if (!parser.parse())
+	{
+		std::cerr << "Parsing Failed\n";
+		return 1;
+	}
+
+	Dlink::AST& ast = parser.get_ast();
+	Dlink::FlatAST flat_ast(ast);
+
+	// 상위 노드가 식이 아닌 식들입니다. 후위 순회 순서이므로 뒤에서부터 하위 트리를 건너뛰며 찾습니다.
+	std::vector<std::uint32_t> expressions;
+	for (std::uint32_t end = flat_ast.size(); end > 0;)
+	{
+		const std::uint32_t index = end - 1;
+		if (Dlink::isa<Dlink::Expression>(flat_ast.node(index)))
+		{
+			expressions.push_back(index);
+			end -= flat_ast.subtree_size(index);
+		}
+		else
+		{
+			--end;
+		}
+	}
+
+	for (std::uint32_t index : expressions)
+	{
+		Dlink::Any flat_value, node_value;
+		const bool flat_ok = flat_ast.evaluate(index, flat_value);
+		const bool node_ok = Dlink::cast<Dlink::Expression>(flat_ast.node(index))->evaluate(node_value);
+
+		if (!is_same(flat_ok, flat_value, node_ok, node_value))
+		{
+			std::cerr << "evaluate mismatch at offset " << flat_ast.offset(index) << '\n';
+			return 1;
+		}
+	}
+
+	const Dlink::CompileOptions options;
+	const std::shared_ptr<Dlink::Optimizer> optimizer = std::make_shared<Dlink::Optimizer>(options);
+	std::vector<const Dlink::FunctionDeclaration*> node_declarations, flat_declarations;
+
+	const double node_preprocess = measure(repeat, [&]()
+	{
+		Dlink::Assembler assembler(ast, options, optimizer);
+		const double result = elapsed([&]() { assembler.preprocess(); });
+		node_declarations.assign(assembler.get_code_gen_state().declarations.begin(), assembler.get_code_gen_state().declarations.end());
+		return result;
+	});
+	const double flat_preprocess = measure(repeat, [&]()
+	{
+		Dlink::Assembler assembler(ast, options, optimizer);
+		const double result = elapsed([&]() { assembler.preprocess(flat_ast); });
+		flat_declarations.assign(assembler.get_code_gen_state().declarations.begin(), assembler.get_code_gen_state().declarations.end());
+		return result;
+	});
+
+	if (node_declarations != flat_declarations)
+	{
+		std::cerr << "preprocess order mismatch\n";
+		return 1;
+	}
+
+	std::size_t checksum = 0;
+	const double node_evaluate = measure(repeat, [&]()
+	{
+		return elapsed([&]()
+		{
+			for (std::uint32_t index : expressions)
+			{
+				Dlink::Any value;
+				checksum += Dlink::cast<Dlink::Expression>(flat_ast.node(index))->evaluate(value);
+			}
+		});
+	});
+	const double flat_evaluate = measure(repeat, [&]()
+	{
+		return elapsed([&]()
+		{
+			for (std::uint32_t index : expressions)
+			{
+				Dlink::Any value;
+				checksum += flat_ast.evaluate(index, value);
+			}
+		});
+	});
+	const double conversion = measure(repeat, [&]()
+	{
+		return elapsed([&]()
+		{
+			Dlink::FlatAST converted(ast);
+			checksum += converted.size();
+		});
+	});
+
+	// 결과를 사용해야 컴파일러가 반복문을 지우지 않습니다.
+	if (checksum == 0) std::cerr << "";
+
+	std::cout << "nodes: " << flat_ast.size() << ", expressions: " << expressions.size() << ", repeat: " << repeat << '\n';
+	std::cout << "FlatAST conversion:  " << conversion << " ms\n";
+	std::cout << "Node::preprocess:    " << node_preprocess << " ms\n";
+	std::cout << "FlatAST::preprocess: " << flat_preprocess << " ms\n";
+	std::cout << "Expression::evaluate: " << node_evaluate << " ms\n";
+	std::cout << "FlatAST::evaluate:    " << flat_evaluate << " ms\n";
+	return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file keyword_bench.cc
+ * @author kmc7468
+ * @brief keyword_type 함수와 예전 Lexer의 std::map 키워드 탐색을 비교하는 마이크로벤치마크입니다.
+ * @details 키워드와 식별자를 섞은 목록을 만들어 두 방법으로 모두 분류하고, 결과가 같은지 확인한 뒤 식별자 하나당 걸린 시간을 출력합니다.
+ * 사용법: keyword_bench [반복 횟수]
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Token.hh"
+
+namespace
+{
+	// 예전 Lexer::Lexer가 채우던 것과 같은 내용입니다. literal은 들어 있지 않았습니다.
+	std::map<std::string, Dlink::TokenType> make_keyword_map()
+	{
+		std::map<std::string, Dlink::TokenType> keyword_map;
+		keyword_map["unsafe"] = Dlink::TokenType::unsafe;
+		keyword_map["if"] = Dlink::TokenType::_if;
+		keyword_map["else"] = Dlink::TokenType::_else;
+		keyword_map["switch"] = Dlink::TokenType::_switch;
+		keyword_map["case"] = Dlink::TokenType::_case;
+		keyword_map["for"] = Dlink::TokenType::_for;
+		keyword_map["while"] = Dlink::TokenType::_while;
+		keyword_map["do"] = Dlink::TokenType::_do;
+		keyword_map["break"] = Dlink::TokenType::_break;
+		keyword_map["continue"] = Dlink::TokenType::_continue;
+		keyword_map["return"] = Dlink::TokenType::_return;
+		keyword_map["null"] = Dlink::TokenType::_null;
+		keyword_map["const"] = Dlink::TokenType::_const;
+
+		keyword_map["unsigned"] = Dlink::TokenType::_unsigned;
+		keyword_map["signed"] = Dlink::TokenType::_signed;
+		keyword_map["char"] = Dlink::TokenType::_char;
+		keyword_map["short"] = Dlink::TokenType::_short;
+		keyword_map["int"] = Dlink::TokenType::_int;
+		keyword_map["long"] = Dlink::TokenType::_long;
+		keyword_map["void"] = Dlink::TokenType::_void;
+		return keyword_map;
+	}
+
+	// 예전 Lexer와 같이 임시 문자열을 만들고, find로 확인한 뒤 operator[]로 다시 찾습니다.
+	Dlink::TokenType map_keyword_type(std::map<std::string, Dlink::TokenType>& keyword_map, const char* data, std::size_t length)
+	{
+		std::string temp(data, length);
+		if (keyword_map.find(temp) != keyword_map.end())
+			return keyword_map[temp];
+		return Dlink::TokenType::identifier;
+	}
+
+	// 생성된 코드와 비슷하게 식별자의 약 3분의 1이 키워드가 되도록, 키워드와 흔한 식별자, 키워드와 길이나 첫 글자가 같은 식별자를 섞습니다.
+	std::vector<std::string> make_identifiers(std::size_t count)
+	{
+		static const char* const keywords[] =
+		{
+			"int", "int", "int", "if", "else", "for", "while", "return", "return", "void",
+			"char", "long", "short", "unsigned", "signed", "const", "break", "continue", "do",
+			"switch", "case", "null", "unsafe",
+		};
+		static const char* const identifiers[] =
+		{
+			"i", "j", "k", "n", "x", "y", "value", "result", "count", "index", "size", "buffer",
+			"data", "main", "sum", "temp", "left", "right", "node", "length", "offset", "matrix",
+			"weight", "bias", "input", "output", "kernel", "stride", "get_value", "set_value",
+			"in", "id", "fn", "iter", "cast", "char_count", "casev", "swap", "sign", "unsafe_ptr",
+			"continue_", "long_value", "voids", "interval", "format", "retval", "layer0", "layer1",
+			"literal",
+		};
+
+		std::mt19937 random(7468);
+		std::uniform_int_distribution<int> kind(0, 2);
+		std::uniform_int_distribution<std::size_t> keyword(0, sizeof(keywords) / sizeof(*keywords) - 1);
+		std::uniform_int_distribution<std::size_t> identifier(0, sizeof(identifiers) / sizeof(*identifiers) - 1);
+
+		std::vector<std::string> result;
+		result.reserve(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			result.push_back(kind(random) == 0 ? keywords[keyword(random)] : identifiers[identifier(random)]);
+		}
+		return result;
+	}
+
+	template<typename Function_>
+	double measure(const std::vector<std::string>& identifiers, std::size_t repeat, Function_&& function)
+	{
+		std::uint64_t checksum = 0;
+
+		const auto begin = std::chrono::steady_clock::now();
+		for (std::size_t r = 0; r < repeat; ++r)
+		{
+			for (const std::string& identifier : identifiers)
+			{
+				checksum += static_cast<std::uint64_t>(function(identifier.data(), identifier.size()));
+			}
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		// 결과를 사용해야 컴파일러가 반복문을 지우지 않습니다.
+		if (checksum == 0) std::cerr << "";
+
+		const double nanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+		return nanoseconds / static_cast<double>(identifiers.size() * repeat);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const std::size_t repeat = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 200;
+	const std::vector<std::string> identifiers = make_identifiers(10000);
+	std::map<std::string, Dlink::TokenType> keyword_map = make_keyword_map();
+
+	for (const std::string& identifier : identifiers)
+	{
+		if (Dlink::keyword_type(identifier.data(), identifier.size()) != map_keyword_type(keyword_map, identifier.data(), identifier.size()))
+		{
+			std::cerr << "mismatch: " << identifier << '\n';
+			return 1;
+		}
+	}
+
+	const double map_time = measure(identifiers, repeat, [&keyword_map](const char* data, std::size_t length)
+	{
+		return map_keyword_type(keyword_map, data, length);
+	});
+	const double switch_time = measure(identifiers, repeat, [](const char* data, std::size_t length)
+	{
+		return Dlink::keyword_type(data, length);
+	});
+
+	std::cout << "identifiers: " << identifiers.size() << " x " << repeat << '\n';
+	std::cout << "std::map:     " << map_time << " ns/identifier\n";
+	std::cout << "keyword_type: " << switch_time << " ns/identifier\n";
+	std::cout << "speedup:      " << map_time / switch_time << "x\n";
+	return 0;
+}
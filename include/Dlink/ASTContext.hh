@@ -0,0 +1,72 @@
+#pragma once
+
+/**
+ * @file ASTContext.hh
+ * @author kmc7468
+ * @brief ASTContext 클래스를 정의합니다.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Dlink
+{
+	/**
+	 * @brief 추상 구문 트리의 노드들을 소유하는 아레나입니다.
+	 * @details 노드는 큰 메모리 블록에서 포인터를 밀어 올리며 할당하므로 메모리에 연속적으로 놓이며, 노드마다 malloc을 호출하거나 참조 횟수를 세지 않습니다.
+	 * 노드는 따로 해제할 수 없고, ASTContext가 소멸될 때 만들어진 역순으로 한꺼번에 소멸됩니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	class ASTContext final
+	{
+	public:
+		ASTContext() noexcept;
+		ASTContext(const ASTContext& context) = delete;
+		ASTContext(ASTContext&& context) noexcept;
+		~ASTContext();
+
+	public:
+		ASTContext& operator=(const ASTContext& context) = delete;
+		ASTContext& operator=(ASTContext&& context) noexcept;
+		bool operator==(const ASTContext& context) const noexcept = delete;
+		bool operator!=(const ASTContext& context) const noexcept = delete;
+
+	public:
+		/**
+		 * @brief 아레나에 새 노드를 만듭니다.
+		 * @param args 노드의 생성자에 전달할 인수들입니다.
+		 * @return 만들어진 노드를 가리키는 포인터를 반환합니다. 이 포인터는 ASTContext가 소멸될 때까지 유효합니다.
+		 */
+		template<typename Node_, typename... Args_>
+		Node_* create(Args_&&... args)
+		{
+			void* memory = allocate(sizeof(Node_), alignof(Node_));
+			Node_* node = new(memory) Node_(std::forward<Args_>(args)...);
+
+			if (!std::is_trivially_destructible<Node_>::value)
+			{
+				destructors_.emplace_back(node, [](void* node)
+				{
+					static_cast<Node_*>(node)->~Node_();
+				});
+			}
+
+			return node;
+		}
+		void* allocate(std::size_t size, std::size_t alignment);
+		void clear() noexcept;
+
+	private:
+		/** 한 번에 할당하는 메모리 블록의 크기입니다. */
+		static constexpr std::size_t block_size_ = 64 * 1024;
+
+		std::vector<std::unique_ptr<char[]>> blocks_;
+		char* current_;
+		char* end_;
+
+		std::vector<std::pair<void*, void(*)(void*)>> destructors_;
+	};
+}
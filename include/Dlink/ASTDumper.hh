@@ -0,0 +1,139 @@
+#pragma once
+
+/**
+ * @file ASTDumper.hh
+ * @author kmc7468
+ * @brief ASTDumper 클래스를 정의합니다.
+ */
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ASTVisitor.hh"
+#include "Token.hh"
+
+namespace Dlink
+{
+	struct Node;
+	struct Type;
+
+	/**
+	 * @brief 추상 구문 트리를 출력하는 형식입니다.
+	 */
+	enum class ASTDumpFormat
+	{
+		None, /**< 출력하지 않습니다. */
+		Tree, /**< 들여쓰기로 구조를 나타내는 사람이 읽기 위한 형식입니다. */
+		JSON, /**< 한 줄에 노드 하나를 JSON 객체로 나타내는 형식입니다. */
+	};
+
+	/**
+	 * @brief 추상 구문 트리를 스트림에 바로 출력하는 방문자입니다.
+	 * @details 노드를 방문하면 그 노드의 내용만 출력하고, 하위 노드는 명시적 스택에 남겨 두었다가 차례로 방문합니다. 출력은 내부 버퍼에 모았다가 스트림에 씁니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	class ASTDumper final : public ASTVisitor
+	{
+	public:
+		ASTDumper(std::ostream& stream, ASTDumpFormat format = ASTDumpFormat::Tree);
+		ASTDumper(const ASTDumper& dumper) = delete;
+		ASTDumper(ASTDumper&& dumper) noexcept = delete;
+		~ASTDumper() override;
+
+	public:
+		ASTDumper& operator=(const ASTDumper& dumper) = delete;
+		ASTDumper& operator=(ASTDumper&& dumper) noexcept = delete;
+		bool operator==(const ASTDumper& dumper) const noexcept = delete;
+		bool operator!=(const ASTDumper& dumper) const noexcept = delete;
+
+	public:
+		void dump(const Node* node);
+		void flush();
+
+	private:
+		void visit(const Identifier& node) override;
+		void visit(const Block& node) override;
+		void visit(const Scope& node) override;
+		void visit(const ExpressionStatement& node) override;
+
+		void visit(const Integer32& node) override;
+		void visit(const String& node) override;
+		void visit(const Character& node) override;
+		void visit(const BinaryOperation& node) override;
+		void visit(const UnaryOperation& node) override;
+		void visit(const FunctionCallOperation& node) override;
+		void visit(const ArrayInitList& node) override;
+		void visit(const UnsafeExpression& node) override;
+		void visit(const ReturnStatement& node) override;
+		void visit(const UnsafeStatement& node) override;
+
+		void visit(const VariableDeclaration& node) override;
+		void visit(const FunctionDeclaration& node) override;
+
+		void visit(const SimpleType& node) override;
+		void visit(const StaticArray& node) override;
+		void visit(const LValueReference& node) override;
+		void visit(const Pointer& node) override;
+
+	private:
+		struct Field_
+		{
+			const char* name;
+			bool is_list;
+			const Node* node;
+			const Type* type;
+		};
+		struct Item_
+		{
+			const char* label;
+			bool is_empty;
+			const Node* node;
+			const Type* type;
+			std::size_t depth;
+			std::size_t parent;
+			const char* field;
+			std::size_t index;
+		};
+
+		void begin_(const char* kind, const Token& token, const std::string& value = std::string());
+		void attribute_(const char* name, const std::string& value);
+		void field_(const char* name, const Node* node);
+		void field_(const char* name, const Type* type);
+		void list_(const char* name);
+		void element_(const Node* node);
+		template<typename Node_>
+		void list_(const char* name, const std::vector<Node_*>& nodes)
+		{
+			list_(name);
+			for (const Node_* node : nodes)
+			{
+				element_(node);
+			}
+		}
+
+		void write_(const Item_& item);
+		void write_indent_(std::size_t depth);
+
+	private:
+		/** 이 값보다 내부 버퍼가 커지면 스트림에 씁니다. */
+		static constexpr std::size_t buffer_capacity_ = 64 * 1024;
+		/** 상위 노드나 리스트 안에서의 위치가 없음을 나타내는 번호입니다. */
+		static constexpr std::size_t none_ = static_cast<std::size_t>(-1);
+
+		std::ostream& stream_;
+		ASTDumpFormat format_;
+		std::string buffer_;
+		std::size_t next_id_ = 0;
+
+		std::vector<Item_> stack_;
+		std::vector<Item_> pending_;
+
+		const char* kind_ = nullptr;
+		Token token_;
+		std::string value_;
+		std::vector<std::pair<const char*, std::string>> attributes_;
+		std::vector<Field_> fields_;
+	};
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+/**
+ * @file ASTVisitor.hh
+ * @author kmc7468
+ * @brief ASTVisitor 클래스를 정의합니다.
+ */
+
+namespace Dlink
+{
+	struct Identifier;
+	struct Block;
+	struct Scope;
+	struct ExpressionStatement;
+
+	struct Integer32;
+	struct String;
+	struct Character;
+	struct BinaryOperation;
+	struct UnaryOperation;
+	struct FunctionCallOperation;
+	struct ArrayInitList;
+	struct UnsafeExpression;
+	struct ReturnStatement;
+	struct UnsafeStatement;
+
+	struct VariableDeclaration;
+	struct FunctionDeclaration;
+
+	struct SimpleType;
+	struct StaticArray;
+	struct LValueReference;
+	struct Pointer;
+
+	/**
+	 * @brief 추상 구문 트리의 노드를 방문하는 방문자의 루트 클래스입니다.
+	 * @details Node::accept와 Type::accept는 노드의 실제 타입에 맞는 visit 함수를 호출합니다. visit 함수는 하위 노드를 직접 방문하지 않아도 되므로, 트리가 깊으면 방문자가 명시적 스택으로 하위 노드를 방문할 수 있습니다.
+	 */
+	class ASTVisitor
+	{
+	public:
+		virtual ~ASTVisitor() = default;
+
+	public:
+		virtual void visit(const Identifier& node) = 0;
+		virtual void visit(const Block& node) = 0;
+		virtual void visit(const Scope& node) = 0;
+		virtual void visit(const ExpressionStatement& node) = 0;
+
+		virtual void visit(const Integer32& node) = 0;
+		virtual void visit(const String& node) = 0;
+		virtual void visit(const Character& node) = 0;
+		virtual void visit(const BinaryOperation& node) = 0;
+		virtual void visit(const UnaryOperation& node) = 0;
+		virtual void visit(const FunctionCallOperation& node) = 0;
+		virtual void visit(const ArrayInitList& node) = 0;
+		virtual void visit(const UnsafeExpression& node) = 0;
+		virtual void visit(const ReturnStatement& node) = 0;
+		virtual void visit(const UnsafeStatement& node) = 0;
+
+		virtual void visit(const VariableDeclaration& node) = 0;
+		virtual void visit(const FunctionDeclaration& node) = 0;
+
+		virtual void visit(const SimpleType& node) = 0;
+		virtual void visit(const StaticArray& node) = 0;
+		virtual void visit(const LValueReference& node) = 0;
+		virtual void visit(const Pointer& node) = 0;
+	};
+}
@@ -58,10 +58,12 @@ namespace Dlink
 			: data_(new RealData_<Ty_>(value))
 		{}
 		Any(const Any& any);
+		Any(Any&& any) noexcept;
 		~Any() = default;
 
 	public:
 		Any& operator=(const Any& any);
+		Any& operator=(Any&& any) noexcept;
 		bool operator==(const Any& any) const noexcept = delete;
 		bool operator!=(const Any& any) const noexcept = delete;
 
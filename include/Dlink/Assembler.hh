@@ -6,25 +6,33 @@
  * @breif Assembler 클래스를 정의합니다.
  */
 
+#include "CompileOptions.hh"
 #include "Message/Error.hh"
 #include "Message/Warning.hh"
+#include "Optimizer.hh"
 #include "ParseStruct.hh"
+#include "ThreadPool.hh"
+#include "TimeTrace.hh"
 
 #include "llvm/IR/IRBuilder.h"
-#include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
-#include "llvm/Transforms/Scalar.h"
 
-#include <map>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <thread>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace Dlink
 {
+	class FlatAST;
+	struct TypeSymbolTable;
+
 	/**
 	 * @brief 추상 구문 트리를 바탕으로 LLVM IR 코드나 어셈블리어 코드를 만듭니다.
-	 * @details 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 * @details 컴파일 작업 하나의 모든 상태를 인스턴스가 가지므로, 서로 다른 스레드에서 여러 인스턴스가 동시에 LLVM IR 코드를 만들 수 있습니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
 	 */
 	class Assembler final
 	{
@@ -35,16 +43,39 @@ namespace Dlink
 		 */
 		struct LLVMBuilder final
 		{
-			LLVMBuilder();
+			LLVMBuilder(const CompileOptions& options, std::shared_ptr<Optimizer> optimizer = nullptr);
 
 			llvm::LLVMContext context;
 			std::shared_ptr<llvm::Module> module;
 			llvm::IRBuilder<> builder;
-			std::unique_ptr<llvm::legacy::FunctionPassManager> function_pm;
+			std::shared_ptr<Optimizer> optimizer;
+		};
+		/**
+		 * @brief LLVM IR 코드를 만드는 동안 노드들이 공유하는 상태입니다.
+		 * @details 이 구조체는 다른 곳에서 상속받을 수 없습니다.
+		 */
+		struct CodeGenState final
+		{
+			CodeGenState();
+
+			/** 현재 사용자 정의 타입 심볼 테이블입니다. */
+			std::shared_ptr<TypeSymbolTable> type_symbol_table;
+			/** 현재 code_gen 중인 함수입니다. */
+			FunctionDeclaration* current_func = nullptr;
+			/** 지금 안전하지 않은 블록 안에 있는지 여부입니다. */
+			bool in_unsafe_block = false;
+			/** 이 Assembler의 모듈에 선언된 각 함수의 LLVM Function입니다. */
+			std::unordered_map<const FunctionDeclaration*, llvm::Function*> functions;
+			/** 이 Assembler가 코드를 만든 각 변수의 주소입니다. */
+			std::unordered_map<const VariableDeclaration*, LLVM::Value> variables;
+			/** preprocess_node가 호출된 순서대로 나열한 함수 선언들입니다. */
+			std::vector<FunctionDeclaration*> declarations;
+			/** 코드를 만들고 있는 함수들의 코드 생성을 시작한 시간입니다. TimeTrace 인스턴스가 있을 때만 사용합니다. */
+			std::vector<std::uint64_t> function_begins;
 		};
 
 	public:
-		Assembler(AST& ast);
+		Assembler(AST& ast, const CompileOptions& options = CompileOptions(), std::shared_ptr<Optimizer> optimizer = nullptr, TimeTrace* time_trace = nullptr);
 		Assembler(const Assembler& assembler) = delete;
 		Assembler(Assembler&& assembler) noexcept = delete;
 		~Assembler();
@@ -57,20 +88,51 @@ namespace Dlink
 
 	public:
 		bool to_llvm_ir();
+		bool to_llvm_ir(ThreadPool& thread_pool);
+		bool preprocess();
+		bool preprocess(FlatAST& flat_ast);
 		LLVMBuilder& get_llvm_builder() noexcept;
 		const LLVMBuilder& get_llvm_builder() const noexcept;
+		CodeGenState& get_code_gen_state() noexcept;
+		const CompileOptions& get_options() const noexcept;
+		TimeTrace* get_time_trace() const noexcept;
 		const Errors& get_errors() const noexcept;
 		Warnings& get_warnings() noexcept;
 		const Warnings& get_warnings() const noexcept;
 
 	public:
-		static std::map<std::thread::id, Assembler*> assemblers;
+		static Assembler* current() noexcept;
+
+		/** 최상위 함수가 이 값보다 적으면 to_llvm_ir(ThreadPool&) 함수가 병렬로 코드를 만들지 않습니다. */
+		static constexpr std::size_t parallel_threshold = 64;
+
+	private:
+		/**
+		 * @brief 생성된 동안 현재 스레드의 인스턴스를 바꾸고, 소멸될 때 원래대로 되돌립니다.
+		 * @details 이 구조체는 다른 곳에서 상속받을 수 없습니다.
+		 */
+		struct CurrentGuard_ final
+		{
+			CurrentGuard_(Assembler* assembler) noexcept;
+			~CurrentGuard_();
+
+			Assembler* previous;
+		};
+
+		bool lower_functions_(const std::vector<FunctionDeclaration*>& declarations, std::size_t begin, std::size_t end);
 
 	private:
+		/** 현재 스레드에서 LLVM IR 코드를 만들고 있는 인스턴스입니다. */
+		static thread_local Assembler* current_;
+
 		AST& ast_;
+		CompileOptions options_;
 		LLVMBuilder builder_;
+		CodeGenState state_;
+		TimeTrace* time_trace_;
 
 		Errors errors_;
 		Warnings warnings_;
+		std::string bitcode_;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+
+/**
+ * @file Cache.hh
+ * @author kmc7468
+ * @brief Cache 클래스와 JITCache 클래스를 정의합니다.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include "CompileOptions.hh"
+#include "SourceFile.hh"
+
+namespace Dlink
+{
+	/**
+	 * @brief 컴파일 결과를 디스크에 저장하는 내용 주소 캐시입니다.
+	 * @details 항목의 키는 소스 파일의 내용과 최적화 레벨, 대상 플랫폼, 컴파일러 버전으로 계산하므로, 이 중 하나라도 바뀌면 이전 항목을 사용하지 않습니다.
+	 * 항목은 임시 파일에 쓴 뒤 이름을 바꿔 저장하므로, 여러 프로세스가 같은 디렉토리를 동시에 사용하더라도 다른 프로세스가 쓰다 만 항목을 읽지 않습니다. 디렉토리의 크기가 설정된 크기를 넘으면 가장 오래 사용하지 않은 항목부터 지웁니다.
+	 * 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	class Cache final
+	{
+	public:
+		Cache(const CompileOptions& options, const SourceFile& source);
+		Cache(const Cache& cache) = delete;
+		Cache(Cache&& cache) noexcept = delete;
+		~Cache() = default;
+
+	public:
+		Cache& operator=(const Cache& cache) = delete;
+		Cache& operator=(Cache&& cache) noexcept = delete;
+		bool operator==(const Cache& cache) const noexcept = delete;
+		bool operator!=(const Cache& cache) const noexcept = delete;
+
+	public:
+		bool load(const std::string& kind, std::string& data);
+		bool store(const std::string& kind, llvm::StringRef data);
+
+	private:
+		std::string path_(const std::string& kind) const;
+
+	private:
+		/** 디렉토리를 정리한 뒤 다시 정리하기까지 기다리는 시간(초)입니다. */
+		static constexpr int prune_interval_ = 60;
+
+		std::string directory_;
+		std::uint64_t max_size_;
+		std::string digest_;
+	};
+
+	/**
+	 * @brief JIT 컴파일러가 컴파일한 목적 코드를 Cache에 저장하고 불러옵니다.
+	 * @details 모듈 식별자를 키에 포함하므로, JIT 컴파일러가 함수 단위로 나눈 모듈마다 따로 저장합니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	class JITCache final : public llvm::ObjectCache
+	{
+	public:
+		JITCache(Cache& cache, const std::string& target);
+		JITCache(const JITCache& jit_cache) = delete;
+		JITCache(JITCache&& jit_cache) noexcept = delete;
+		~JITCache() override = default;
+
+	public:
+		JITCache& operator=(const JITCache& jit_cache) = delete;
+		JITCache& operator=(JITCache&& jit_cache) noexcept = delete;
+		bool operator==(const JITCache& jit_cache) const noexcept = delete;
+		bool operator!=(const JITCache& jit_cache) const noexcept = delete;
+
+	public:
+		void notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef object) override;
+		std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override;
+
+	private:
+		Cache& cache_;
+		std::string target_;
+	};
+}
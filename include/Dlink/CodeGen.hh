@@ -11,15 +11,15 @@
 #include <string>
 
 #include "llvm/IR/IRBuilder.h"
-#include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
-#include "llvm/Transforms/Scalar.h"
 
 #include "Assembler.hh"
+#include "Optimizer.hh"
 #include "LLVMValue.hh"
 #include "Message/Error.hh"
 #include "Message/Warning.hh"
+#include "Symbol.hh"
 #include "ParseStruct/Root.hh"
 #include "ParseStruct/Declaration.hh"
 
@@ -30,29 +30,11 @@ namespace Dlink
 		llvm::LLVMContext& context();
 		std::shared_ptr<llvm::Module>& module();
 		llvm::IRBuilder<>& builder();
-		std::unique_ptr<llvm::legacy::FunctionPassManager>& function_pm();
+		Optimizer& optimizer();
 	}
 
 	Assembler& get_current_assembler();
 
-	/**
-	 * @brief 변수 및 상수, 함수 심볼 테이블입니다.
-	 * @details 사용할 수 있는 변수 및 상수, 함수 심볼을 저장합니다.
-	 * @details 이 구조체는 다른 곳에서 상속받을 수 없습니다.
-	 */
-	struct SymbolTable final
-	{
-		LLVM::Value find(const std::string& name);
-		bool find_bool(const std::string& name) const;
-
-		/** 현재 심볼 테이블의 상위 심볼 테이블입니다. */
-		std::shared_ptr<SymbolTable> parent = nullptr;
-		/** 변수 및 상수, 함수 심볼 목록입니다. */
-		std::map<std::string, LLVM::Value> map;
-	};
-	/** SymbolTable 구조체에 대한 std::shared_ptr 타입입니다. */
-	using SymbolTablePtr = std::shared_ptr<SymbolTable>;
-
 	/**
 	 * @brief 타입 심볼 테이블입니다.
 	 * @details 사용할 수 있는 사용자 정의 타입 심볼을 저장합니다.
@@ -71,9 +53,7 @@ namespace Dlink
 	/** TypeSymbolTable 구조체에 대한 std::shared_ptr 타입입니다. */
 	using TypeSymbolTablePtr = std::shared_ptr<TypeSymbolTable>;
 
-	extern SymbolTablePtr symbol_table;
-	extern TypeSymbolTablePtr type_symbol_table;
-	
-	extern std::shared_ptr<FunctionDeclaration> current_func;
-	extern bool in_unsafe_block;
+	TypeSymbolTablePtr& type_symbol_table();
+	FunctionDeclaration*& current_func();
+	bool& in_unsafe_block();
 }
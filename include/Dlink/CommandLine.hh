@@ -7,6 +7,7 @@
  */
 
 #include <cstdint>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -26,7 +27,20 @@ namespace Dlink
 
 			IR, /**< LLVM IR로 된 파일로 번역합니다. */
 			Optimize, /**< 최적화 수준입니다. */
-			Input, /**< 컴파일할 소스 파일입니다. */
+			Input, /**< 컴파일할 소스 파일입니다. 여러개 있으면 모두 컴파일합니다. */
+			Jobs, /**< 작업 스레드의 개수입니다. */
+			AST, /**< 추상 구문 트리의 출력 형식입니다. */
+			Object, /**< 목적 파일을 쓸 경로입니다. */
+			Assembly, /**< 어셈블리어 파일을 쓸 경로입니다. */
+			Bitcode, /**< LLVM 비트코드 파일을 쓸 경로입니다. */
+			Target, /**< 코드를 만들 대상 플랫폼의 트리플입니다. */
+			CPU, /**< 코드를 만들 대상 CPU입니다. */
+			Run, /**< 코드를 만든 뒤 JIT 컴파일해 실행합니다. */
+			Cache, /**< 컴파일 결과를 저장할 캐시 디렉토리입니다. */
+			CacheSize, /**< 캐시 디렉토리의 최대 크기(MiB)입니다. */
+			Server, /**< 표준 입력으로 컴파일 요청을 받는 서버 모드로 실행합니다. */
+			TimeTrace, /**< 컴파일 시간을 Chrome trace-event JSON 파일로 기록합니다. */
+			SplitObject, /**< 목적 파일을 만들 때 모듈을 나눠 여러 목적 파일로 만듭니다. */
 		};
 		/** @brief 파싱하는 도중 발생한 오류 타입입니다. */
 		enum Error
@@ -36,10 +50,26 @@ namespace Dlink
 
 			Multi_IR, /**< 명령줄에 /IR이 여러개 있습니다. */
 			Multi_Optimize, /**< 명령줄에 /O가 여러개 있습니다. */
+			Multi_Jobs, /**< 명령줄에 /J가 여러개 있습니다. */
+			Multi_AST, /**< 명령줄에 /AST가 여러개 있습니다. */
+			Multi_Object, /**< 명령줄에 /Obj가 여러개 있습니다. */
+			Multi_Assembly, /**< 명령줄에 /Asm이 여러개 있습니다. */
+			Multi_Bitcode, /**< 명령줄에 /BC가 여러개 있습니다. */
+			Multi_Target, /**< 명령줄에 /Target이 여러개 있습니다. */
+			Multi_CPU, /**< 명령줄에 /CPU가 여러개 있습니다. */
+			Multi_Run, /**< 명령줄에 /Run이 여러개 있습니다. */
+			Multi_Cache, /**< 명령줄에 /Cache가 여러개 있습니다. */
+			Multi_CacheSize, /**< 명령줄에 /CacheSize가 여러개 있습니다. */
+			Multi_Server, /**< 명령줄에 /Server가 여러개 있거나, 서버 모드에서 요청에 /Server가 있습니다. */
+			Server_Run, /**< 서버 모드에서 요청에 /Run이 있습니다. */
+			Multi_Input, /**< 명령줄에 /Run이 있지만 소스 파일이 여러개 있습니다. */
+			Multi_TimeTrace, /**< 명령줄에 /TimeTrace가 여러개 있습니다. */
+			Multi_SplitObject, /**< 명령줄에 /SplitObj가 여러개 있습니다. */
 
 			No_Input, /**< 컴파일할 소스 파일이 없습니다. */
 
 			CouldntFind_Input, /**< 컴파일할 소스 파일을 찾지 못했습니다. */
+			Conflicting_Output, /**< 소스 파일이 여러개일 때, 서로 다른 소스 파일의 출력 경로가 같습니다. */
 			Invalid_Value, /**< 명령의 설정 값에 오류가 있습니다. */
 		};
 
@@ -48,6 +78,7 @@ namespace Dlink
 		ParsedCommandLine(Type type, std::uintptr_t x);
 		ParsedCommandLine(Type type, std::uintptr_t x, std::uintptr_t y);
 		ParsedCommandLine(Type type, std::uintptr_t x, std::uintptr_t y, std::uintptr_t z);
+		ParsedCommandLine(Type type, const std::string& str);
 		/**
 		 * @brief ParsedCommandLine 인스턴스를 복사해 새 인스턴스를 만듭니다.
 		 * @param parsed_command_line 복사할 인스턴스입니다.
@@ -70,6 +101,8 @@ namespace Dlink
 		std::uintptr_t x;
 		std::uintptr_t y;
 		std::uintptr_t z;
+		/** 경로처럼 문자열인 값입니다. */
+		std::string str;
 	};
 
 	std::vector<ParsedCommandLine> ParseCommandLine(int argc, char** argv);
@@ -0,0 +1,52 @@
+#pragma once
+
+/**
+ * @file CompileOptions.hh
+ * @author kmc7468
+ * @brief CompileOptions 구조체를 정의합니다.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ASTDumper.hh"
+
+namespace Dlink
+{
+	/**
+	 * @brief 컴파일 작업 하나에 적용되는 설정입니다.
+	 * @details 전역 변수 대신 컴파일 작업마다 값으로 전달하므로, 한 프로세스에서 서로 다른 설정으로 여러 컴파일 작업을 동시에 실행할 수 있습니다. 이 구조체는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	struct CompileOptions final
+	{
+		/** 최적화 레벨입니다. */
+		long long opt_level = 0;
+		/** 작업 스레드의 개수입니다. 0이면 하드웨어가 동시에 실행할 수 있는 스레드의 개수를 사용합니다. */
+		std::size_t thread_count = 0;
+		/** 추상 구문 트리의 출력 형식입니다. */
+		ASTDumpFormat ast_format = ASTDumpFormat::Tree;
+		/** 코드를 만들 대상 플랫폼의 트리플입니다. 비어 있으면 현재 플랫폼을 대상으로 합니다. */
+		std::string target_triple;
+		/** 코드를 만들 대상 CPU입니다. 비어 있으면 generic을, native라면 현재 플랫폼의 CPU를 사용합니다. */
+		std::string target_cpu;
+		/** 목적 파일을 쓸 경로입니다. 비어 있으면 목적 파일을 만들지 않습니다. */
+		std::string object_path;
+		/** 목적 파일을 만들 때 모듈을 나눠 작업 스레드마다 따로 만들지 여부입니다. 나누면 목적 파일이 여러개 만들어질 수 있습니다. */
+		bool split_objects = false;
+		/** 어셈블리어 파일을 쓸 경로입니다. 비어 있으면 어셈블리어 파일을 만들지 않습니다. */
+		std::string assembly_path;
+		/** LLVM 비트코드 파일을 쓸 경로입니다. 비어 있으면 비트코드 파일을 만들지 않습니다. */
+		std::string bitcode_path;
+		/** LLVM IR 파일을 쓸 경로입니다. 비어 있으면 LLVM IR 파일을 만들지 않습니다. */
+		std::string ir_path;
+		/** 코드를 만든 뒤 JIT 컴파일해 main 함수를 실행할지 여부입니다. */
+		bool run = false;
+		/** 컴파일 결과를 저장할 캐시 디렉토리입니다. 비어 있으면 캐시를 사용하지 않습니다. */
+		std::string cache_directory;
+		/** 캐시 디렉토리의 최대 크기(바이트)입니다. 0이면 크기를 제한하지 않습니다. */
+		std::uint64_t cache_size = 1024ull * 1024 * 1024;
+		/** 컴파일 시간을 Chrome trace-event JSON 형식으로 기록할 파일의 경로입니다. 비어 있으면 기록하지 않습니다. */
+		std::string time_trace_path;
+	};
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+/**
+ * @file Driver.hh
+ * @author kmc7468
+ * @brief Driver 클래스를 정의합니다.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CompileOptions.hh"
+#include "Init.hh"
+#include "Lexer.hh"
+#include "Optimizer.hh"
+#include "Parser.hh"
+#include "Resolver.hh"
+#include "SourceFile.hh"
+#include "SourceManager.hh"
+#include "ThreadPool.hh"
+#include "TimeTrace.hh"
+
+namespace Dlink
+{
+	class Cache;
+
+	/**
+	 * @brief 명령줄로 요청받은 컴파일 작업을 실행하고 결과를 출력합니다.
+	 * @details 한 인스턴스로 여러 컴파일 작업을 차례대로 실행하면 작업 스레드 풀과 최적화 파이프라인, 파일별 추상 구문 트리를 다시 사용합니다. 서버 모드는 이를 이용해 한 프로세스에서 여러 요청을 처리합니다.
+	 * 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	class Driver final
+	{
+	public:
+		Driver() = default;
+		Driver(const Driver& driver) = delete;
+		Driver(Driver&& driver) noexcept = delete;
+		~Driver() = default;
+
+	public:
+		Driver& operator=(const Driver& driver) = delete;
+		Driver& operator=(Driver&& driver) noexcept = delete;
+		bool operator==(const Driver& driver) const noexcept = delete;
+		bool operator!=(const Driver& driver) const noexcept = delete;
+
+	public:
+		int run(int argc, char** argv, std::istream& in, std::ostream& out, std::ostream& err);
+		int serve(std::istream& in, std::ostream& out);
+		int compile(ProcessedCommandLine& command_line, std::ostream& out, std::ostream& err);
+
+	private:
+		/**
+		 * @brief 파싱한 소스 파일 하나와 그 결과입니다.
+		 * @details 토큰과 추상 구문 트리는 소스 파일의 버퍼를 가리키므로, 소스 파일과 함께 보관합니다.
+		 */
+		struct Unit_
+		{
+			SourceFile source;
+			std::unique_ptr<SourceManager> source_manager;
+			std::unique_ptr<Lexer> lexer;
+			std::unique_ptr<Parser> parser;
+			bool is_parsed = false;
+			std::unique_ptr<Resolver> resolver;
+			bool is_resolved = false;
+			/** 마지막으로 사용한 순서입니다. 보관된 파일이 너무 많으면 이 값이 가장 작은 것부터 버립니다. */
+			std::uint64_t last_used = 0;
+		};
+
+		int compile_(SourceFile& source, const CompileOptions& options, ThreadPool& thread_pool, std::shared_ptr<Optimizer> optimizer,
+			Unit_* unit, std::unique_ptr<Unit_>& new_unit, std::ostream& out, std::ostream& err);
+		int compile_unit_(SourceFile& source, const CompileOptions& options, ThreadPool& thread_pool, std::shared_ptr<Optimizer> optimizer,
+			Unit_* unit, std::unique_ptr<Unit_>& new_unit, Cache* cache, TimeTrace* time_trace, std::ostream& out, std::ostream& err,
+			std::vector<std::string>* object_paths = nullptr);
+
+		Unit_* find_unit_(const SourceFile& source);
+		void store_unit_(std::unique_ptr<Unit_> unit);
+		static std::unique_ptr<Unit_> make_unit_(SourceFile& source, ThreadPool& thread_pool, TimeTrace* time_trace);
+		ThreadPool& get_thread_pool_(std::size_t thread_count);
+		ThreadPool& get_serial_thread_pool_();
+		std::shared_ptr<Optimizer> get_optimizer_(const CompileOptions& options);
+		static std::vector<std::string> split_arguments_(const std::string& line);
+
+	private:
+		/** 보관하는 소스 파일의 최대 개수입니다. 넘으면 가장 오래 사용하지 않은 것부터 버립니다. */
+		static constexpr std::size_t max_units_ = 256;
+
+		std::unique_ptr<ThreadPool> thread_pool_;
+		std::size_t thread_count_ = 0;
+		std::unique_ptr<ThreadPool> serial_thread_pool_;
+		std::unordered_map<std::string, std::unique_ptr<Unit_>> units_;
+		std::uint64_t unit_clock_ = 0;
+		std::unordered_map<std::string, std::shared_ptr<Optimizer>> optimizers_;
+		bool is_serving_ = false;
+	};
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file Emitter.hh
+ * @author kmc7468
+ * @brief Emitter 클래스를 정의합니다.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Target/TargetMachine.h"
+
+#include "Cache.hh"
+#include "CompileOptions.hh"
+#include "ThreadPool.hh"
+#include "TimeTrace.hh"
+
+namespace Dlink
+{
+	/**
+	 * @brief LLVM 모듈로 목적 파일이나 어셈블리어 파일, LLVM 비트코드 파일, LLVM IR 파일을 만듭니다.
+	 * @details 대상 머신은 작업 스레드마다 따로 만들어 사용하므로, 여러 인스턴스가 동시에 목적 파일을 만들 수 있습니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	class Emitter final
+	{
+	public:
+		Emitter(const CompileOptions& options = CompileOptions(), Cache* cache = nullptr, TimeTrace* time_trace = nullptr);
+		Emitter(const Emitter& emitter) = delete;
+		Emitter(Emitter&& emitter) noexcept = delete;
+		~Emitter() = default;
+
+	public:
+		Emitter& operator=(const Emitter& emitter) = delete;
+		Emitter& operator=(Emitter&& emitter) noexcept = delete;
+		bool operator==(const Emitter& emitter) const noexcept = delete;
+		bool operator!=(const Emitter& emitter) const noexcept = delete;
+
+	public:
+		bool emit_objects(llvm::Module& module, ThreadPool& thread_pool, std::vector<std::string>& objects);
+		bool write_object(llvm::Module& module, ThreadPool& thread_pool, const std::string& path, std::vector<std::string>& paths);
+		bool write_assembly(llvm::Module& module, const std::string& path);
+		bool write_bitcode(llvm::Module& module, const std::string& path);
+		bool write_ir(llvm::Module& module, const std::string& path);
+		bool restore(std::vector<std::string>& object_paths);
+		const std::string& get_error() const noexcept;
+
+	public:
+		/** 모듈을 나눌 때 조각 하나가 가지는 정의된 함수의 최소 개수입니다. split_objects가 true여도 정의된 함수가 이 값의 두 배보다 적으면 모듈을 나누지 않고 목적 파일 하나를 만듭니다. */
+		static constexpr std::size_t parallel_threshold = 64;
+		/** 모듈을 나눌 때 만드는 조각의 최대 개수입니다. */
+		static constexpr std::size_t max_object_count = 16;
+
+	private:
+		std::unique_ptr<llvm::TargetMachine> prepare_(llvm::Module& module);
+		static bool emit_file_(llvm::TargetMachine& target_machine, llvm::Module& module, llvm::CodeGenFileType file_type, TimeTrace* time_trace,
+			std::string& output, std::string& error);
+		static std::string object_path_(const std::string& path, std::size_t index);
+		static std::string manifest_path_(const std::string& path);
+		bool write_objects_(const std::string& path, const std::vector<std::string>& objects, std::vector<std::string>& paths);
+		static void remove_stale_objects_(const std::string& path, std::size_t count);
+		std::string objects_kind_() const;
+		bool write_output_(const std::string& kind, const std::string& path, llvm::StringRef data, llvm::sys::fs::OpenFlags flags);
+		bool write_file_(const std::string& path, llvm::StringRef data, llvm::sys::fs::OpenFlags flags);
+
+	private:
+		CompileOptions options_;
+		Cache* cache_;
+		TimeTrace* time_trace_;
+		std::string error_;
+	};
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+/**
+ * @file Executor.hh
+ * @author kmc7468
+ * @brief Executor 클래스를 정의합니다.
+ */
+
+#include <string>
+
+#include "llvm/IR/Module.h"
+
+#include "Cache.hh"
+#include "CompileOptions.hh"
+
+namespace Dlink
+{
+	/**
+	 * @brief LLVM 모듈을 현재 프로세스에서 JIT 컴파일해 실행합니다.
+	 * @details 함수는 처음 호출될 때 컴파일되므로, 실행되지 않는 코드는 컴파일하지 않습니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	class Executor final
+	{
+	public:
+		Executor(const CompileOptions& options = CompileOptions(), Cache* cache = nullptr);
+		Executor(const Executor& executor) = delete;
+		Executor(Executor&& executor) noexcept = delete;
+		~Executor() = default;
+
+	public:
+		Executor& operator=(const Executor& executor) = delete;
+		Executor& operator=(Executor&& executor) noexcept = delete;
+		bool operator==(const Executor& executor) const noexcept = delete;
+		bool operator!=(const Executor& executor) const noexcept = delete;
+
+	public:
+		bool run(const llvm::Module& module, int& exit_code);
+		const std::string& get_error() const noexcept;
+
+	private:
+		CompileOptions options_;
+		Cache* cache_;
+		std::string error_;
+	};
+}
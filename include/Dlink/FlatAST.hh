@@ -0,0 +1,70 @@
+#pragma once
+
+/**
+ * @file FlatAST.hh
+ * @author kmc7468
+ * @brief FlatAST 클래스를 정의합니다.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Any.hh"
+#include "ParseStruct.hh"
+#include "Token.hh"
+
+namespace Dlink
+{
+	/**
+	 * @brief 노드들의 정보를 평평한 병렬 배열에 저장하는 추상 구문 트리입니다.
+	 * @details 노드는 후위 순회 순서로 번호가 매겨지므로, 하위 노드의 번호는 항상 상위 노드의 번호보다 작고 한 노드의 하위 트리는 [index - subtree_size(index) + 1, index] 범위를 차지합니다.
+	 * 따라서 하위 노드부터 처리하는 작업은 배열을 앞에서부터 한 번 훑는 것으로 끝납니다.
+	 * 타입 노드, 식별자, 문자열처럼 배열에 담지 않은 정보는 node 함수로 원래 노드에서 가져오므로, 변환한 AST가 살아있는 동안에만 사용할 수 있습니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	class FlatAST final
+	{
+	public:
+		FlatAST() = default;
+		explicit FlatAST(const AST& ast);
+		FlatAST(const FlatAST& ast) = delete;
+		FlatAST(FlatAST&& ast) noexcept = default;
+		~FlatAST() = default;
+
+	public:
+		FlatAST& operator=(const FlatAST& ast) = delete;
+		FlatAST& operator=(FlatAST&& ast) noexcept = default;
+		bool operator==(const FlatAST& ast) const noexcept = delete;
+		bool operator!=(const FlatAST& ast) const noexcept = delete;
+
+	public:
+		void preprocess();
+		bool evaluate(std::uint32_t index, Any& out) const;
+
+		std::uint32_t size() const noexcept;
+		bool empty() const noexcept;
+		std::uint32_t root() const noexcept;
+
+		NodeKind kind(std::uint32_t index) const noexcept;
+		TokenType op(std::uint32_t index) const noexcept;
+		std::int32_t data(std::uint32_t index) const noexcept;
+		std::uint32_t offset(std::uint32_t index) const noexcept;
+		std::uint32_t length(std::uint32_t index) const noexcept;
+		std::uint32_t subtree_size(std::uint32_t index) const noexcept;
+		std::uint32_t child_count(std::uint32_t index) const noexcept;
+		std::uint32_t child(std::uint32_t index, std::uint32_t nth) const noexcept;
+		Node* node(std::uint32_t index) const noexcept;
+
+	private:
+		std::vector<NodeKind> kinds_;
+		std::vector<TokenType> ops_;
+		std::vector<std::int32_t> data_;
+		std::vector<std::uint32_t> offsets_;
+		std::vector<std::uint32_t> lengths_;
+		std::vector<std::uint32_t> subtree_sizes_;
+		std::vector<std::uint32_t> first_children_;
+		std::vector<std::uint32_t> child_counts_;
+		std::vector<std::uint32_t> children_;
+		std::vector<Node*> nodes_;
+	};
+}
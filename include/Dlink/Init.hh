@@ -6,22 +6,39 @@
  * @brief Dlink 컴파일 작업의 초기 설정과 관련된 기능들의 집합입니다.
  */
 
+#include <cstddef>
 #include <iostream>
 #include <string>
-#include <fstream>
-#include <streambuf>
+#include <vector>
 
+#include "ASTDumper.hh"
 #include "CommandLine.hh"
 #include "CodeGen.hh"
+#include "CompileOptions.hh"
+#include "SourceFile.hh"
 
 namespace Dlink
 {
+	/**
+	 * @brief 명령줄 데이터를 처리한 결과입니다.
+	 * @details 이 구조체는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	struct ProcessedCommandLine final
+	{
+		/** 메모리에 매핑된 소스 파일들입니다. 명령줄에 적은 순서대로 있으며, 같은 경로는 한 번만 있습니다. */
+		std::vector<SourceFile> sources;
+		/** 각 소스 파일에 적용할 컴파일 설정입니다. sources와 순서가 같습니다. */
+		std::vector<CompileOptions> source_options;
+		/** 명령줄로 지정한 컴파일 설정입니다. */
+		CompileOptions options;
+		/** 서버 모드로 실행할지 여부입니다. */
+		bool is_server = false;
+	};
+
 	/**
 	 * @brief 명령줄 데이터 처리 함수의 반환 타입입니다.
 	 */
-	using ProcessedType = std::string;
+	using ProcessedType = ProcessedCommandLine;
 
 	ProcessedType ProcessCommandLine(int argc, char** argv);
-
-	extern long long opt_level;
 }
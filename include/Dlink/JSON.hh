@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+ * @file JSON.hh
+ * @author kmc7468
+ * @brief JSON 출력과 관련된 기능들의 집합입니다.
+ */
+
+#include <string>
+
+namespace Dlink
+{
+	void append_json_string(std::string& output, const std::string& text);
+}
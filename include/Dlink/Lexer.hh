@@ -7,10 +7,10 @@
  */
 
 #include <iostream>
-#include <map>
-#include <sstream>
 #include <vector>
 
+#include "SourceFile.hh"
+#include "ThreadPool.hh"
 #include "Token.hh"
 
 namespace Dlink
@@ -18,12 +18,14 @@ namespace Dlink
 	/**
 	 * @brief Dlink 코드를 토큰 단위로 쪼개는 렉서입니다.
 	 * @details 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 * @details 렉서는 SourceFile의 버퍼를 복사하지 않고 직접 읽습니다.
 	 * @see Dlink::Token
+	 * @see Dlink::SourceFile
 	 */
 	class Lexer final
 	{
 	public:
-		Lexer(const std::string& code);
+		Lexer(const SourceFile& source);
 		Lexer(const Lexer& lexer) = delete;
 		Lexer(Lexer&& lexer) noexcept = delete;
 		~Lexer() = default;
@@ -34,16 +36,31 @@ namespace Dlink
 		bool operator==(const Lexer& lexer) const noexcept = delete;
 		bool operator!=(const Lexer& lexer) const noexcept = delete;
 
+	public:
+		/** 병렬로 렉싱할 만큼 큰 파일의 최소 크기(바이트)입니다. 이보다 작은 파일은 스레드를 사용하는 비용이 더 큽니다. */
+		static constexpr std::size_t parallel_threshold = 4 * 1024 * 1024;
+
 	public:
 		void lex();
+		void lex(ThreadPool& thread_pool);
+		Token next_token();
+		const SourceFile& get_source() const noexcept;
 		const TokenSeq& get_token_seq() const noexcept;
 		void dump() const;
 		void dump(std::ostream& out) const;
 
 	private:
-		std::string code_;
+		Lexer(const SourceFile& source, std::size_t begin, std::size_t end, bool in_comment);
+
+		void skip_comment_();
+		static bool prescan_(const char* code, std::size_t begin, std::size_t end, bool in_comment) noexcept;
+
+	private:
+		const SourceFile& source_;
 		TokenSeq token_seq_;
 
-		std::map<std::string, TokenType> keyword_map_;
+		std::size_t position_;
+		std::size_t end_;
+		bool in_comment_;
 	};
 }
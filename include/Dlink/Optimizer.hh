@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ * @file Optimizer.hh
+ * @author kmc7468
+ * @brief Optimizer 클래스를 정의합니다.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "llvm/Analysis/CGSCCPassManager.h"
+#include "llvm/Analysis/LoopAnalysisManager.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/PassInstrumentation.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Target/TargetMachine.h"
+
+#include "CompileOptions.hh"
+#include "TimeTrace.hh"
+
+namespace Dlink
+{
+	/**
+	 * @brief 최적화 레벨에 맞는 LLVM 최적화 파이프라인을 실행합니다.
+	 * @details 파이프라인과 분석 결과, 대상 머신을 인스턴스가 가지므로, 서로 다른 스레드에서 여러 인스턴스가 동시에 최적화할 수 있습니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	class Optimizer final
+	{
+	public:
+		Optimizer(const CompileOptions& options = CompileOptions(), bool is_function_only = false);
+		Optimizer(const Optimizer& optimizer) = delete;
+		Optimizer(Optimizer&& optimizer) noexcept = delete;
+		~Optimizer() = default;
+
+	public:
+		Optimizer& operator=(const Optimizer& optimizer) = delete;
+		Optimizer& operator=(Optimizer&& optimizer) noexcept = delete;
+		bool operator==(const Optimizer& optimizer) const noexcept = delete;
+		bool operator!=(const Optimizer& optimizer) const noexcept = delete;
+
+	public:
+		void configure_module(llvm::Module& module) const;
+		void optimize_function(llvm::Function& function);
+		void optimize_module(llvm::Module& module);
+		bool is_enabled() const noexcept;
+		void set_time_trace(TimeTrace* time_trace) noexcept;
+
+	private:
+		llvm::PassBuilder::OptimizationLevel level_() const noexcept;
+		void register_instrumentation_();
+
+	private:
+		CompileOptions options_;
+		bool is_function_only_;
+		std::unique_ptr<llvm::TargetMachine> target_machine_;
+		TimeTrace* time_trace_ = nullptr;
+		std::vector<std::uint64_t> pass_begins_;
+
+		llvm::PassInstrumentationCallbacks instrumentation_;
+		llvm::LoopAnalysisManager loop_am_;
+		llvm::FunctionAnalysisManager function_am_;
+		llvm::CGSCCAnalysisManager cgscc_am_;
+		llvm::ModuleAnalysisManager module_am_;
+		std::unique_ptr<llvm::PassBuilder> pass_builder_;
+
+		llvm::FunctionPassManager function_pm_;
+		llvm::ModulePassManager module_pm_;
+	};
+}
@@ -6,6 +6,8 @@
  * @brief Dlink 코드 파서의 결과가 생성하는 AST의 노드들을 정의합니다.
  */
 
+#include "ASTContext.hh"
+#include "ASTDumper.hh"
 #include "ParseStruct/Root.hh"
 #include "ParseStruct/Operation.hh"
 #include "ParseStruct/Type.hh"
@@ -16,16 +18,20 @@
 namespace Dlink
 {
 	class Assembler;
+	class FlatAST;
 	class Parser;
+	class Resolver;
 
 	/**
 	 * @brief 추상 구문 트리입니다.
-	 * @details 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 * @details 트리의 모든 노드는 AST가 가진 ASTContext가 소유하며, AST가 소멸될 때 한꺼번에 해제됩니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
 	 */
 	class AST final
 	{
 		friend class Assembler;
+		friend class FlatAST;
 		friend class Parser;
+		friend class Resolver;
 
 	public:
 		AST() = default;
@@ -40,10 +46,12 @@ namespace Dlink
 		bool operator!=(const AST& ast) const noexcept = delete;
 
 	public:
-		void dump() const;
-		void dump(std::ostream& stream) const;
+		void dump(ASTDumpFormat format = ASTDumpFormat::Tree) const;
+		void dump(std::ostream& stream, ASTDumpFormat format = ASTDumpFormat::Tree) const;
+		ASTContext& get_context() noexcept;
 		
 	private:
-		std::shared_ptr<Node> node_ = nullptr;
+		ASTContext context_;
+		Node* node_ = nullptr;
 	};
 }
\ No newline at end of file
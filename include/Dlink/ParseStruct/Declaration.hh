@@ -14,6 +14,7 @@
 #include "Root.hh"
 #include "Operation.hh"
 #include "../LLVMValue.hh"
+#include "../Symbol.hh"
 #include "../Token.hh"
 
 namespace Dlink
@@ -23,20 +24,22 @@ namespace Dlink
 	 */
 	struct VariableDeclaration : public Statement
 	{
-		VariableDeclaration(const Token& token, TypePtr type, const std::string& identifier);
-		VariableDeclaration(const Token& token, TypePtr type, const std::string& identifier, ExpressionPtr expression);
+		VariableDeclaration(const Token& token, TypePtr type, Symbol identifier);
+		VariableDeclaration(const Token& token, TypePtr type, Symbol identifier, ExpressionPtr expression);
 
-		std::string tree_gen(std::size_t depth) const override;
-		void array_helper(llvm::Value* var, std::shared_ptr<ArrayInitList> array_list);
-		LLVM::Value code_gen() override;
-		void preprocess() override;
+		static bool classof(const Node* node) noexcept;
+		void array_helper(llvm::Value* var, ArrayInitList* array_list);
+		Node* code_gen_step(CodeGenFrame& frame) override;
+		void children(std::vector<Node*>& out) override;
+		LLVM::Value address() const;
+		void set_address(LLVM::Value value);
 
 		/** 변수의 타입입니다. */
-		TypePtr type;
+		TypePtr type = nullptr;
 		/** 변수의 식별자입니다. */
-		std::string identifier;
+		Symbol identifier;
 		/** 변수의 초기화 식입니다. */
-		ExpressionPtr expression;
+		ExpressionPtr expression = nullptr;
 	};
 
 	/**
@@ -44,24 +47,22 @@ namespace Dlink
 	 */
 	struct FunctionDeclaration : public Statement
 	{
-		FunctionDeclaration(const Token& token, TypePtr return_type, const std::string& identifier,
+		FunctionDeclaration(const Token& token, TypePtr return_type, Symbol identifier,
 			const std::vector<VariableDeclaration>& parameter, StatementPtr body);
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
-		void preprocess() override;
+		static bool classof(const Node* node) noexcept;
+		Node* code_gen_step(CodeGenFrame& frame) override;
+		void children(std::vector<Node*>& out) override;
+		void preprocess_node() override;
+		llvm::Function* function() const;
 
 		/** 함수의 반환 값 타입입니다. */
-		TypePtr return_type;
+		TypePtr return_type = nullptr;
 		/** 함수의 식별자입니다. */
-		std::string identifier;
+		Symbol identifier;
 		/** 함수의 매개 변수입니다. */
 		std::vector<VariableDeclaration> parameter;
 		/** 함수의 몸체입니다. */
-		StatementPtr body;
-
-	private:
-		llvm::Function* func_;
-		llvm::FunctionType* func_type_;
+		StatementPtr body = nullptr;
 	};
 }
\ No newline at end of file
@@ -26,9 +26,8 @@ namespace Dlink
 	{
 		Integer32(const Token& token, std::int32_t data) noexcept;
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
-		bool evaluate(Any& out) override;
+		static bool classof(const Node* node) noexcept;
+		Node* code_gen_step(CodeGenFrame& frame) override;
 
 		/** 32비트 부호 있는 정수 상수입니다. */
 		std::int32_t data;
@@ -42,8 +41,8 @@ namespace Dlink
 	{
 		String(const Token& token, const std::string& data) noexcept;
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
+		static bool classof(const Node* node) noexcept;
+		Node* code_gen_step(CodeGenFrame& frame) override;
 
 		/** 문자열입니다. */
 		std::string data;
@@ -57,8 +56,8 @@ namespace Dlink
 	{
 		Character(const Token& token, char data) noexcept;
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
+		static bool classof(const Node* node) noexcept;
+		Node* code_gen_step(CodeGenFrame& frame) override;
 
 		/** 문자입니다. */
 		char data;
@@ -75,17 +74,16 @@ namespace Dlink
 	{
 		BinaryOperation(const Token& token, TokenType op, ExpressionPtr lhs, ExpressionPtr rhs);
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
-		void preprocess() override;
-		bool evaluate(Any& out) override;
+		static bool classof(const Node* node) noexcept;
+		Node* code_gen_step(CodeGenFrame& frame) override;
+		void children(std::vector<Node*>& out) override;
 
 		/** 연산자 타입입니다. */
 		TokenType op;
 		/** 이항 연산에서의 좌측 피연산자입니다. */
-		ExpressionPtr lhs;
+		ExpressionPtr lhs = nullptr;
 		/** 이항 연산에서의 우측 피연산자입니다. */
-		ExpressionPtr rhs;
+		ExpressionPtr rhs = nullptr;
 	};
 
 	/**
@@ -96,15 +94,14 @@ namespace Dlink
 	{
 		UnaryOperation(const Token& token, TokenType op, ExpressionPtr rhs);
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
-		void preprocess() override;
-		bool evaluate(Any& out) override;
+		static bool classof(const Node* node) noexcept;
+		Node* code_gen_step(CodeGenFrame& frame) override;
+		void children(std::vector<Node*>& out) override;
 
 		/** 연산자 타입입니다. */
 		TokenType op;
 		/** 피연산자입니다. */
-		ExpressionPtr rhs;
+		ExpressionPtr rhs = nullptr;
 	};
 
 	/**
@@ -115,12 +112,12 @@ namespace Dlink
 	{
 		FunctionCallOperation(const Token& token, ExpressionPtr func_expr, const std::vector<ExpressionPtr>& arugment);
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
-		void preprocess() override;
+		static bool classof(const Node* node) noexcept;
+		Node* code_gen_step(CodeGenFrame& frame) override;
+		void children(std::vector<Node*>& out) override;
 
 		/** 호출할 함수의 식입니다. */
-		ExpressionPtr func_expr;
+		ExpressionPtr func_expr = nullptr;
 		/** 인수입니다. */
 		std::vector<ExpressionPtr> argument;
 	};
@@ -133,9 +130,9 @@ namespace Dlink
 	{
 		ArrayInitList(const Token& token, const std::vector<ExpressionPtr>& elements);
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
-		void preprocess() override;
+		static bool classof(const Node* node) noexcept;
+		Node* code_gen_step(CodeGenFrame& frame) override;
+		void children(std::vector<Node*>& out) override;
 
 		/** 배열 리스트의 원소들입니다. */
 		std::vector<ExpressionPtr> elements;
@@ -149,12 +146,12 @@ namespace Dlink
 	{
 		UnsafeExpression(const Token& token, ExpressionPtr expression);
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
-		void preprocess() override;
+		static bool classof(const Node* node) noexcept;
+		Node* code_gen_step(CodeGenFrame& frame) override;
+		void children(std::vector<Node*>& out) override;
 
 		/** 안전하지 않은 식입니다. */
-		ExpressionPtr expression;
+		ExpressionPtr expression = nullptr;
 	};
 }
 
@@ -168,12 +165,12 @@ namespace Dlink
 	{
 		ReturnStatement(const Token& token, ExpressionPtr return_value = nullptr);
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
-		void preprocess() override;
+		static bool classof(const Node* node) noexcept;
+		Node* code_gen_step(CodeGenFrame& frame) override;
+		void children(std::vector<Node*>& out) override;
 
 		/** 반환할 식입니다. */
-		ExpressionPtr return_expr;
+		ExpressionPtr return_expr = nullptr;
 	};
 
 	/**
@@ -184,11 +181,11 @@ namespace Dlink
 	{
 		UnsafeStatement(const Token& token, StatementPtr statement);
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
-		void preprocess() override;
+		static bool classof(const Node* node) noexcept;
+		Node* code_gen_step(CodeGenFrame& frame) override;
+		void children(std::vector<Node*>& out) override;
 
 		/** 안전하지 않은 문입니다. */
-		StatementPtr statement;
+		StatementPtr statement = nullptr;
 	};
 }
\ No newline at end of file
@@ -6,41 +6,110 @@
  * @brief Dlink 코드 파서의 결과가 생성하는 추상 구문 트리의 노드들 중 기반이 되는 노드들을 정의합니다.
  */
 
+#include <cassert>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "llvm/IR/Value.h"
 
+#include "../ASTVisitor.hh"
 #include "../Any.hh"
 #include "../LLVMValue.hh"
+#include "../Symbol.hh"
 #include "../Token.hh"
 
 namespace Dlink
 {
+	struct Node;
+
+	/**
+	 * @brief 추상 구문 트리 노드의 실제 타입입니다.
+	 * @details Expression과 Statement를 상속받는 노드들이 각각 연속된 값을 가지므로, 범위 비교로 상위 타입을 검사할 수 있습니다.
+	 */
+	enum class NodeKind
+	{
+		Identifier, /**< Identifier 노드입니다. */
+		Integer32, /**< Integer32 노드입니다. */
+		String, /**< String 노드입니다. */
+		Character, /**< Character 노드입니다. */
+		BinaryOperation, /**< BinaryOperation 노드입니다. */
+		UnaryOperation, /**< UnaryOperation 노드입니다. */
+		FunctionCallOperation, /**< FunctionCallOperation 노드입니다. */
+		ArrayInitList, /**< ArrayInitList 노드입니다. */
+		UnsafeExpression, /**< UnsafeExpression 노드입니다. */
+
+		Block, /**< Block 노드입니다. */
+		Scope, /**< Scope 노드입니다. */
+		ExpressionStatement, /**< ExpressionStatement 노드입니다. */
+		ReturnStatement, /**< ReturnStatement 노드입니다. */
+		UnsafeStatement, /**< UnsafeStatement 노드입니다. */
+		VariableDeclaration, /**< VariableDeclaration 노드입니다. */
+		FunctionDeclaration, /**< FunctionDeclaration 노드입니다. */
+
+		First_Expression = Identifier,
+		Last_Expression = UnsafeExpression,
+		First_Statement = Block,
+		Last_Statement = FunctionDeclaration,
+	};
+	/**
+	 * @brief 타입 노드의 실제 타입입니다.
+	 */
+	enum class TypeKind
+	{
+		SimpleType, /**< SimpleType 노드입니다. */
+		StaticArray, /**< StaticArray 노드입니다. */
+		LValueReference, /**< LValueReference 노드입니다. */
+		Pointer, /**< Pointer 노드입니다. */
+	};
+
+	/**
+	 * @brief 명시적 스택으로 LLVM IR 코드를 만들 때 노드 하나의 진행 상태입니다.
+	 * @details 이 구조체는 다른 곳에서 상속받을 수 없습니다.
+	 * @see Dlink::Node::code_gen_step
+	 */
+	struct CodeGenFrame final
+	{
+		CodeGenFrame(Node* node) noexcept;
+
+		/** 코드를 만들고 있는 노드입니다. */
+		Node* node;
+		/** Node::code_gen_step이 지금까지 호출된 횟수입니다. */
+		std::size_t step = 0;
+		/** 하위 노드들이 생성한 값의 목록입니다. 노드가 단계 사이에 유지해야 하는 값도 저장할 수 있습니다. */
+		std::vector<LLVM::Value> values;
+		/** 노드가 단계 사이에 유지해야 하는 추가 상태입니다. */
+		std::size_t state = 0;
+		/** 노드가 생성한 값입니다. */
+		LLVM::Value result;
+	};
+
 	/**
 	 * @brief 추상 구문 트리의 루트 노드입니다.
 	 */
 	struct Node
 	{
-		Node(const Token& token);
+		Node(NodeKind kind, const Token& token);
+		virtual ~Node() = default;
 
+		void accept(ASTVisitor& visitor) const;
+		LLVM::Value code_gen();
 		/**
-		 * @brief 이 노드의 트리를 std::string 타입으로 시각화합니다.
-		 * @param depth 전체 트리에서 현재 노드의 깊이입니다.
-		 * @return 이 노드의 트리형 구조를 시각화 시킨 값을 반환합니다.
+		 * @brief 이 노드의 LLVM IR 코드를 한 단계 만듭니다.
+		 * @details 하위 노드의 값이 필요하면 그 노드를 반환합니다. 반환한 노드의 값은 frame.values의 끝에 추가되며, 그 뒤 이 함수가 다시 호출됩니다.
+		 * @param frame 이 노드의 진행 상태입니다.
+		 * @return 다음으로 코드를 만들 하위 노드를 반환합니다. 이 노드의 코드를 모두 만들었다면 frame.result에 값을 저장하고 nullptr을 반환합니다.
 		 */
-		virtual std::string tree_gen(std::size_t depth) const = 0;
-		/**
-		 * @brief 이 노드의 트리를 LLVM IR 코드로 만듭니다.
-		 * @return 파싱 노드에서 생성한 LLVM::Value를 반환합니다. 생성한 값이 없을 경우 nullptr을 반환합니다.
-		 */
-		virtual LLVM::Value code_gen() = 0;
-		virtual void preprocess();
+		virtual Node* code_gen_step(CodeGenFrame& frame) = 0;
+		void preprocess();
+		virtual void preprocess_node();
+		virtual void children(std::vector<Node*>& out);
 
 		virtual bool is_safe() const noexcept;
 		virtual bool is_lvalue() const noexcept;
 
+		/** 이 노드의 실제 타입입니다. */
+		const NodeKind kind;
 		/** 이 노드를 만드는데 사용된 가장 첫번째 토큰입니다. */
 		const Token token;
 	};
@@ -52,13 +121,21 @@ namespace Dlink
 	{
 		using Node::Node;
 
-		virtual bool evaluate(Any& out);
+		static bool classof(const Node* node) noexcept;
+		bool evaluate(Any& out);
+		static bool evaluate_binary(TokenType op, const Any& lhs, const Any& rhs, Any& out);
+		static bool evaluate_unary(TokenType op, const Any& rhs, Any& out);
+
+		/** 식의 Dlink 타입이 unsigned인지 여부입니다. Resolver가 하위 식부터 계산하며, 계산하기 전에는 false입니다. */
+		bool is_unsigned = false;
 
 	protected:
-		bool any_add(const Any& lhs, const Any& rhs, Any& out);
-		bool any_sub(const Any& lhs, const Any& rhs, Any& out);
-		bool any_mul(const Any& lhs, const Any& rhs, Any& out);
-		bool any_div(const Any& lhs, const Any& rhs, Any& out);
+		static bool any_add(const Any& lhs, const Any& rhs, Any& out);
+		static bool any_sub(const Any& lhs, const Any& rhs, Any& out);
+		static bool any_mul(const Any& lhs, const Any& rhs, Any& out);
+		static bool any_div(const Any& lhs, const Any& rhs, Any& out);
+		static bool any_integer_binary(TokenType op, const Any& lhs, const Any& rhs, Any& out);
+		static bool any_integer_unary(TokenType op, const Any& rhs, Any& out);
 	};
 
 	/**
@@ -67,6 +144,8 @@ namespace Dlink
 	struct Statement : public Node
 	{
 		using Node::Node;
+
+		static bool classof(const Node* node) noexcept;
 	};
 
 	/**
@@ -74,14 +153,10 @@ namespace Dlink
 	 */
 	struct Type
 	{
-		Type(const Token& token);
+		Type(TypeKind kind, const Token& token);
+		virtual ~Type() = default;
 
-		/**
-		 * @brief 현재 타입 노드의 트리를 std::string 타입으로 시각화합니다.
-		 * @param depth 전체 트리에서 현재 노드의 깊이입니다.
-		 * @return 현재 노드의 트리를 시각화 시킨 값을 반환합니다.
-		 */
-		virtual std::string tree_gen(std::size_t depth) const = 0;
+		void accept(ASTVisitor& visitor) const;
 
 		/**
 		 * @brief 현재 타입 노드를 LLVM Type으로 만듭니다.
@@ -90,16 +165,77 @@ namespace Dlink
 		virtual llvm::Type* get_type() = 0;
 		virtual bool is_safe() const noexcept;
 		
+		/** 이 타입 노드의 실제 타입입니다. */
+		const TypeKind kind;
 		/** 이 노드를 만드는데 사용된 가장 첫번째 토큰입니다. */
 		const Token token;
 	};
 
-	/** Expression 구조체에 대한 std::shared_ptr 타입입니다. */
-	using ExpressionPtr = std::shared_ptr<Expression>;
-	/** Statement 구조체에 대한 std::shared_ptr 타입입니다. */
-	using StatementPtr = std::shared_ptr<Statement>;
-	/** Type 구조처에 대한 std::shared_ptr 타입입니다. */
-	using TypePtr = std::shared_ptr<Type>;
+	/** Expression 구조체에 대한 포인터 타입입니다. 노드는 ASTContext가 소유합니다. */
+	using ExpressionPtr = Expression*;
+	/** Statement 구조체에 대한 포인터 타입입니다. 노드는 ASTContext가 소유합니다. */
+	using StatementPtr = Statement*;
+	/** Type 구조체에 대한 포인터 타입입니다. 노드는 ASTContext가 소유합니다. */
+	using TypePtr = Type*;
+
+	/**
+	 * @brief 노드가 To_ 타입인지 검사합니다.
+	 * @details 노드의 kind만 비교하므로 dynamic_cast를 사용하지 않습니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param node 검사할 노드입니다. nullptr이 아니어야 합니다.
+	 * @return 노드가 To_ 타입이면 true, 아니면 false를 반환합니다.
+	 */
+	template<typename To_, typename From_>
+	bool isa(const From_* node) noexcept
+	{
+		assert(node && "isa<> used on a null pointer");
+		return To_::classof(node);
+	}
+	/**
+	 * @brief 노드를 To_ 타입으로 변환합니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param node 변환할 노드입니다. To_ 타입이어야 합니다.
+	 * @return 변환된 노드를 반환합니다.
+	 */
+	template<typename To_, typename From_>
+	To_* cast(From_* node) noexcept
+	{
+		assert(isa<To_>(node) && "cast<Ty>() argument of incompatible type");
+		return static_cast<To_*>(node);
+	}
+	/**
+	 * @brief 노드를 To_ 타입으로 변환합니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param node 변환할 노드입니다. To_ 타입이어야 합니다.
+	 * @return 변환된 노드를 반환합니다.
+	 */
+	template<typename To_, typename From_>
+	const To_* cast(const From_* node) noexcept
+	{
+		assert(isa<To_>(node) && "cast<Ty>() argument of incompatible type");
+		return static_cast<const To_*>(node);
+	}
+	/**
+	 * @brief 노드가 To_ 타입이면 To_ 타입으로 변환합니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param node 변환할 노드입니다. nullptr이 아니어야 합니다.
+	 * @return 노드가 To_ 타입이면 변환된 노드를, 아니면 nullptr을 반환합니다.
+	 */
+	template<typename To_, typename From_>
+	To_* dyn_cast(From_* node) noexcept
+	{
+		return isa<To_>(node) ? static_cast<To_*>(node) : nullptr;
+	}
+	/**
+	 * @brief 노드가 To_ 타입이면 To_ 타입으로 변환합니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param node 변환할 노드입니다. nullptr이 아니어야 합니다.
+	 * @return 노드가 To_ 타입이면 변환된 노드를, 아니면 nullptr을 반환합니다.
+	 */
+	template<typename To_, typename From_>
+	const To_* dyn_cast(const From_* node) noexcept
+	{
+		return isa<To_>(node) ? static_cast<const To_*>(node) : nullptr;
+	}
 }
 
 namespace Dlink
@@ -110,14 +246,17 @@ namespace Dlink
 	 */
 	struct Identifier final : public Expression
 	{
-		Identifier(const Token& token, const std::string& id);
+		Identifier(const Token& token, Symbol id);
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
+		static bool classof(const Node* node) noexcept;
+		Node* code_gen_step(CodeGenFrame& frame) override;
 		bool is_lvalue() const noexcept override;
+		LLVM::Value value() const;
 
 		/** 실질적인 식별자 값입니다. */
-		const std::string id;
+		const Symbol id;
+		/** 식별자가 가리키는 VariableDeclaration 또는 FunctionDeclaration 노드입니다. Resolver가 연결하기 전이나 연결하지 못했다면 nullptr입니다. */
+		Statement* declaration = nullptr;
 	};
 
 	/**
@@ -127,12 +266,15 @@ namespace Dlink
 	{
 		Block(const Token& token, const std::vector<StatementPtr>& statements);
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
-		void preprocess() override;
+		static bool classof(const Node* node) noexcept;
+		Node* code_gen_step(CodeGenFrame& frame) override;
+		void children(std::vector<Node*>& out) override;
 
 		/** Statemenet들의 집합입니다. */
 		std::vector<StatementPtr> statements;
+
+	protected:
+		Block(NodeKind kind, const Token& token, const std::vector<StatementPtr>& statements);
 	};
 
 	/**
@@ -143,16 +285,15 @@ namespace Dlink
 	{
 		Scope(const Token& token, const std::vector<StatementPtr>& statements, StatementPtr parent);
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
+		static bool classof(const Node* node) noexcept;
 
 		/** 현재 Scope의 상위 Block 또는 상위 Scope입니다. */
-		StatementPtr parent;
+		StatementPtr parent = nullptr;
 		/** 현재 Scope의 하위 Scope입니다. */
-		std::vector<std::shared_ptr<Scope>> child;
+		std::vector<Scope*> child;
 	};
-	/** Scope 구조체에 대한 std::shared_ptr 타입입니다. */
-	using ScopePtr = std::shared_ptr<Scope>;
+	/** Scope 구조체에 대한 포인터 타입입니다. 노드는 ASTContext가 소유합니다. */
+	using ScopePtr = Scope*;
 
 	/**
 	 * @brief 한 개의 식으로 이루어진 Statement입니다.
@@ -162,11 +303,11 @@ namespace Dlink
 	{
 		ExpressionStatement(const Token& token, ExpressionPtr expression);
 
-		std::string tree_gen(std::size_t depth) const override;
-		LLVM::Value code_gen() override;
-		void preprocess() override;
+		static bool classof(const Node* node) noexcept;
+		Node* code_gen_step(CodeGenFrame& frame) override;
+		void children(std::vector<Node*>& out) override;
 
 		/** 식입니다. */
-		ExpressionPtr expression;
+		ExpressionPtr expression = nullptr;
 	};
 }
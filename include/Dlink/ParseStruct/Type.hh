@@ -24,7 +24,7 @@ namespace Dlink
 		SimpleType(const Token& token, const std::string& identifier);
 		SimpleType(const Token& token, const std::string& identifier, bool is_unsigned);
 
-		std::string tree_gen(std::size_t depth) const override;
+		static bool classof(const Type* node) noexcept;
 		llvm::Type* get_type() override;
 
 		/** 타입의 식별자입니다. */
@@ -44,13 +44,13 @@ namespace Dlink
 	{
 		StaticArray(const Token& token, TypePtr type, ExpressionPtr length);
 
-		std::string tree_gen(std::size_t depth) const override;
+		static bool classof(const Type* node) noexcept;
 		llvm::Type* get_type() override;
 
 		/** 배열 아이템의 타입입니다. */
-		TypePtr type;
+		TypePtr type = nullptr;
 		/** 배열의 길이입니다. */
-		ExpressionPtr length;
+		ExpressionPtr length = nullptr;
 	};
 
 	/**
@@ -58,12 +58,14 @@ namespace Dlink
 	 */
 	struct Reference : public Type
 	{
-		Reference(const Token& token, TypePtr type);
-
+		static bool classof(const Type* node) noexcept;
 		llvm::Type* get_type() override;
 
 		/** 참조하고 있는 값의 타입입니다. */
-		TypePtr type;
+		TypePtr type = nullptr;
+
+	protected:
+		Reference(TypeKind kind, const Token& token, TypePtr type);
 	};
 
 	/**
@@ -72,9 +74,9 @@ namespace Dlink
 	 */
 	struct LValueReference final : public Reference
 	{
-		using Reference::Reference;
+		LValueReference(const Token& token, TypePtr type);
 
-		std::string tree_gen(std::size_t depth) const override;
+		static bool classof(const Type* node) noexcept;
 	};
 
 	/**
@@ -85,11 +87,11 @@ namespace Dlink
 	{
 		Pointer(const Token& token, TypePtr type);
 
-		std::string tree_gen(std::size_t depth) const override;
+		static bool classof(const Type* node) noexcept;
 		llvm::Type* get_type() override;
 		bool is_safe() const noexcept override;
 
 		/** 포인터의 원본 타입입니다. */
-		TypePtr type;
+		TypePtr type = nullptr;
 	};
 }
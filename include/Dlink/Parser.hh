@@ -8,12 +8,16 @@
 
 #include <iostream>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include "Message/Error.hh"
 #include "Message/Warning.hh"
 #include "ParseStruct.hh"
+#include "Lexer.hh"
+#include "SourceFile.hh"
 #include "Token.hh"
+#include "TokenStream.hh"
 
 namespace Dlink
 {
@@ -25,7 +29,8 @@ namespace Dlink
 	class Parser final
 	{
 	public:
-		Parser(const TokenSeq& input);
+		Parser(Lexer& lexer);
+		Parser(const TokenSeq& input, const SourceFile& source);
 		Parser(const Parser& parser) = delete;
 		Parser(Parser&& parser) noexcept = delete;
 		~Parser() = default;
@@ -44,34 +49,36 @@ namespace Dlink
 		const Warnings& get_warnings() const noexcept;
 
 	private:
-		void assign_token(Token* dest, Token source);
+		/**
+		 * @brief 추상 구문 트리의 아레나에 새 노드를 만듭니다.
+		 * @param args 노드의 생성자에 전달할 인수들입니다.
+		 * @return 만들어진 노드를 반환합니다.
+		 */
+		template<typename Node_, typename... Args_>
+		Node_* make_node(Args_&&... args)
+		{
+			return ast_.get_context().create<Node_>(std::forward<Args_>(args)...);
+		}
+		void assign_token(Token* dest, const Token& source);
+		static int binary_precedence_(TokenType token_type) noexcept;
 
-		Token current_token() const;
-		Token previous_token() const;
-		Token next_token() const;
+		const Token& current_token() const noexcept;
+		const Token& previous_token() const noexcept;
+		const Token& next_token() const noexcept;
 		bool accept(TokenType token_type, Token* start_token = nullptr);
 
 		bool block(StatementPtr& out, Token* start_token = nullptr);
 		bool scope(StatementPtr& out, Token* start_token = nullptr);
 		bool var_decl(StatementPtr& out, Token* start_token = nullptr);
-		bool func_decl(StatementPtr& out, Token var_decl_start_token, TypePtr return_type, const std::string& identifier,
+		bool func_decl(StatementPtr& out, Token var_decl_start_token, TypePtr return_type, Symbol identifier,
 					   Token unsafe_start, bool is_unsafe, Token* start_token = nullptr);
 		bool return_stmt(StatementPtr& out, Token* start_token = nullptr);
 		bool unsafe_stmt(StatementPtr& out, Token* start_token = nullptr);
 		bool expr_stmt(StatementPtr& out, Token* start_token = nullptr);
 		
 		bool expr(ExpressionPtr& out, Token* start_token = nullptr);
-		bool assign(ExpressionPtr& out, Token* start_token = nullptr);
-		bool addsub(ExpressionPtr& out, Token* start_token = nullptr);
-		bool muldiv(ExpressionPtr& out, Token* start_token = nullptr);
-		bool unary(ExpressionPtr& out, Token* starrt_token = nullptr);
-		bool func_call(ExpressionPtr& out, Token* start_token = nullptr);
-		bool paren(ExpressionPtr& out, Token* start_token = nullptr);
-		bool array_init_list(ExpressionPtr& out, Token* start_token = nullptr);
 		bool atom(ExpressionPtr& out, Token* start_token = nullptr);
 
-		bool unary_plusminus(ExpressionPtr& out, Token* start_token = nullptr);
-		bool unary_address(ExpressionPtr& out, Token* start_token = nullptr);
 		bool number(ExpressionPtr& out, Token* start_token = nullptr);
 		bool identifier(ExpressionPtr& out, Token* start_token = nullptr);
 		bool string(ExpressionPtr& out, Token* start_token = nullptr);
@@ -84,8 +91,11 @@ namespace Dlink
 		bool simple_type(TypePtr& out, Token* start_token = nullptr);
 
 	private:
-		TokenSeq token_seq_;
-		TokenSeq::const_iterator token_iter_;
+		/** 대입 연산자들의 우선순위입니다. 모든 이항 연산자 중 가장 낮습니다. */
+		static constexpr int lowest_precedence_ = 1;
+
+		TokenStream token_stream_;
+		const SourceFile& source_;
 		AST ast_;
 
 		Errors errors_;
@@ -0,0 +1,128 @@
+#pragma once
+
+/**
+ * @file Resolver.hh
+ * @author kmc7468
+ * @brief SymbolTable 클래스와 Resolver 클래스를 정의합니다.
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include "Message/Error.hh"
+#include "ParseStruct.hh"
+#include "Symbol.hh"
+
+namespace Dlink
+{
+	/**
+	 * @brief 변수 및 상수, 함수 심볼 테이블입니다.
+	 * @details 모든 스코프의 심볼을 인터닝된 식별자를 키로 하는 열린 주소법 해시 테이블 하나에 저장하므로, 스코프가 아무리 깊어도 심볼을 O(1)에 찾습니다.
+	 * 하위 스코프의 심볼이 가린 심볼은 되돌리기 기록에 남겨 두었다가 스코프를 나갈 때 복원하므로, 스코프에 들어가고 나갈 때 메모리를 새로 할당하지 않습니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	class SymbolTable final
+	{
+	public:
+		SymbolTable();
+		SymbolTable(const SymbolTable& symbol_table) = delete;
+		SymbolTable(SymbolTable&& symbol_table) noexcept = delete;
+		~SymbolTable() = default;
+
+	public:
+		SymbolTable& operator=(const SymbolTable& symbol_table) = delete;
+		SymbolTable& operator=(SymbolTable&& symbol_table) noexcept = delete;
+		bool operator==(const SymbolTable& symbol_table) const noexcept = delete;
+		bool operator!=(const SymbolTable& symbol_table) const noexcept = delete;
+
+	public:
+		Statement* find(Symbol name) const;
+		bool find_bool(Symbol name) const;
+		bool insert(Symbol name, Statement* declaration);
+
+		void enter_scope();
+		void leave_scope();
+		std::size_t depth() const noexcept;
+		void clear() noexcept;
+
+	private:
+		struct Entry_
+		{
+			Symbol name;
+			Statement* declaration = nullptr;
+			std::size_t depth = 0;
+		};
+		struct Undo_
+		{
+			Symbol name;
+			bool is_shadowing;
+			Statement* declaration;
+			std::size_t depth;
+		};
+
+		std::size_t home_(Symbol name) const noexcept;
+		std::size_t slot_(Symbol name) const noexcept;
+		void erase_(std::size_t slot) noexcept;
+		void grow_();
+
+	private:
+		/** 처음 만들 때의 슬롯 개수입니다. 2의 거듭제곱이어야 합니다. */
+		static constexpr std::size_t initial_capacity_ = 64;
+
+		std::vector<Entry_> slots_;
+		std::size_t size_ = 0;
+		unsigned shift_ = 0;
+
+		std::vector<Undo_> undo_;
+		std::vector<std::size_t> scopes_;
+	};
+
+	/**
+	 * @brief 추상 구문 트리의 식별자를 그 식별자가 가리키는 선언에 연결합니다.
+	 * @details LLVM IR 코드를 만들기 전에 실행해야 하며, 이후 코드를 만들 때는 심볼 테이블을 사용하지 않습니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 * @see Dlink::Identifier::declaration
+	 */
+	class Resolver final
+	{
+	public:
+		Resolver(AST& ast);
+		Resolver(const Resolver& resolver) = delete;
+		Resolver(Resolver&& resolver) noexcept = delete;
+		~Resolver() = default;
+
+	public:
+		Resolver& operator=(const Resolver& resolver) = delete;
+		Resolver& operator=(Resolver&& resolver) noexcept = delete;
+		bool operator==(const Resolver& resolver) const noexcept = delete;
+		bool operator!=(const Resolver& resolver) const noexcept = delete;
+
+	public:
+		bool resolve();
+		const Errors& get_errors() const noexcept;
+
+	private:
+		enum class Action_
+		{
+			Visit,
+			Bind,
+			LeaveScope,
+			InferSign,
+		};
+		struct Task_
+		{
+			Action_ action;
+			Node* node;
+		};
+
+		void declare_functions_();
+		void visit_(Node* node);
+		static void infer_sign_(Expression* expression);
+
+	private:
+		AST& ast_;
+		SymbolTable symbol_table_;
+		std::vector<Task_> stack_;
+		std::vector<Node*> children_;
+
+		Errors errors_;
+	};
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+/**
+ * @file Scanner.hh
+ * @author kmc7468
+ * @brief 렉서가 사용하는 문자 분류 테이블과 벡터화된 스캔 함수들의 집합입니다.
+ */
+
+#include <cstdint>
+
+namespace Dlink
+{
+	/**
+	 * @brief 문자 분류 테이블에 저장되는 문자의 종류입니다.
+	 * @details 한 문자가 여러 종류에 속할 수 있으므로 비트 플래그로 저장합니다.
+	 */
+	enum CharClass : std::uint8_t
+	{
+		char_none = 0,
+
+		char_alpha = 1 << 0, /**< 영문자입니다. */
+		char_digit = 1 << 1, /**< 10진 숫자입니다. */
+		char_identifier = 1 << 2, /**< 식별자의 두번째 글자부터 올 수 있는 문자입니다. */
+		char_hex = 1 << 3, /**< 16진 숫자입니다. */
+		char_space = 1 << 4, /**< 공백 문자입니다. */
+	};
+
+	extern const std::uint8_t char_class_table[256];
+
+	/**
+	 * @brief 문자가 주어진 종류에 속하는지 확인합니다.
+	 * @details 로캘에 영향을 받지 않으며 ASCII 범위 밖의 문자는 어떤 종류에도 속하지 않습니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param ch 확인할 문자입니다.
+	 * @param char_class 확인할 문자의 종류입니다.
+	 * @return 속하면 true, 속하지 않으면 false를 반환합니다.
+	 */
+	inline bool is_char_class(char ch, CharClass char_class) noexcept
+	{
+		return (char_class_table[static_cast<unsigned char>(ch)] & char_class) != 0;
+	}
+
+	const char* scan_identifier(const char* begin, const char* end) noexcept;
+	const char* scan_digits(const char* begin, const char* end) noexcept;
+	const char* scan_space(const char* begin, const char* end) noexcept;
+	const char* find_comment_end(const char* begin, const char* end) noexcept;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+/**
+ * @file SourceFile.hh
+ * @author kmc7468
+ * @brief SourceFile 클래스를 정의합니다.
+ */
+
+#include <cstddef>
+#include <string>
+
+#include "Token.hh"
+
+namespace Dlink
+{
+	/**
+	 * @brief 메모리에 매핑된 Dlink 코드 버퍼입니다.
+	 * @details 토큰은 이 버퍼의 일부분(오프셋과 길이)만을 가리키므로, 토큰을 사용하는 동안에는 인스턴스가 살아있어야 합니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	class SourceFile final
+	{
+	public:
+		SourceFile() noexcept;
+		SourceFile(const std::string& code);
+		SourceFile(const SourceFile& source_file) = delete;
+		SourceFile(SourceFile&& source_file) noexcept;
+		~SourceFile();
+
+	public:
+		SourceFile& operator=(const SourceFile& source_file) = delete;
+		SourceFile& operator=(SourceFile&& source_file) noexcept;
+		bool operator==(const SourceFile& source_file) const noexcept = delete;
+		bool operator!=(const SourceFile& source_file) const noexcept = delete;
+
+	public:
+		bool open(const std::string& path);
+		void close() noexcept;
+		void detach();
+
+		const char* data() const noexcept;
+		std::size_t size() const noexcept;
+		const std::string& path() const noexcept;
+		std::string text(const Token& token) const;
+
+	private:
+		std::string path_;
+		std::string code_;
+
+		const char* data_;
+		std::size_t size_;
+		void* mapping_;
+#ifdef _WIN32
+		void* file_handle_;
+		void* mapping_handle_;
+#endif
+	};
+}
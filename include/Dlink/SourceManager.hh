@@ -0,0 +1,66 @@
+#pragma once
+
+/**
+ * @file SourceManager.hh
+ * @author kmc7468
+ * @brief SourceManager 클래스를 정의합니다.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "SourceFile.hh"
+#include "Token.hh"
+
+namespace Dlink
+{
+	/**
+	 * @brief 사람이 읽을 수 있는 소스 코드 상의 위치입니다.
+	 * @details 이 구조체는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	struct SourceLocation final
+	{
+		/** 줄 번호입니다. 1부터 시작합니다. */
+		std::size_t line;
+		/** 세로단 번호입니다. 1부터 시작합니다. */
+		std::size_t col;
+	};
+
+	/**
+	 * @brief 토큰의 오프셋을 줄 번호와 세로단 번호로 바꿔주는 클래스입니다.
+	 * @details 토큰은 32비트 오프셋만 저장하고, 줄 번호와 세로단 번호는 진단 메세지를 출력할 때만 계산합니다.
+	 * 줄마다 시작 오프셋을 담은 색인은 처음 위치를 물어볼 때 한 번만 만들어집니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 * @see Dlink::Token
+	 * @see Dlink::SourceFile
+	 */
+	class SourceManager final
+	{
+	public:
+		SourceManager(const SourceFile& source);
+		SourceManager(const SourceManager& source_manager) = delete;
+		SourceManager(SourceManager&& source_manager) noexcept = delete;
+		~SourceManager() = default;
+
+	public:
+		SourceManager& operator=(const SourceManager& source_manager) = delete;
+		SourceManager& operator=(SourceManager&& source_manager) noexcept = delete;
+		bool operator==(const SourceManager& source_manager) const noexcept = delete;
+		bool operator!=(const SourceManager& source_manager) const noexcept = delete;
+
+	public:
+		SourceLocation location(std::uint32_t offset) const;
+		SourceLocation location(const Token& token) const;
+		const SourceFile& get_source() const noexcept;
+
+	private:
+		void build_line_index_() const;
+
+	private:
+		const SourceFile& source_;
+
+		mutable std::once_flag line_index_flag_;
+		mutable std::vector<std::uint32_t> line_starts_;
+	};
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+/**
+ * @file Symbol.hh
+ * @author kmc7468
+ * @brief Symbol 클래스를 정의합니다.
+ */
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace Dlink
+{
+	/**
+	 * @brief 인터닝된 식별자입니다.
+	 * @details 같은 철자의 식별자는 항상 같은 문자열 하나를 가리키므로, 비교와 해시는 포인터 연산 한 번으로 끝납니다.
+	 * 문자열은 프로그램이 끝날 때까지 해제되지 않습니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	class Symbol final
+	{
+	public:
+		Symbol() noexcept;
+		Symbol(const std::string& str);
+		Symbol(const char* str);
+		Symbol(const Symbol& symbol) noexcept = default;
+		~Symbol() = default;
+
+	public:
+		Symbol& operator=(const Symbol& symbol) noexcept = default;
+		bool operator==(const Symbol& symbol) const noexcept;
+		bool operator!=(const Symbol& symbol) const noexcept;
+
+	public:
+		static Symbol intern(const char* data, std::size_t length);
+
+		const std::string& str() const noexcept;
+		bool empty() const noexcept;
+
+	private:
+		explicit Symbol(const std::string* str) noexcept;
+
+	private:
+		const std::string* str_;
+
+		friend struct std::hash<Symbol>;
+	};
+}
+
+namespace std
+{
+	/**
+	 * @brief Dlink::Symbol에 대한 std::hash 특수화입니다.
+	 */
+	template<>
+	struct hash<Dlink::Symbol>
+	{
+		std::size_t operator()(const Dlink::Symbol& symbol) const noexcept
+		{
+			return std::hash<const std::string*>()(symbol.str_);
+		}
+	};
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+/**
+ * @file Target.hh
+ * @author kmc7468
+ * @brief 코드를 만들 대상 머신과 관련된 기능들의 집합입니다.
+ */
+
+#include <memory>
+#include <string>
+
+#include "llvm/Target/TargetMachine.h"
+
+#include "CompileOptions.hh"
+
+namespace Dlink
+{
+	void initialize_targets();
+	std::string get_target_triple(const CompileOptions& options);
+	llvm::CodeGenOpt::Level get_code_gen_opt_level(const CompileOptions& options) noexcept;
+	void get_target_cpu(const CompileOptions& options, std::string& cpu, std::string& features);
+	std::unique_ptr<llvm::TargetMachine> create_target_machine(const CompileOptions& options, std::string& error);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+/**
+ * @file ThreadPool.hh
+ * @author kmc7468
+ * @brief ThreadPool 클래스를 정의합니다.
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Dlink
+{
+	/**
+	 * @brief 정해진 개수의 작업 스레드에 작업을 나눠주는 스레드 풀입니다.
+	 * @details 작업은 제출된 순서대로 시작되지만, 끝나는 순서는 보장되지 않습니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	class ThreadPool final
+	{
+	public:
+		ThreadPool(std::size_t thread_count);
+		ThreadPool(const ThreadPool& thread_pool) = delete;
+		ThreadPool(ThreadPool&& thread_pool) noexcept = delete;
+		~ThreadPool();
+
+	public:
+		ThreadPool& operator=(const ThreadPool& thread_pool) = delete;
+		ThreadPool& operator=(ThreadPool&& thread_pool) noexcept = delete;
+		bool operator==(const ThreadPool& thread_pool) const noexcept = delete;
+		bool operator!=(const ThreadPool& thread_pool) const noexcept = delete;
+
+	public:
+		/**
+		 * @brief 작업을 제출합니다.
+		 * @details 작업에서 발생한 예외는 반환된 std::future의 get 함수를 호출할 때 다시 발생합니다.
+		 * @param function 작업 스레드에서 실행할 함수입니다.
+		 * @return 작업의 결과를 가져올 수 있는 std::future를 반환합니다.
+		 */
+		template<typename Function_>
+		std::future<typename std::result_of<Function_()>::type> submit(Function_&& function)
+		{
+			using Result = typename std::result_of<Function_()>::type;
+
+			auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function_>(function));
+			std::future<Result> result = task->get_future();
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				tasks_.push([task]()
+				{
+					(*task)();
+				});
+			}
+			condition_.notify_one();
+
+			return result;
+		}
+		std::size_t size() const noexcept;
+
+	private:
+		void stop_all_();
+		void work_();
+
+	private:
+		std::vector<std::thread> threads_;
+		std::queue<std::function<void()>> tasks_;
+
+		std::mutex mutex_;
+		std::condition_variable condition_;
+		bool stop_;
+	};
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+/**
+ * @file TimeTrace.hh
+ * @author kmc7468
+ * @brief TimeTrace 클래스를 정의합니다.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Dlink
+{
+	/**
+	 * @brief 컴파일 작업의 각 단계가 시작하고 끝난 시간을 기록해 Chrome trace-event JSON 파일로 씁니다.
+	 * @details 이벤트를 기록하는 스레드마다 번호를 붙이므로, 여러 작업 스레드에서 동시에 기록할 수 있습니다. 만든 파일은 chrome://tracing이나 Perfetto에서 열 수 있습니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 */
+	class TimeTrace final
+	{
+	public:
+		/**
+		 * @brief 생성된 때부터 소멸될 때까지를 하나의 이벤트로 기록합니다.
+		 * @details TimeTrace 인스턴스가 nullptr이라면 아무것도 기록하지 않습니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+		 */
+		class Scope final
+		{
+		public:
+			Scope(TimeTrace* time_trace, const char* name, const std::string& detail = std::string());
+			Scope(const Scope& scope) = delete;
+			Scope(Scope&& scope) noexcept = delete;
+			~Scope();
+
+		public:
+			Scope& operator=(const Scope& scope) = delete;
+			Scope& operator=(Scope&& scope) noexcept = delete;
+			bool operator==(const Scope& scope) const noexcept = delete;
+			bool operator!=(const Scope& scope) const noexcept = delete;
+
+		private:
+			TimeTrace* time_trace_;
+			const char* name_;
+			std::string detail_;
+			std::uint64_t begin_;
+		};
+
+	public:
+		TimeTrace();
+		TimeTrace(const TimeTrace& time_trace) = delete;
+		TimeTrace(TimeTrace&& time_trace) noexcept = delete;
+		~TimeTrace() = default;
+
+	public:
+		TimeTrace& operator=(const TimeTrace& time_trace) = delete;
+		TimeTrace& operator=(TimeTrace&& time_trace) noexcept = delete;
+		bool operator==(const TimeTrace& time_trace) const noexcept = delete;
+		bool operator!=(const TimeTrace& time_trace) const noexcept = delete;
+
+	public:
+		std::uint64_t now() const noexcept;
+		void add_event(const std::string& name, const std::string& detail, std::uint64_t begin, std::uint64_t end);
+		bool write(const std::string& path);
+		const std::string& get_error() const noexcept;
+
+	private:
+		/**
+		 * @brief 기록한 이벤트 하나입니다.
+		 * @details 이 구조체는 다른 곳에서 상속받을 수 없습니다.
+		 */
+		struct Event_ final
+		{
+			std::string name;
+			std::string detail;
+			std::uint64_t begin;
+			std::uint64_t end;
+			std::size_t thread;
+		};
+
+	private:
+		std::chrono::steady_clock::time_point start_;
+
+		std::mutex mutex_;
+		std::vector<Event_> events_;
+		std::unordered_map<std::thread::id, std::size_t> threads_;
+
+		std::string error_;
+	};
+}
@@ -6,17 +6,22 @@
  * @brief Token 클래스를 정의합니다.
  */
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <map>
 #include <utility>
 #include <vector>
 
+#include "Symbol.hh"
+
 namespace Dlink
 {
 	/**
 	 * @brief 토큰의 타입입니다.
+	 * @details 토큰의 크기를 줄이기 위해 1바이트로 저장합니다.
 	 */
-    enum class TokenType
+    enum class TokenType : std::uint8_t
     {
         none,               /**< 알 수 없는 토큰입니다. */
         eof,                /**< 파일의 끝입니다. */
@@ -115,29 +120,120 @@ namespace Dlink
 
 	/**
 	 * @brief Dlink 코드를 구성하는 최소한의 단위입니다.
-	 * @details 이 구조체는 다른 곳에서 상속받을 수 없습니다.
+	 * @details 토큰은 원본 문장을 복사하지 않고 소스 버퍼의 일부분만을 가리킵니다. 줄 번호와 세로단 번호는 저장하지 않으며, 필요할 때 SourceManager로 오프셋에서 계산합니다.
+	 * 따라서 소스 버퍼는 4GiB보다 작아야 합니다. 이 구조체는 다른 곳에서 상속받을 수 없습니다.
 	 * @see Dlink::Lexer
+	 * @see Dlink::SourceFile
+	 * @see Dlink::SourceManager
 	 */
     struct Token final
     {
 		Token() = default;
-		Token(const std::string& data_, TokenType type_, const std::size_t line_, const std::size_t end_col_);
+		Token(std::uint32_t offset_, std::uint32_t length_, TokenType type_);
     
-		/** 토큰의 원본 문장입니다. */
-		std::string data;
+		/** 토큰의 원본 문장이 소스 버퍼에서 시작되는 오프셋입니다. */
+		std::uint32_t offset = 0;
+		/** 토큰의 원본 문장의 길이입니다. */
+		std::uint32_t length = 0;
 		/** TokenType 형식의 토큰의 타입입니다. */
-		TokenType type;
-
-		/** 토큰의 줄 번호입니다. */
-		std::size_t line;
-		/** 토큰이 끝나는 위치의 세로단 번호입니다. */
-		std::size_t end_col;
-		/** 토큰이 시작되는 위치의 세로단 번호입니다. */
-		std::size_t col;
+		TokenType type = TokenType::none;
+
+		/** 식별자 토큰이라면 렉싱할 때 인터닝된 식별자입니다. 식별자 토큰이 아니라면 비어 있습니다. */
+		Symbol symbol;
 	};
 
 	/** Token에 대한 std::vector 타입입니다. */
     using TokenSeq = std::vector<Token>;
 
     extern const std::map<TokenType, std::string> token_map;
+
+	/**
+	 * @brief 문자열이 주어진 키워드와 같은지 비교합니다.
+	 * @details keyword_type 함수에서 사용합니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param data 비교할 문자열입니다. 적어도 length 바이트 길이여야 합니다.
+	 * @param keyword 길이가 length인 키워드입니다.
+	 * @param length 비교할 길이입니다.
+	 * @return 같으면 true, 다르면 false를 반환합니다.
+	 */
+	constexpr bool keyword_equal(const char* data, const char* keyword, std::size_t length) noexcept
+	{
+		for (std::size_t i = 0; i < length; ++i)
+		{
+			if (data[i] != keyword[i]) return false;
+		}
+
+		return true;
+	}
+	/**
+	 * @brief 식별자가 키워드라면 해당 키워드의 타입을 가져옵니다.
+	 * @details 길이와 첫 글자(필요하면 두번째 글자)로 후보를 하나로 좁힌 뒤 한 번만 비교하므로, 메모리를 할당하거나 탐색하지 않습니다. 컴파일 시간에도 사용할 수 있습니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param data 식별자의 시작 주소입니다. null 문자로 끝나지 않아도 됩니다.
+	 * @param length 식별자의 길이입니다.
+	 * @return 키워드라면 해당 키워드의 TokenType을, 키워드가 아니라면 TokenType::identifier를 반환합니다.
+	 */
+	constexpr TokenType keyword_type(const char* data, std::size_t length) noexcept
+	{
+		switch (length)
+		{
+		case 2:
+			switch (data[0])
+			{
+			case 'i': return keyword_equal(data, "if", 2) ? TokenType::_if : TokenType::identifier;
+			case 'd': return keyword_equal(data, "do", 2) ? TokenType::_do : TokenType::identifier;
+			}
+			break;
+
+		case 3:
+			switch (data[0])
+			{
+			case 'f': return keyword_equal(data, "for", 3) ? TokenType::_for : TokenType::identifier;
+			case 'i': return keyword_equal(data, "int", 3) ? TokenType::_int : TokenType::identifier;
+			}
+			break;
+
+		case 4:
+			switch (data[0])
+			{
+			case 'e': return keyword_equal(data, "else", 4) ? TokenType::_else : TokenType::identifier;
+			case 'c':
+				if (data[1] == 'a') return keyword_equal(data, "case", 4) ? TokenType::_case : TokenType::identifier;
+				else return keyword_equal(data, "char", 4) ? TokenType::_char : TokenType::identifier;
+			case 'n': return keyword_equal(data, "null", 4) ? TokenType::_null : TokenType::identifier;
+			case 'l': return keyword_equal(data, "long", 4) ? TokenType::_long : TokenType::identifier;
+			case 'v': return keyword_equal(data, "void", 4) ? TokenType::_void : TokenType::identifier;
+			}
+			break;
+
+		case 5:
+			switch (data[0])
+			{
+			case 'w': return keyword_equal(data, "while", 5) ? TokenType::_while : TokenType::identifier;
+			case 'b': return keyword_equal(data, "break", 5) ? TokenType::_break : TokenType::identifier;
+			case 'c': return keyword_equal(data, "const", 5) ? TokenType::_const : TokenType::identifier;
+			case 's': return keyword_equal(data, "short", 5) ? TokenType::_short : TokenType::identifier;
+			}
+			break;
+
+		case 6:
+			switch (data[0])
+			{
+			case 'u': return keyword_equal(data, "unsafe", 6) ? TokenType::unsafe : TokenType::identifier;
+			case 's':
+				if (data[1] == 'w') return keyword_equal(data, "switch", 6) ? TokenType::_switch : TokenType::identifier;
+				else return keyword_equal(data, "signed", 6) ? TokenType::_signed : TokenType::identifier;
+			case 'r': return keyword_equal(data, "return", 6) ? TokenType::_return : TokenType::identifier;
+			}
+			break;
+
+		case 8:
+			switch (data[0])
+			{
+			case 'c': return keyword_equal(data, "continue", 8) ? TokenType::_continue : TokenType::identifier;
+			case 'u': return keyword_equal(data, "unsigned", 8) ? TokenType::_unsigned : TokenType::identifier;
+			}
+			break;
+		}
+
+		return TokenType::identifier;
+	}
 }
@@ -0,0 +1,58 @@
+#pragma once
+
+/**
+ * @file TokenStream.hh
+ * @author kmc7468
+ * @brief TokenStream 클래스를 정의합니다.
+ */
+
+#include <cstddef>
+
+#include "Lexer.hh"
+#include "Token.hh"
+
+namespace Dlink
+{
+	/**
+	 * @brief 파서가 필요할 때마다 토큰을 하나씩 가져오는 토큰 스트림입니다.
+	 * @details Lexer로부터 만들어진 경우 토큰 목록을 만들지 않고, 고정된 크기의 윈도우에 직전 토큰과 현재 토큰, 다음 토큰만 보관합니다. 따라서 사용하는 메모리는 파일의 크기와 상관 없이 일정합니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+	 * @see Dlink::Lexer
+	 * @see Dlink::Parser
+	 */
+	class TokenStream final
+	{
+	public:
+		TokenStream(Lexer& lexer);
+		TokenStream(const TokenSeq& token_seq);
+		TokenStream(const TokenStream& token_stream) = delete;
+		TokenStream(TokenStream&& token_stream) noexcept = delete;
+		~TokenStream() = default;
+
+	public:
+		TokenStream& operator=(const TokenStream& token_stream) = delete;
+		TokenStream& operator=(TokenStream&& token_stream) noexcept = delete;
+		bool operator==(const TokenStream& token_stream) const noexcept = delete;
+		bool operator!=(const TokenStream& token_stream) const noexcept = delete;
+
+	public:
+		const Token& current() const noexcept;
+		const Token& previous() const noexcept;
+		const Token& next() const noexcept;
+		void advance();
+
+	private:
+		const Token& at_(std::size_t position) const noexcept;
+		void fill_();
+
+	private:
+		/** 윈도우의 크기입니다. 직전 토큰, 현재 토큰, 다음 토큰을 담을 수 있어야 합니다. */
+		static constexpr std::size_t window_size_ = 4;
+
+		Lexer* lexer_;
+		const TokenSeq* token_seq_;
+
+		Token window_[window_size_];
+		std::size_t position_;
+		std::size_t fetched_;
+	};
+}
@@ -0,0 +1,97 @@
+#include "ASTContext.hh"
+
+#include <cstdint>
+
+namespace Dlink
+{
+	/**
+	 * @brief 빈 ASTContext 인스턴스를 만듭니다.
+	 * @details 첫 노드를 만들 때 메모리 블록을 할당합니다. 이 함수는 예외를 발생시키지 않습니다.
+	 */
+	ASTContext::ASTContext() noexcept
+		: current_(nullptr), end_(nullptr)
+	{}
+	/**
+	 * @brief 기존 인스턴스의 노드들을 이동해 새 ASTContext 인스턴스를 만듭니다.
+	 * @details 메모리 블록을 그대로 옮기므로 노드를 가리키던 포인터는 계속 유효합니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param context 이동할 기존 인스턴스입니다.
+	 */
+	ASTContext::ASTContext(ASTContext&& context) noexcept
+		: blocks_(std::move(context.blocks_)), current_(context.current_), end_(context.end_),
+		destructors_(std::move(context.destructors_))
+	{
+		context.blocks_.clear();
+		context.destructors_.clear();
+		context.current_ = context.end_ = nullptr;
+	}
+	ASTContext::~ASTContext()
+	{
+		clear();
+	}
+
+	/**
+	 * @brief 다른 ASTContext 인스턴스의 노드들을 현재 인스턴스로 이동합니다.
+	 * @details 현재 인스턴스가 갖고 있던 노드들은 모두 소멸됩니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param context 이동할 다른 인스턴스입니다.
+	 * @return 현재 인스턴스를 반환합니다.
+	 */
+	ASTContext& ASTContext::operator=(ASTContext&& context) noexcept
+	{
+		if (this == &context)
+			return *this;
+
+		clear();
+
+		blocks_ = std::move(context.blocks_);
+		destructors_ = std::move(context.destructors_);
+		current_ = context.current_;
+		end_ = context.end_;
+
+		context.blocks_.clear();
+		context.destructors_.clear();
+		context.current_ = context.end_ = nullptr;
+
+		return *this;
+	}
+
+	/**
+	 * @brief 아레나에서 메모리를 할당합니다.
+	 * @details 현재 블록에 공간이 남아 있다면 포인터를 옮기기만 합니다. block_size_보다 큰 요청은 전용 블록을 할당합니다.
+	 * @param size 할당할 크기입니다.
+	 * @param alignment 할당할 메모리의 정렬 단위입니다. 2의 거듭제곱이어야 합니다.
+	 * @return 할당된 메모리의 주소를 반환합니다.
+	 */
+	void* ASTContext::allocate(std::size_t size, std::size_t alignment)
+	{
+		std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(current_) + alignment - 1) & ~(alignment - 1);
+
+		if (!current_ || address + size > reinterpret_cast<std::uintptr_t>(end_))
+		{
+			std::size_t new_block_size = size + alignment > block_size_ ? size + alignment : block_size_;
+			blocks_.emplace_back(new char[new_block_size]);
+
+			current_ = blocks_.back().get();
+			end_ = current_ + new_block_size;
+
+			address = (reinterpret_cast<std::uintptr_t>(current_) + alignment - 1) & ~(alignment - 1);
+		}
+
+		current_ = reinterpret_cast<char*>(address + size);
+		return reinterpret_cast<void*>(address);
+	}
+	/**
+	 * @brief 모든 노드를 만들어진 역순으로 소멸시키고 메모리 블록을 해제합니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 */
+	void ASTContext::clear() noexcept
+	{
+		for (auto iter = destructors_.rbegin(); iter != destructors_.rend(); ++iter)
+		{
+			iter->second(iter->first);
+		}
+
+		destructors_.clear();
+		blocks_.clear();
+		current_ = end_ = nullptr;
+	}
+}
@@ -0,0 +1,331 @@
+#include "ASTDumper.hh"
+#include "JSON.hh"
+
+#include "ParseStruct.hh"
+
+namespace Dlink
+{
+	extern std::string operator_string(TokenType operator_type);
+
+	/**
+	 * @brief 새 ASTDumper 인스턴스를 만듭니다.
+	 * @param stream 추상 구문 트리를 출력할 스트림입니다. 인스턴스가 소멸될 때까지 살아있어야 합니다.
+	 * @param format 출력 형식입니다.
+	 */
+	ASTDumper::ASTDumper(std::ostream& stream, ASTDumpFormat format)
+		: stream_(stream), format_(format)
+	{
+		buffer_.reserve(buffer_capacity_);
+	}
+	/**
+	 * @brief 내부 버퍼에 남은 출력을 스트림에 쓰고 인스턴스를 소멸합니다.
+	 */
+	ASTDumper::~ASTDumper()
+	{
+		flush();
+	}
+
+	/**
+	 * @brief 노드의 트리를 스트림에 출력합니다.
+	 * @details 하위 노드를 재귀 호출로 방문하지 않으므로, 트리가 아무리 깊어도 네이티브 스택을 일정하게 사용합니다. 출력 형식이 JSON이면 상위 노드가 항상 하위 노드보다 먼저 출력되므로 줄 단위로 읽으며 트리를 다시 만들 수 있습니다.
+	 * @param node 출력할 트리의 루트 노드입니다. nullptr이면 아무 것도 출력하지 않습니다.
+	 */
+	void ASTDumper::dump(const Node* node)
+	{
+		if (format_ == ASTDumpFormat::None || !node)
+			return;
+
+		stack_.push_back({ nullptr, false, node, nullptr, 0, none_, nullptr, none_ });
+
+		while (!stack_.empty())
+		{
+			Item_ item = stack_.back();
+			stack_.pop_back();
+
+			if (!item.node && !item.type)
+			{
+				write_indent_(item.depth);
+				buffer_ += item.label;
+				buffer_ += item.is_empty ? ": empty\n" : ":\n";
+			}
+			else
+			{
+				value_.clear();
+				attributes_.clear();
+				fields_.clear();
+
+				if (item.node)
+				{
+					item.node->accept(*this);
+				}
+				else
+				{
+					item.type->accept(*this);
+				}
+
+				write_(item);
+			}
+
+			if (buffer_.size() >= buffer_capacity_)
+			{
+				flush();
+			}
+		}
+
+		flush();
+	}
+	/**
+	 * @brief 내부 버퍼에 모인 출력을 스트림에 씁니다.
+	 */
+	void ASTDumper::flush()
+	{
+		stream_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+		buffer_.clear();
+	}
+
+	void ASTDumper::visit(const Identifier& node)
+	{
+		begin_("Identifier", node.token, node.id.str());
+	}
+	void ASTDumper::visit(const Block& node)
+	{
+		begin_("Block", node.token);
+		list_("statements", node.statements);
+	}
+	void ASTDumper::visit(const Scope& node)
+	{
+		begin_("Scope", node.token);
+		list_("statements", node.statements);
+	}
+	void ASTDumper::visit(const ExpressionStatement& node)
+	{
+		begin_("ExpressionStatement", node.token);
+		field_("expression", node.expression);
+	}
+
+	void ASTDumper::visit(const Integer32& node)
+	{
+		begin_("Integer32", node.token, std::to_string(node.data));
+	}
+	void ASTDumper::visit(const String& node)
+	{
+		begin_("String", node.token, node.data);
+	}
+	void ASTDumper::visit(const Character& node)
+	{
+		begin_("Character", node.token, std::string(1, node.data));
+	}
+	void ASTDumper::visit(const BinaryOperation& node)
+	{
+		begin_("BinaryOperation", node.token, operator_string(node.op));
+		field_("lhs", node.lhs);
+		field_("rhs", node.rhs);
+	}
+	void ASTDumper::visit(const UnaryOperation& node)
+	{
+		begin_("UnaryOperation", node.token, operator_string(node.op));
+		field_("rhs", node.rhs);
+	}
+	void ASTDumper::visit(const FunctionCallOperation& node)
+	{
+		begin_("FunctionCallOperation", node.token);
+		field_("func_expr", node.func_expr);
+		list_("argument", node.argument);
+	}
+	void ASTDumper::visit(const ArrayInitList& node)
+	{
+		begin_("ArrayInitList", node.token);
+		list_("elements", node.elements);
+	}
+	void ASTDumper::visit(const UnsafeExpression& node)
+	{
+		begin_("UnsafeExpression", node.token);
+		field_("expression", node.expression);
+	}
+	void ASTDumper::visit(const ReturnStatement& node)
+	{
+		begin_("ReturnStatement", node.token);
+		field_("return_expr", node.return_expr);
+	}
+	void ASTDumper::visit(const UnsafeStatement& node)
+	{
+		begin_("UnsafeStatement", node.token);
+		field_("statement", node.statement);
+	}
+
+	void ASTDumper::visit(const VariableDeclaration& node)
+	{
+		begin_("VariableDeclaration", node.token, node.identifier.str());
+		field_("type", node.type);
+		field_("expression", node.expression);
+	}
+	void ASTDumper::visit(const FunctionDeclaration& node)
+	{
+		begin_("FunctionDeclaration", node.token, node.identifier.str());
+		field_("return_type", node.return_type);
+		list_("parameter");
+		for (const VariableDeclaration& param : node.parameter)
+		{
+			element_(&param);
+		}
+		field_("body", node.body);
+	}
+
+	void ASTDumper::visit(const SimpleType& node)
+	{
+		begin_("SimpleType", node.token, node.identifier);
+		attribute_("is_unsigned", node.is_unsigned ? "true" : "false");
+	}
+	void ASTDumper::visit(const StaticArray& node)
+	{
+		begin_("StaticArray", node.token);
+		field_("type", node.type);
+		field_("length", node.length);
+	}
+	void ASTDumper::visit(const LValueReference& node)
+	{
+		begin_("LValueReference", node.token);
+		field_("type", node.type);
+	}
+	void ASTDumper::visit(const Pointer& node)
+	{
+		begin_("Pointer", node.token);
+		field_("type", node.type);
+	}
+
+	void ASTDumper::begin_(const char* kind, const Token& token, const std::string& value)
+	{
+		kind_ = kind;
+		token_ = token;
+		value_ = value;
+	}
+	void ASTDumper::attribute_(const char* name, const std::string& value)
+	{
+		attributes_.emplace_back(name, value);
+	}
+	void ASTDumper::field_(const char* name, const Node* node)
+	{
+		fields_.push_back({ name, false, node, nullptr });
+	}
+	void ASTDumper::field_(const char* name, const Type* type)
+	{
+		fields_.push_back({ name, false, nullptr, type });
+	}
+	void ASTDumper::list_(const char* name)
+	{
+		fields_.push_back({ name, true, nullptr, nullptr });
+	}
+	void ASTDumper::element_(const Node* node)
+	{
+		if (node)
+		{
+			fields_.push_back({ nullptr, false, node, nullptr });
+		}
+	}
+
+	void ASTDumper::write_(const Item_& item)
+	{
+		const std::size_t id = next_id_++;
+
+		if (format_ == ASTDumpFormat::Tree)
+		{
+			write_indent_(item.depth);
+			buffer_ += kind_;
+			if (!value_.empty())
+			{
+				buffer_ += '(';
+				buffer_ += value_;
+				buffer_ += ')';
+			}
+			if (!attributes_.empty() || !fields_.empty())
+			{
+				buffer_ += ':';
+			}
+			buffer_ += '\n';
+
+			for (const auto& attribute : attributes_)
+			{
+				write_indent_(item.depth + 1);
+				buffer_ += attribute.first;
+				buffer_ += ": ";
+				buffer_ += attribute.second;
+				buffer_ += '\n';
+			}
+		}
+		else
+		{
+			buffer_ += "{\"id\":";
+			buffer_ += std::to_string(id);
+			buffer_ += ",\"parent\":";
+			buffer_ += item.parent == none_ ? "null" : std::to_string(item.parent);
+			if (item.field)
+			{
+				buffer_ += ",\"field\":\"";
+				buffer_ += item.field;
+				buffer_ += '"';
+			}
+			if (item.index != none_)
+			{
+				buffer_ += ",\"index\":";
+				buffer_ += std::to_string(item.index);
+			}
+			buffer_ += ",\"kind\":\"";
+			buffer_ += kind_;
+			buffer_ += "\",\"offset\":";
+			buffer_ += std::to_string(token_.offset);
+			buffer_ += ",\"length\":";
+			buffer_ += std::to_string(token_.length);
+			if (!value_.empty())
+			{
+				buffer_ += ",\"value\":";
+				append_json_string(buffer_, value_);
+			}
+			for (const auto& attribute : attributes_)
+			{
+				buffer_ += ",\"";
+				buffer_ += attribute.first;
+				buffer_ += "\":";
+				append_json_string(buffer_, attribute.second);
+			}
+			buffer_ += "}\n";
+		}
+
+		// 하위 노드는 출력할 순서대로 모은 뒤 스택에 거꾸로 넣습니다.
+		pending_.clear();
+
+		const char* list_name = nullptr;
+		std::size_t index = 0;
+		for (std::size_t i = 0; i < fields_.size(); ++i)
+		{
+			const Field_& field = fields_[i];
+
+			if (!field.name)
+			{
+				pending_.push_back({ nullptr, false, field.node, nullptr, item.depth + 2, id, list_name, index++ });
+				continue;
+			}
+
+			const bool has_child = field.is_list ? i + 1 < fields_.size() && !fields_[i + 1].name : field.node || field.type;
+			if (format_ == ASTDumpFormat::Tree)
+			{
+				pending_.push_back({ field.name, !has_child, nullptr, nullptr, item.depth + 1, id, nullptr, none_ });
+			}
+
+			if (field.is_list)
+			{
+				list_name = field.name;
+				index = 0;
+			}
+			else if (has_child)
+			{
+				pending_.push_back({ nullptr, false, field.node, field.type, item.depth + 2, id, field.name, none_ });
+			}
+		}
+
+		stack_.insert(stack_.end(), pending_.rbegin(), pending_.rend());
+	}
+	void ASTDumper::write_indent_(std::size_t depth)
+	{
+		buffer_.append(depth * 4, ' ');
+	}
+}
@@ -1,4 +1,7 @@
 #include "Any.hh"
+
+#include <utility>
+
 #include "ParseStruct/Root.hh"
 
 namespace Dlink
@@ -20,6 +23,14 @@ namespace Dlink
 		else
 			data_ = any.data_->copy();
 	}
+	/**
+	 * @brief 기존 인스턴스의 값을 이동해 새 Any 인스턴스를 만듭니다.
+	 * @details 값을 복사하지 않습니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param any 이동할 기존 인스턴스입니다. 이동한 뒤에는 비어 있습니다.
+	 */
+	Any::Any(Any&& any) noexcept
+		: data_(std::move(any.data_))
+	{}
 
 	/**
 	 * @brief 다른 Any 인스턴스의 값을 현재 인스턴스에 대입합니다.
@@ -34,6 +45,17 @@ namespace Dlink
 			data_ = any.data_->copy();
 		return *this;
 	}
+	/**
+	 * @brief 다른 Any 인스턴스의 값을 현재 인스턴스로 이동합니다.
+	 * @details 값을 복사하지 않습니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param any 이동할 다른 인스턴스입니다. 이동한 뒤에는 비어 있습니다.
+	 * @return 현재 인스턴스를 반환합니다.
+	 */
+	Any& Any::operator=(Any&& any) noexcept
+	{
+		data_ = std::move(any.data_);
+		return *this;
+	}
 
 	/**
 	 * @brief 현재 Any 인스턴스가 비어 있는지 확인합니다.
@@ -143,4 +165,204 @@ namespace Dlink
 
 		return false;
 	}
+	/**
+	 * @brief 두 Any 인스턴스끼리 정수 전용 이항 연산(나머지, 비트, 시프트, 비교, 논리 연산)을 수행합니다.
+	 * @details 비교 연산과 논리 연산의 결과는 1 또는 0입니다. 0으로 나누는 나머지 연산이나 범위를 벗어난 시프트 연산은 계산하지 않습니다.
+	 * @param op 연산자 타입입니다.
+	 * @param lhs 이항 연산에서 왼쪽에 올 Any 인스턴스입니다.
+	 * @param rhs 이항 연산에서 오른쪽에 올 Any 인스턴스입니다.
+	 * @param out 이항 연산의 계산 값을 저장할 Any 인스턴스입니다.
+	 * @return 이항 연산을 성공했다면 true, 실패했다면 false를 반환합니다.
+	 */
+	bool Expression::any_integer_binary(TokenType op, const Any& lhs, const Any& rhs, Any& out)
+	{
+		if (lhs.type() != typeid(std::int64_t) || rhs.type() != typeid(std::int64_t))
+			return false;
+
+		std::int64_t lhs_value = lhs.get<std::int64_t>();
+		std::int64_t rhs_value = rhs.get<std::int64_t>();
+
+		switch (op)
+		{
+		case TokenType::modulo:
+			if (rhs_value == 0)
+				return false;
+			out = lhs_value % rhs_value;
+			return true;
+
+		case TokenType::bit_and:
+			out = lhs_value & rhs_value;
+			return true;
+		case TokenType::bit_or:
+			out = lhs_value | rhs_value;
+			return true;
+		case TokenType::bit_xor:
+			out = lhs_value ^ rhs_value;
+			return true;
+		case TokenType::bit_lshift:
+			if (rhs_value < 0 || rhs_value >= 64)
+				return false;
+			out = static_cast<std::int64_t>(static_cast<std::uint64_t>(lhs_value) << rhs_value);
+			return true;
+		case TokenType::bit_rshift:
+			if (rhs_value < 0 || rhs_value >= 64)
+				return false;
+			out = lhs_value >> rhs_value;
+			return true;
+
+		case TokenType::equal:
+			out = static_cast<std::int64_t>(lhs_value == rhs_value);
+			return true;
+		case TokenType::noteq:
+			out = static_cast<std::int64_t>(lhs_value != rhs_value);
+			return true;
+		case TokenType::less:
+			out = static_cast<std::int64_t>(lhs_value < rhs_value);
+			return true;
+		case TokenType::eqless:
+			out = static_cast<std::int64_t>(lhs_value <= rhs_value);
+			return true;
+		case TokenType::greater:
+			out = static_cast<std::int64_t>(lhs_value > rhs_value);
+			return true;
+		case TokenType::eqgreater:
+			out = static_cast<std::int64_t>(lhs_value >= rhs_value);
+			return true;
+
+		case TokenType::logic_and:
+			out = static_cast<std::int64_t>(lhs_value && rhs_value);
+			return true;
+		case TokenType::logic_or:
+			out = static_cast<std::int64_t>(lhs_value || rhs_value);
+			return true;
+
+		default:
+			return false;
+		}
+	}
+	/**
+	 * @brief Any 인스턴스에 정수 전용 단항 연산(논리 부정, 비트 반전)을 수행합니다.
+	 * @param op 연산자 타입입니다.
+	 * @param rhs 피연산자인 Any 인스턴스입니다.
+	 * @param out 단항 연산의 계산 값을 저장할 Any 인스턴스입니다.
+	 * @return 단항 연산을 성공했다면 true, 실패했다면 false를 반환합니다.
+	 */
+	bool Expression::any_integer_unary(TokenType op, const Any& rhs, Any& out)
+	{
+		if (rhs.type() != typeid(std::int64_t))
+			return false;
+
+		std::int64_t rhs_value = rhs.get<std::int64_t>();
+
+		switch (op)
+		{
+		case TokenType::exclamation:
+			out = static_cast<std::int64_t>(!rhs_value);
+			return true;
+		case TokenType::bit_not:
+			out = ~rhs_value;
+			return true;
+
+		default:
+			return false;
+		}
+	}
+
+	/**
+	 * @brief 컴파일 시간에 계산된 두 값에 이항 연산을 수행합니다.
+	 * @details Expression::evaluate와 FlatAST::evaluate가 함께 사용합니다.
+	 * @param op 연산자 타입입니다.
+	 * @param lhs 좌측 피연산자의 값입니다.
+	 * @param rhs 우측 피연산자의 값입니다.
+	 * @param out 계산된 값을 저장할 Any 인스턴스입니다. 계산에 실패하면 바뀌지 않습니다.
+	 * @return 계산을 성공했다면 true, 실패했다면 false를 반환합니다.
+	 */
+	bool Expression::evaluate_binary(TokenType op, const Any& lhs, const Any& rhs, Any& out)
+	{
+		Any eval;
+		bool eval_ok;
+
+		switch (op)
+		{
+		case TokenType::plus:
+			eval_ok = any_add(lhs, rhs, eval);
+			break;
+
+		case TokenType::minus:
+			eval_ok = any_sub(lhs, rhs, eval);
+			break;
+
+		case TokenType::multiply:
+			eval_ok = any_mul(lhs, rhs, eval);
+			break;
+
+		case TokenType::divide:
+			eval_ok = any_div(lhs, rhs, eval);
+			break;
+
+		case TokenType::modulo:
+		case TokenType::bit_and:
+		case TokenType::bit_or:
+		case TokenType::bit_xor:
+		case TokenType::bit_lshift:
+		case TokenType::bit_rshift:
+		case TokenType::equal:
+		case TokenType::noteq:
+		case TokenType::less:
+		case TokenType::eqless:
+		case TokenType::greater:
+		case TokenType::eqgreater:
+		case TokenType::logic_and:
+		case TokenType::logic_or:
+			eval_ok = any_integer_binary(op, lhs, rhs, eval);
+			break;
+
+		default:
+			return false;
+		}
+
+		if (eval_ok)
+		{
+			out = std::move(eval);
+		}
+		return eval_ok;
+	}
+	/**
+	 * @brief 컴파일 시간에 계산된 값에 단항 연산을 수행합니다.
+	 * @details Expression::evaluate와 FlatAST::evaluate가 함께 사용합니다.
+	 * @param op 연산자 타입입니다.
+	 * @param rhs 피연산자의 값입니다.
+	 * @param out 계산된 값을 저장할 Any 인스턴스입니다. 계산에 실패하면 바뀌지 않습니다.
+	 * @return 계산을 성공했다면 true, 실패했다면 false를 반환합니다.
+	 */
+	bool Expression::evaluate_unary(TokenType op, const Any& rhs, Any& out)
+	{
+		Any eval;
+		bool eval_ok;
+
+		switch (op)
+		{
+		case TokenType::plus:
+			eval_ok = any_add(0, rhs, eval);
+			break;
+
+		case TokenType::minus:
+			eval_ok = any_sub(0, rhs, eval);
+			break;
+
+		case TokenType::exclamation:
+		case TokenType::bit_not:
+			eval_ok = any_integer_unary(op, rhs, eval);
+			break;
+
+		default:
+			return false;
+		}
+
+		if (eval_ok)
+		{
+			out = std::move(eval);
+		}
+		return eval_ok;
+	}
 }
\ No newline at end of file
@@ -1,57 +1,123 @@
 #include "Assembler.hh"
-#include "Init.hh"
+#include "CodeGen.hh"
+#include "FlatAST.hh"
 
-#include "llvm/Transforms/Scalar/GVN.h"
+#include <algorithm>
+#include <future>
+#include <utility>
+
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Linker/Linker.h"
+#include "llvm/Support/raw_ostream.h"
 
 namespace Dlink
 {
-	Assembler::LLVMBuilder::LLVMBuilder()
+	/**
+	 * @brief 새 LLVMBuilder 인스턴스를 만듭니다.
+	 * @details 최적화한다면 모듈에 대상 머신의 트리플과 데이터 레이아웃을 설정합니다.
+	 * @param options 컴파일 설정입니다.
+	 * @param optimizer 사용할 Optimizer 인스턴스입니다. 같은 설정으로 만든 인스턴스여야 하며, nullptr이면 새로 만듭니다.
+	 */
+	Assembler::LLVMBuilder::LLVMBuilder(const CompileOptions& options, std::shared_ptr<Optimizer> optimizer)
 		: context(), module(std::make_shared<llvm::Module>("top", context)),
-		builder(context), function_pm(nullptr)
+		builder(context), optimizer(optimizer ? std::move(optimizer) : std::make_shared<Optimizer>(options))
 	{
-		function_pm = std::make_unique<llvm::legacy::FunctionPassManager>(module.get());
-
-		if (opt_level > 0)
-		{
-			function_pm->add(llvm::createInstructionCombiningPass());
-			function_pm->add(llvm::createReassociatePass());
-			function_pm->add(llvm::createGVNPass());
-			function_pm->add(llvm::createCFGSimplificationPass());
-		}
-
-		function_pm->doInitialization();
+		this->optimizer->configure_module(*module);
 	}
 
-	Assembler::Assembler(AST& ast)
-		: ast_(ast)
+	/**
+	 * @brief 새 CodeGenState 인스턴스를 만듭니다.
+	 */
+	Assembler::CodeGenState::CodeGenState()
+		: type_symbol_table(std::make_shared<TypeSymbolTable>())
+	{}
+
+	/**
+	 * @brief 새 Assembler 인스턴스를 만듭니다.
+	 * @param ast LLVM IR 코드를 만들 추상 구문 트리입니다.
+	 * @param options 컴파일 설정입니다.
+	 * @param optimizer 사용할 Optimizer 인스턴스입니다. 같은 설정으로 만든 인스턴스여야 하며, nullptr이면 새로 만듭니다. 최적화 파이프라인은 여러 컴파일 작업에서 다시 사용할 수 있지만, 동시에 사용할 수는 없습니다.
+	 * @param time_trace 코드를 만드는 데 걸린 시간을 기록할 TimeTrace 인스턴스입니다. nullptr이면 기록하지 않습니다. 인스턴스가 살아있는 동안 살아있어야 합니다.
+	 */
+	Assembler::Assembler(AST& ast, const CompileOptions& options, std::shared_ptr<Optimizer> optimizer, TimeTrace* time_trace)
+		: ast_(ast), options_(options), builder_(options_, std::move(optimizer)), time_trace_(time_trace)
 	{
-		assemblers[std::this_thread::get_id()] = this;
+		builder_.optimizer->set_time_trace(time_trace_);
 	}
+	/**
+	 * @brief Assembler 인스턴스를 소멸시킵니다.
+	 * @details Optimizer 인스턴스는 다른 컴파일 작업에서 다시 사용할 수 있으므로, 이 인스턴스의 TimeTrace 인스턴스를 더 이상 사용하지 않게 합니다.
+	 */
 	Assembler::~Assembler()
 	{
-		std::vector<std::map<std::thread::id, Assembler*>::iterator> iters;
+		builder_.optimizer->set_time_trace(nullptr);
+	}
+
+	/**
+	 * @brief 추상 구문 트리로 LLVM IR 코드를 만듭니다.
+	 * @details 코드를 만드는 동안 이 인스턴스를 현재 스레드의 인스턴스로 설정하고, 끝나면 원래대로 되돌립니다. 함수는 코드를 만들 때마다 단순화하고, 모든 코드를 만든 뒤 모듈 전체를 최적화합니다.
+	 * @return LLVM IR 코드를 만들었을 경우 true를, 오류가 발생했을 경우 false를 반환합니다.
+	 */
+	bool Assembler::to_llvm_ir()
+	{
+		CurrentGuard_ guard(this);
 
-		for (auto iter = assemblers.begin(); iter != assemblers.end(); ++iter)
+		try
 		{
-			if (iter->second == this)
 			{
-				iters.push_back(iter);
+				TimeTrace::Scope scope(time_trace_, "Assembler::preprocess");
+				ast_.node_->preprocess();
+			}
+			{
+				TimeTrace::Scope scope(time_trace_, "Assembler::code_gen");
+				ast_.node_->code_gen();
 			}
-		}
 
-		for (auto iter = iters.cbegin(); iter < iters.cend(); ++iter)
+			builder_.optimizer->optimize_module(*builder_.module);
+			return true;
+		}
+		catch (Error& error)
 		{
-			assemblers.erase(*iter);
+			errors_.add_error(error);
+			return false;
 		}
 	}
-
-	bool Assembler::to_llvm_ir()
+	/**
+	 * @brief 코드를 만들기 전에 추상 구문 트리의 모든 함수를 선언합니다.
+	 * @details 선언하는 동안 이 인스턴스를 현재 스레드의 인스턴스로 설정합니다. 선언한 함수들은 CodeGenState::declarations에 선언한 순서대로 저장됩니다.
+	 * @return 함수들을 선언했을 경우 true를, 오류가 발생했을 경우 false를 반환합니다.
+	 */
+	bool Assembler::preprocess()
 	{
+		CurrentGuard_ guard(this);
+
 		try
 		{
+			TimeTrace::Scope scope(time_trace_, "Assembler::preprocess");
 			ast_.node_->preprocess();
-			ast_.node_->code_gen();
+			return true;
+		}
+		catch (Error& error)
+		{
+			errors_.add_error(error);
+			return false;
+		}
+	}
+	/**
+	 * @brief 코드를 만들기 전에 추상 구문 트리의 모든 함수를 FlatAST로 선언합니다.
+	 * @details 트리를 순회하지 않고 배열을 훑는다는 점만 다르며, 함수를 선언하는 순서는 preprocess()와 같습니다.
+	 * @param flat_ast 이 인스턴스의 추상 구문 트리를 변환한 FlatAST입니다.
+	 * @return 함수들을 선언했을 경우 true를, 오류가 발생했을 경우 false를 반환합니다.
+	 */
+	bool Assembler::preprocess(FlatAST& flat_ast)
+	{
+		CurrentGuard_ guard(this);
 
+		try
+		{
+			TimeTrace::Scope scope(time_trace_, "Assembler::preprocess");
+			flat_ast.preprocess();
 			return true;
 		}
 		catch (Error& error)
@@ -60,6 +126,118 @@ namespace Dlink
 			return false;
 		}
 	}
+	/**
+	 * @brief 추상 구문 트리로 LLVM IR 코드를 작업 스레드들에서 나눠서 만듭니다.
+	 * @details 모든 함수를 선언한 뒤 최상위 함수들을 작업 스레드 개수만큼의 묶음으로 나눕니다. 각 묶음은 자신만의 LLVMContext와 모듈을 가진 Assembler가 코드를 만들고 비트코드로 직렬화하며, 모든 묶음이 끝나면 묶음 순서대로 이 인스턴스의 모듈에 링크합니다.
+	 * 따라서 함수들의 순서와 경고의 순서는 to_llvm_ir()와 같습니다. 함수 단위 단순화는 각 묶음에서 실행하고, 인라이닝 등 모듈 전체 최적화는 링크한 뒤 한 번 실행합니다.
+	 * 최적화하지 않거나, 최상위 문 중 함수 선언이 아닌 것이 있거나, 함수가 parallel_threshold보다 적거나, 작업 스레드가 하나뿐이라면 to_llvm_ir() 함수를 호출합니다.
+	 * @param thread_pool 코드를 만들 작업 스레드 풀입니다.
+	 * @return LLVM IR 코드를 만들었을 경우 true를, 오류가 발생했을 경우 false를 반환합니다.
+	 */
+	bool Assembler::to_llvm_ir(ThreadPool& thread_pool)
+	{
+		Block* block = ast_.node_ ? dyn_cast<Block>(ast_.node_) : nullptr;
+		// 최적화하지 않으면 코드를 만드는 것보다 비트코드로 직렬화하고 링크하는 것이 더 오래 걸립니다.
+		if (!block || options_.opt_level == 0 || block->statements.size() < parallel_threshold || thread_pool.size() <= 1 ||
+			!std::all_of(block->statements.begin(), block->statements.end(), [](StatementPtr statement)
+			{
+				return isa<FunctionDeclaration>(statement);
+			}))
+		{
+			return to_llvm_ir();
+		}
+
+		CurrentGuard_ guard(this);
+
+		if (!preprocess())
+			return false;
+
+		const std::size_t count = block->statements.size();
+		const std::size_t chunk_count = std::min(thread_pool.size(), count);
+		const std::vector<FunctionDeclaration*>& declarations = state_.declarations;
+
+		// 각 묶음의 Assembler는 함수 단위 단순화만 실행하므로, 모듈 파이프라인이 없는 Optimizer를 줍니다.
+		std::vector<std::unique_ptr<Assembler>> workers(chunk_count);
+		std::vector<std::future<bool>> results;
+		for (std::size_t i = 0; i < chunk_count; ++i)
+		{
+			const std::size_t begin = count * i / chunk_count;
+			const std::size_t end = count * (i + 1) / chunk_count;
+
+			results.push_back(thread_pool.submit([this, &workers, &declarations, i, begin, end]()
+			{
+				workers[i] = std::make_unique<Assembler>(ast_, options_, std::make_shared<Optimizer>(options_, true), time_trace_);
+				return workers[i]->lower_functions_(declarations, begin, end);
+			}));
+		}
+
+		// 작업이 workers를 참조하므로, 예외가 발생하더라도 모든 작업이 끝난 뒤에 결과를 가져옵니다.
+		{
+			TimeTrace::Scope scope(time_trace_, "Assembler::code_gen");
+			for (std::future<bool>& result : results)
+			{
+				result.wait();
+			}
+		}
+
+		for (std::size_t i = 0; i < chunk_count; ++i)
+		{
+			const bool is_succeed = results[i].get();
+
+			for (const Warning& warning : workers[i]->warnings_.get_warnings())
+			{
+				warnings_.add_warning(warning);
+			}
+
+			if (!is_succeed)
+			{
+				errors_.add_error(workers[i]->errors_.get_errors()[0]);
+				return false;
+			}
+		}
+
+		// 링커는 함수 정의를 처음 참조된 순서대로 옮기므로, 링크한 뒤 선언된 순서로 되돌리기 위해 이름을 기억해 둡니다.
+		std::vector<std::string> names;
+		for (FunctionDeclaration* declaration : declarations)
+		{
+			names.push_back(state_.functions[declaration]->getName().str());
+		}
+
+		{
+			TimeTrace::Scope scope(time_trace_, "Assembler::link");
+			for (std::unique_ptr<Assembler>& worker : workers)
+			{
+				llvm::Expected<std::unique_ptr<llvm::Module>> module =
+					llvm::parseBitcodeFile(llvm::MemoryBufferRef(worker->bitcode_, "chunk"), builder_.context);
+
+				if (!module)
+				{
+					llvm::consumeError(module.takeError());
+					errors_.add_error(Error(block->token, "Failed to read generated code"));
+					return false;
+				}
+				if (llvm::Linker::linkModules(*builder_.module, std::move(module.get())))
+				{
+					errors_.add_error(Error(block->token, "Failed to link generated code"));
+					return false;
+				}
+
+				worker.reset();
+			}
+
+			for (std::size_t i = 0; i < declarations.size(); ++i)
+			{
+				llvm::Function* function = builder_.module->getFunction(names[i]);
+				state_.functions[declarations[i]] = function;
+
+				function->removeFromParent();
+				builder_.module->getFunctionList().push_back(function);
+			}
+		}
+
+		builder_.optimizer->optimize_module(*builder_.module);
+		return true;
+	}
 	Assembler::LLVMBuilder& Assembler::get_llvm_builder() noexcept
 	{
 		return builder_;
@@ -68,6 +246,18 @@ namespace Dlink
 	{
 		return builder_;
 	}
+	Assembler::CodeGenState& Assembler::get_code_gen_state() noexcept
+	{
+		return state_;
+	}
+	const CompileOptions& Assembler::get_options() const noexcept
+	{
+		return options_;
+	}
+	TimeTrace* Assembler::get_time_trace() const noexcept
+	{
+		return time_trace_;
+	}
 	const Errors& Assembler::get_errors() const noexcept
 	{
 		return errors_;
@@ -81,5 +271,56 @@ namespace Dlink
 		return warnings_;
 	}
 
-	std::map<std::thread::id, Assembler*> Assembler::assemblers = {};
+	bool Assembler::lower_functions_(const std::vector<FunctionDeclaration*>& declarations, std::size_t begin, std::size_t end)
+	{
+		CurrentGuard_ guard(this);
+
+		try
+		{
+			// 다른 묶음의 함수도 호출할 수 있도록 모든 함수를 이 모듈에 선언합니다.
+			for (FunctionDeclaration* declaration : declarations)
+			{
+				declaration->preprocess_node();
+			}
+
+			const std::vector<StatementPtr>& statements = cast<Block>(ast_.node_)->statements;
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				statements[i]->code_gen();
+			}
+
+			llvm::raw_string_ostream stream(bitcode_);
+			llvm::WriteBitcodeToFile(*builder_.module, stream);
+			stream.flush();
+
+			return true;
+		}
+		catch (Error& error)
+		{
+			errors_.add_error(error);
+			return false;
+		}
+	}
+
+	Assembler::CurrentGuard_::CurrentGuard_(Assembler* assembler) noexcept
+		: previous(current_)
+	{
+		current_ = assembler;
+	}
+	Assembler::CurrentGuard_::~CurrentGuard_()
+	{
+		current_ = previous;
+	}
+
+	/**
+	 * @brief 현재 스레드에서 LLVM IR 코드를 만들고 있는 인스턴스를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return to_llvm_ir를 실행 중인 인스턴스를, 없다면 nullptr을 반환합니다.
+	 */
+	Assembler* Assembler::current() noexcept
+	{
+		return current_;
+	}
+
+	thread_local Assembler* Assembler::current_ = nullptr;
 }
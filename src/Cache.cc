@@ -0,0 +1,207 @@
+#include "Cache.hh"
+#include "Target.hh"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/Chrono.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/raw_ostream.h"
+
+namespace Dlink
+{
+	namespace
+	{
+		// 캐시 항목의 형식을 바꾸면 이 값을 올려야 합니다. 만드는 코드가 달라지는 변경은 compiler_digest가 구분하지만,
+		// 실행 파일을 읽지 못하면 이 값만으로 구분하므로 코드 생성이나 최적화를 바꿀 때에도 올리는 것이 안전합니다.
+		constexpr char cache_version[] = "Dlink cache 2";
+
+		void append_field(std::string& material, llvm::StringRef field)
+		{
+			material += std::to_string(field.size());
+			material += ':';
+			material += field.str();
+		}
+		std::string hash(llvm::StringRef material)
+		{
+			return llvm::toHex(llvm::SHA1::hash(llvm::arrayRefFromStringRef(material)), true);
+		}
+		// 실행 중인 컴파일러 실행 파일의 요약값입니다. 컴파일러를 다시 빌드하면 달라지므로, 이전 빌드가 만든 캐시 항목을 사용하지 않습니다.
+		// 실행 파일을 읽지 못하면 빈 문자열을 반환합니다. 프로세스마다 한 번만 계산합니다.
+		const std::string& compiler_digest()
+		{
+			static const std::string digest = []()
+			{
+				static int main_address;
+				const std::string path = llvm::sys::fs::getMainExecutable(nullptr, &main_address);
+				if (path.empty())
+					return std::string();
+
+				llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(path);
+				if (!buffer)
+					return std::string();
+
+				return hash(buffer.get()->getBuffer());
+			}();
+			return digest;
+		}
+	}
+
+	/**
+	 * @brief 새 Cache 인스턴스를 만듭니다.
+	 * @details 소스 파일의 내용과 최적화 레벨, 대상 플랫폼의 트리플과 CPU, CPU의 기능들, 컴파일러 실행 파일과 LLVM의 버전으로 이 컴파일 작업의 요약값을 계산합니다. CPU가 native라면 대상 머신과 같이 현재 플랫폼의 CPU 이름과 그 CPU가 지원하는 기능들을 사용합니다.
+	 * @param options 컴파일 설정입니다. 캐시 디렉토리와 최대 크기를 사용합니다.
+	 * @param source 컴파일할 소스 파일입니다.
+	 */
+	Cache::Cache(const CompileOptions& options, const SourceFile& source)
+		: directory_(options.cache_directory), max_size_(options.cache_size)
+	{
+		std::string cpu;
+		std::string features;
+		get_target_cpu(options, cpu, features);
+
+		std::string material;
+		append_field(material, cache_version);
+		append_field(material, compiler_digest());
+		append_field(material, LLVM_VERSION_STRING);
+		append_field(material, llvm::StringRef(source.data(), source.size()));
+		append_field(material, std::to_string(options.opt_level));
+		append_field(material, get_target_triple(options));
+		append_field(material, cpu);
+		append_field(material, features);
+
+		digest_ = hash(material);
+	}
+
+	/**
+	 * @brief 캐시 항목을 불러옵니다.
+	 * @details 항목을 찾으면 마지막으로 사용한 시간을 지금으로 바꾸므로, 최근에 사용한 항목은 늦게 지워집니다.
+	 * @param kind 항목의 종류입니다. 같은 컴파일 작업의 서로 다른 결과물을 구분합니다.
+	 * @param data 불러온 항목을 저장할 문자열입니다.
+	 * @return 항목을 불러왔을 경우 true를, 항목이 없거나 읽지 못했을 경우 false를 반환합니다.
+	 */
+	bool Cache::load(const std::string& kind, std::string& data)
+	{
+		const std::string path = path_(kind);
+
+		int fd = -1;
+		if (llvm::sys::fs::openFileForRead(path, fd))
+			return false;
+
+		llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+			llvm::MemoryBuffer::getOpenFile(llvm::sys::fs::convertFDToNativeFile(fd), path, -1, false);
+		if (buffer)
+		{
+			data = buffer.get()->getBuffer().str();
+
+			const llvm::sys::TimePoint<> now = std::chrono::system_clock::now();
+			llvm::sys::fs::setLastAccessAndModificationTime(fd, now, now);
+		}
+
+		llvm::sys::fs::file_t file = llvm::sys::fs::convertFDToNativeFile(fd);
+		llvm::sys::fs::closeFile(file);
+		return static_cast<bool>(buffer);
+	}
+	/**
+	 * @brief 캐시 항목을 저장합니다.
+	 * @details 캐시 디렉토리가 없으면 만듭니다. 저장한 뒤 마지막으로 디렉토리를 정리한 지 prune_interval_초가 지났다면, 디렉토리의 크기가 최대 크기 이하가 될 때까지 가장 오래 사용하지 않은 항목부터 지웁니다.
+	 * @param kind 항목의 종류입니다.
+	 * @param data 저장할 항목입니다.
+	 * @return 항목을 저장했을 경우 true를, 실패했을 경우 false를 반환합니다.
+	 */
+	bool Cache::store(const std::string& kind, llvm::StringRef data)
+	{
+		if (llvm::sys::fs::create_directories(directory_))
+			return false;
+
+		llvm::SmallString<128> model(directory_);
+		llvm::sys::path::append(model, "tmp-%%%%%%%%%%%%");
+
+		llvm::Expected<llvm::sys::fs::TempFile> file = llvm::sys::fs::TempFile::create(model);
+		if (!file)
+		{
+			llvm::consumeError(file.takeError());
+			return false;
+		}
+
+		{
+			llvm::raw_fd_ostream stream(file->FD, false);
+			stream << data;
+			stream.flush();
+
+			if (stream.has_error())
+			{
+				stream.clear_error();
+				llvm::consumeError(file->discard());
+				return false;
+			}
+		}
+
+		// 이름을 바꾸는 것은 원자적이므로, 다른 프로세스는 이전 항목이나 완성된 새 항목 중 하나만 읽습니다.
+		if (llvm::Error error = file->keep(path_(kind)))
+		{
+			llvm::consumeError(std::move(error));
+			llvm::consumeError(file->discard());
+			return false;
+		}
+
+		llvm::CachePruningPolicy policy;
+		policy.Interval = std::chrono::seconds(prune_interval_);
+		policy.Expiration = std::chrono::seconds(0);
+		policy.MaxSizeBytes = max_size_;
+		llvm::pruneCache(directory_, policy);
+
+		return true;
+	}
+
+	std::string Cache::path_(const std::string& kind) const
+	{
+		// pruneCache 함수는 이름이 llvmcache-로 시작하는 파일만 지웁니다.
+		llvm::SmallString<128> path(directory_);
+		llvm::sys::path::append(path, "llvmcache-" + hash(digest_ + kind));
+		return path.str().str();
+	}
+
+	/**
+	 * @brief 새 JITCache 인스턴스를 만듭니다.
+	 * @param cache 목적 코드를 저장할 캐시입니다. 인스턴스를 사용하는 동안 살아있어야 합니다.
+	 * @param target JIT 컴파일러의 대상 플랫폼을 나타내는 문자열입니다. 키에 포함됩니다.
+	 */
+	JITCache::JITCache(Cache& cache, const std::string& target)
+		: cache_(cache), target_(target)
+	{}
+
+	/**
+	 * @brief JIT 컴파일러가 모듈을 컴파일했을 때 목적 코드를 캐시에 저장합니다.
+	 * @param module 컴파일한 모듈입니다.
+	 * @param object 컴파일한 목적 코드입니다.
+	 */
+	void JITCache::notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef object)
+	{
+		cache_.store("jit/" + target_ + "/" + module->getModuleIdentifier(), object.getBuffer());
+	}
+	/**
+	 * @brief 모듈을 컴파일한 목적 코드를 캐시에서 불러옵니다.
+	 * @param module 컴파일할 모듈입니다.
+	 * @return 캐시에 저장된 목적 코드를, 없다면 nullptr을 반환합니다.
+	 */
+	std::unique_ptr<llvm::MemoryBuffer> JITCache::getObject(const llvm::Module* module)
+	{
+		std::string object;
+		if (!cache_.load("jit/" + target_ + "/" + module->getModuleIdentifier(), object))
+			return nullptr;
+
+		return llvm::MemoryBuffer::getMemBufferCopy(object, module->getModuleIdentifier());
+	}
+}
@@ -21,50 +21,15 @@ namespace Dlink
 		{
 			return get_current_assembler().get_llvm_builder().builder;
 		}
-		std::unique_ptr<llvm::legacy::FunctionPassManager>& function_pm()
+		Optimizer& optimizer()
 		{
-			return get_current_assembler().get_llvm_builder().function_pm;
+			return *get_current_assembler().get_llvm_builder().optimizer;
 		}
 	}
 
 	Assembler& get_current_assembler()
 	{
-		return *Assembler::assemblers[std::this_thread::get_id()];
-	}
-
-	/**
-	 * @brief 현재 심볼 테이블과 상위 심볼 테이블에서 심볼을 찾습니다.
-	 * @param name 찾을 심볼입니다.
-	 * @return 심볼을 찾지 못하면 nullptr을 저장하는 LLVM::Value 객체를, 찾으면 해당 심볼의 LLVM Value를 저장하는 LLVM::Value 객체를 반환합니다.
-	 */
-	LLVM::Value SymbolTable::find(const std::string& name)
-	{
-		auto find_val = map.find(name);
-
-		if (find_val != map.end())
-		{
-			return find_val->second;
-		}
-		else
-		{
-			return parent == nullptr ? nullptr : parent->find(name);
-		}
-	}
-	/**
-	 * @brief 현재 심볼 테이블과 상위 심볼 테이블에서 심볼을 찾습니다.
-	 * @param name 찾을 심볼입니다.
-	 * @return 심볼을 찾지 못하면 false를, 찾으면 true를 반환합니다.
-	 */
-	bool SymbolTable::find_bool(const std::string& name) const
-	{
-		if (map.find(name) != map.end())
-		{
-			return true;
-		}
-		else
-		{
-			return parent == nullptr ? false : parent->find(name);
-		}
+		return *Assembler::current();
 	}
 
 	/**
@@ -102,13 +67,28 @@ namespace Dlink
 		}
 	}
 
-	/** 현재 변수 및 상수 심볼 테이블입니다. */
-	SymbolTablePtr symbol_table = std::make_shared<SymbolTable>();
-	/** 현재 사용자 정의 타입 심볼 테이블입니다. */
-	TypeSymbolTablePtr type_symbol_table = std::make_shared<TypeSymbolTable>();
-
-	/** 현재 code_gen 중인 함수입니다. */
-	std::shared_ptr<FunctionDeclaration> current_func = nullptr;
-	/** 지금 안전하지 않은 블록 안에 있는지 여부입니다. */
-	bool in_unsafe_block = false;
+	/**
+	 * @brief 현재 사용자 정의 타입 심볼 테이블을 가져옵니다.
+	 * @return 현재 스레드에서 LLVM IR 코드를 만들고 있는 Assembler의 타입 심볼 테이블을 반환합니다.
+	 */
+	TypeSymbolTablePtr& type_symbol_table()
+	{
+		return get_current_assembler().get_code_gen_state().type_symbol_table;
+	}
+	/**
+	 * @brief 현재 code_gen 중인 함수를 가져옵니다.
+	 * @return 현재 스레드에서 LLVM IR 코드를 만들고 있는 Assembler가 code_gen 중인 함수를 반환합니다.
+	 */
+	FunctionDeclaration*& current_func()
+	{
+		return get_current_assembler().get_code_gen_state().current_func;
+	}
+	/**
+	 * @brief 지금 안전하지 않은 블록 안에 있는지 여부를 가져옵니다.
+	 * @return 현재 스레드에서 LLVM IR 코드를 만들고 있는 Assembler의 안전하지 않은 블록 여부를 반환합니다.
+	 */
+	bool& in_unsafe_block()
+	{
+		return get_current_assembler().get_code_gen_state().in_unsafe_block;
+	}
 }
@@ -2,6 +2,8 @@
 
 #include <string>
 
+#include "ASTDumper.hh"
+
 namespace Dlink
 {
 	/**
@@ -37,6 +39,14 @@ namespace Dlink
 	ParsedCommandLine::ParsedCommandLine(Type type, std::uintptr_t x, std::uintptr_t y, std::uintptr_t z)
 		: type(type), x(x), y(y), z(z)
 	{}
+	/**
+	 * @brief 문자열 값이 있는 ParsedCommandLine 인스턴스를 만듭니다.
+	 * @param type ParsedCommandLine의 타입입니다.
+	 * @param str 문자열 값입니다.
+	 */
+	ParsedCommandLine::ParsedCommandLine(Type type, const std::string& str)
+		: type(type), x(0), y(0), z(0), str(str)
+	{}
 
 	/**
 	 * @brief 두 ParsedCommandLine 인스턴스가 같은지 비교합니다.
@@ -46,7 +56,7 @@ namespace Dlink
 	bool ParsedCommandLine::operator==(const ParsedCommandLine& parsed_command_line) const noexcept
 	{
 		return type == parsed_command_line.type &&
-			x == parsed_command_line.x && y == parsed_command_line.y && z == parsed_command_line.z;
+			x == parsed_command_line.x && y == parsed_command_line.y && z == parsed_command_line.z && str == parsed_command_line.str;
 	}
 	/**
 	 * @brief 두 ParsedCommandLine 인스턴스가 다른지 비교합니다.
@@ -56,7 +66,7 @@ namespace Dlink
 	bool ParsedCommandLine::operator!=(const ParsedCommandLine& parsed_command_line) const noexcept
 	{
 		return type != parsed_command_line.type ||
-			x != parsed_command_line.x || y != parsed_command_line.y || z != parsed_command_line.z;
+			x != parsed_command_line.x || y != parsed_command_line.y || z != parsed_command_line.z || str != parsed_command_line.str;
 	}
 
 	/**
@@ -78,17 +88,78 @@ namespace Dlink
 			{
 				result.push_back(ParsedCommandLine(ParsedCommandLine::IR));
 			}
+			else if (cmdline == "/Server")
+			{
+				result.push_back(ParsedCommandLine(ParsedCommandLine::Server));
+			}
+			else if (cmdline == "/TimeTrace")
+			{
+				result.push_back(ParsedCommandLine(ParsedCommandLine::TimeTrace));
+			}
+			else if (cmdline == "/SplitObj")
+			{
+				result.push_back(ParsedCommandLine(ParsedCommandLine::SplitObject));
+			}
+			else if (cmdline == "/Run")
+			{
+				result.push_back(ParsedCommandLine(ParsedCommandLine::Run));
+			}
+			else if (cmdline.substr(0, 5) == "/Obj:")
+			{
+				result.push_back(ParsedCommandLine(ParsedCommandLine::Object, cmdline.substr(5)));
+			}
+			else if (cmdline.substr(0, 5) == "/Asm:")
+			{
+				result.push_back(ParsedCommandLine(ParsedCommandLine::Assembly, cmdline.substr(5)));
+			}
+			else if (cmdline.substr(0, 4) == "/BC:")
+			{
+				result.push_back(ParsedCommandLine(ParsedCommandLine::Bitcode, cmdline.substr(4)));
+			}
+			else if (cmdline.substr(0, 8) == "/Target:")
+			{
+				result.push_back(ParsedCommandLine(ParsedCommandLine::Target, cmdline.substr(8)));
+			}
+			else if (cmdline.substr(0, 11) == "/CacheSize:")
+			{
+				long long size = std::stoll(cmdline.substr(11));
+				result.push_back(ParsedCommandLine(ParsedCommandLine::CacheSize, size));
+			}
+			else if (cmdline.substr(0, 7) == "/Cache:")
+			{
+				result.push_back(ParsedCommandLine(ParsedCommandLine::Cache, cmdline.substr(7)));
+			}
+			else if (cmdline.substr(0, 5) == "/CPU:")
+			{
+				result.push_back(ParsedCommandLine(ParsedCommandLine::CPU, cmdline.substr(5)));
+			}
 			else if (cmdline.substr(0, 2) == "/O")
 			{
 				long long level = std::stoll(cmdline.substr(2));
 				result.push_back(ParsedCommandLine(ParsedCommandLine::Optimize, level));
 			}
+			else if (cmdline.substr(0, 2) == "/J")
+			{
+				long long jobs = std::stoll(cmdline.substr(2));
+				result.push_back(ParsedCommandLine(ParsedCommandLine::Jobs, jobs));
+			}
+			else if (cmdline.substr(0, 5) == "/AST:")
+			{
+				std::string format = cmdline.substr(5);
+				std::uintptr_t x = static_cast<std::uintptr_t>(-1);
+
+				if (format == "none") x = static_cast<std::uintptr_t>(ASTDumpFormat::None);
+				else if (format == "tree") x = static_cast<std::uintptr_t>(ASTDumpFormat::Tree);
+				else if (format == "json") x = static_cast<std::uintptr_t>(ASTDumpFormat::JSON);
+
+				result.push_back(ParsedCommandLine(ParsedCommandLine::AST, x));
+			}
 
 			else if (cmdline[0] == '/')
 				throw std::make_pair(ParsedCommandLine::Unknown, cmdline);
 			else
 			{
-				result.push_back(ParsedCommandLine(ParsedCommandLine::Input, reinterpret_cast<std::uintptr_t>(new std::string(cmdline))));
+				result.push_back(ParsedCommandLine(ParsedCommandLine::Input, cmdline));
 			}
 		}
 
@@ -103,7 +174,22 @@ namespace Dlink
 	{
 		bool have_I = false;
 		bool have_O = false;
+		bool have_J = false;
+		bool have_A = false;
+		bool have_Obj = false;
+		bool have_Asm = false;
+		bool have_BC = false;
+		bool have_Target = false;
+		bool have_CPU = false;
+		bool have_Run = false;
+		bool have_Cache = false;
+		bool have_CacheSize = false;
+		bool have_Server = false;
+		bool have_TimeTrace = false;
+		bool have_SplitObj = false;
 		bool have_i = false;
+		bool have_multi_i = false;
+		std::size_t multi_i_index = 0;
 
 		std::size_t index = 0;
 		for (const auto& cmdline : parsed_command_line)
@@ -123,6 +209,58 @@ namespace Dlink
 				break;
 			}
 
+			case ParsedCommandLine::Server:
+			{
+				if (!have_Server)
+				{
+					have_Server = true;
+				}
+				else
+				{
+					return std::make_pair(ParsedCommandLine::Multi_Server, index);
+				}
+				break;
+			}
+
+			case ParsedCommandLine::TimeTrace:
+			{
+				if (!have_TimeTrace)
+				{
+					have_TimeTrace = true;
+				}
+				else
+				{
+					return std::make_pair(ParsedCommandLine::Multi_TimeTrace, index);
+				}
+				break;
+			}
+
+			case ParsedCommandLine::SplitObject:
+			{
+				if (!have_SplitObj)
+				{
+					have_SplitObj = true;
+				}
+				else
+				{
+					return std::make_pair(ParsedCommandLine::Multi_SplitObject, index);
+				}
+				break;
+			}
+
+			case ParsedCommandLine::Run:
+			{
+				if (!have_Run)
+				{
+					have_Run = true;
+				}
+				else
+				{
+					return std::make_pair(ParsedCommandLine::Multi_Run, index);
+				}
+				break;
+			}
+
 			case ParsedCommandLine::Optimize:
 			{
 				if (!have_O)
@@ -140,20 +278,187 @@ namespace Dlink
 				break;
 			}
 
+			case ParsedCommandLine::Jobs:
+			{
+				if (!have_J)
+				{
+					have_J = true;
+					// 작업 스레드를 만들지 못하면 컴파일러가 중단되므로, 지나치게 많은 작업 스레드는 만들기 전에 거부합니다.
+					if (static_cast<long long>(cmdline.x) < 0 || static_cast<long long>(cmdline.x) > 1024)
+					{
+						return std::make_pair(ParsedCommandLine::Invalid_Value, index);
+					}
+				}
+				else
+				{
+					return std::make_pair(ParsedCommandLine::Multi_Jobs, index);
+				}
+				break;
+			}
+
+			case ParsedCommandLine::AST:
+			{
+				if (!have_A)
+				{
+					have_A = true;
+					if (cmdline.x == static_cast<std::uintptr_t>(-1))
+					{
+						return std::make_pair(ParsedCommandLine::Invalid_Value, index);
+					}
+				}
+				else
+				{
+					return std::make_pair(ParsedCommandLine::Multi_AST, index);
+				}
+				break;
+			}
+
+			case ParsedCommandLine::Object:
+			{
+				if (!have_Obj)
+				{
+					have_Obj = true;
+					if (cmdline.str.empty())
+					{
+						return std::make_pair(ParsedCommandLine::Invalid_Value, index);
+					}
+				}
+				else
+				{
+					return std::make_pair(ParsedCommandLine::Multi_Object, index);
+				}
+				break;
+			}
+
+			case ParsedCommandLine::Assembly:
+			{
+				if (!have_Asm)
+				{
+					have_Asm = true;
+					if (cmdline.str.empty())
+					{
+						return std::make_pair(ParsedCommandLine::Invalid_Value, index);
+					}
+				}
+				else
+				{
+					return std::make_pair(ParsedCommandLine::Multi_Assembly, index);
+				}
+				break;
+			}
+
+			case ParsedCommandLine::Bitcode:
+			{
+				if (!have_BC)
+				{
+					have_BC = true;
+					if (cmdline.str.empty())
+					{
+						return std::make_pair(ParsedCommandLine::Invalid_Value, index);
+					}
+				}
+				else
+				{
+					return std::make_pair(ParsedCommandLine::Multi_Bitcode, index);
+				}
+				break;
+			}
+
+			case ParsedCommandLine::Target:
+			{
+				if (!have_Target)
+				{
+					have_Target = true;
+					if (cmdline.str.empty())
+					{
+						return std::make_pair(ParsedCommandLine::Invalid_Value, index);
+					}
+				}
+				else
+				{
+					return std::make_pair(ParsedCommandLine::Multi_Target, index);
+				}
+				break;
+			}
+
+			case ParsedCommandLine::CPU:
+			{
+				if (!have_CPU)
+				{
+					have_CPU = true;
+					if (cmdline.str.empty())
+					{
+						return std::make_pair(ParsedCommandLine::Invalid_Value, index);
+					}
+				}
+				else
+				{
+					return std::make_pair(ParsedCommandLine::Multi_CPU, index);
+				}
+				break;
+			}
+
+			case ParsedCommandLine::Cache:
+			{
+				if (!have_Cache)
+				{
+					have_Cache = true;
+					if (cmdline.str.empty())
+					{
+						return std::make_pair(ParsedCommandLine::Invalid_Value, index);
+					}
+				}
+				else
+				{
+					return std::make_pair(ParsedCommandLine::Multi_Cache, index);
+				}
+				break;
+			}
+
+			case ParsedCommandLine::CacheSize:
+			{
+				if (!have_CacheSize)
+				{
+					have_CacheSize = true;
+					if (static_cast<long long>(cmdline.x) < 0)
+					{
+						return std::make_pair(ParsedCommandLine::Invalid_Value, index);
+					}
+				}
+				else
+				{
+					return std::make_pair(ParsedCommandLine::Multi_CacheSize, index);
+				}
+				break;
+			}
+
 			case ParsedCommandLine::Input:
 			{
+				// JIT 컴파일해 실행할 수 있는 main 함수는 하나뿐이므로, 두번째 소스 파일의 위치를 기억해 둡니다.
+				if (have_i && !have_multi_i)
+				{
+					have_multi_i = true;
+					multi_i_index = index;
+				}
 				have_i = true;
 			}
 
 			default:
 				break;
 			}
+
+			++index;
 		}
 
-		if (!have_i)
+		// 서버 모드에서는 요청마다 소스 파일을 받습니다.
+		if (!have_i && !have_Server)
 		{
 			return std::make_pair(ParsedCommandLine::CouldntFind_Input, -1);
 		}
+		if (have_Run && have_multi_i)
+		{
+			return std::make_pair(ParsedCommandLine::Multi_Input, multi_i_index);
+		}
 		return std::make_pair(ParsedCommandLine::Done, -1);
 	}
 }
@@ -0,0 +1,796 @@
+#include "Driver.hh"
+#include "Cache.hh"
+#include "CodeGen.hh"
+#include "Emitter.hh"
+#include "Executor.hh"
+#include "Target.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "llvm/Support/raw_os_ostream.h"
+
+namespace Dlink
+{
+	namespace
+	{
+		template<typename Message_>
+		void print_message(std::ostream& stream, const SourceManager& source_manager, const char* kind, const Message_& message)
+		{
+			SourceLocation location = source_manager.location(message.message_token());
+			stream << kind << " at ";
+			stream << "Line " << location.line;
+			stream << " Col " << location.col;
+
+			stream << " " << message.what() << '\n';
+		}
+		void print_object_paths(std::ostream& stream, const std::vector<std::string>& object_paths)
+		{
+			// 모듈을 나눠 목적 파일을 여러개 만들었다면, 모두 링커에 전달해야 하므로 경로를 알려줍니다.
+			if (object_paths.size() <= 1)
+				return;
+
+			stream << "Object files:";
+			for (const std::string& path : object_paths)
+			{
+				stream << ' ' << path;
+			}
+			stream << '\n';
+		}
+		/**
+		 * @brief 두 출력 스트림에 쓰는 내용을 그대로 전달하면서, 어느 스트림에 썼는지와 함께 쓴 순서대로 기록합니다.
+		 * @details 캐시에서 결과를 불러올 때, 컴파일하며 출력했던 진단과 덤프를 같은 순서로 다시 출력하기 위해 사용합니다. 이 클래스는 다른 곳에서 상속받을 수 없습니다.
+		 */
+		class Transcript final
+		{
+		public:
+			Transcript(std::ostream& out, std::ostream& err)
+				: out_buffer_(*this, out, 'o'), err_buffer_(*this, err, 'e'), out_(&out_buffer_), err_(&err_buffer_)
+			{}
+			Transcript(const Transcript& transcript) = delete;
+			Transcript(Transcript&& transcript) noexcept = delete;
+			~Transcript() = default;
+
+		public:
+			Transcript& operator=(const Transcript& transcript) = delete;
+			Transcript& operator=(Transcript&& transcript) noexcept = delete;
+			bool operator==(const Transcript& transcript) const noexcept = delete;
+			bool operator!=(const Transcript& transcript) const noexcept = delete;
+
+		public:
+			std::ostream& out() noexcept
+			{
+				return out_;
+			}
+			std::ostream& err() noexcept
+			{
+				return err_;
+			}
+			// 기록은 "<스트림><크기>\n<내용>"을 쓴 순서대로 이어 붙여 저장합니다. 스트림은 out이면 'o', err이면 'e'입니다.
+			std::string str() const
+			{
+				std::string result;
+				for (const std::pair<char, std::string>& chunk : chunks_)
+				{
+					result += chunk.first;
+					result += std::to_string(chunk.second.size());
+					result += '\n';
+					result += chunk.second;
+				}
+				return result;
+			}
+			static bool replay(const std::string& data, std::ostream& out, std::ostream& err)
+			{
+				std::vector<std::pair<std::ostream*, std::pair<std::size_t, std::size_t>>> chunks;
+
+				std::size_t offset = 0;
+				while (offset < data.size())
+				{
+					std::ostream* stream = data[offset] == 'o' ? &out : data[offset] == 'e' ? &err : nullptr;
+					const std::size_t newline = data.find('\n', offset);
+					if (!stream || newline == std::string::npos || newline == offset + 1)
+						return false;
+
+					std::size_t size = 0;
+					for (std::size_t i = offset + 1; i < newline; ++i)
+					{
+						if (data[i] < '0' || data[i] > '9')
+							return false;
+
+						size = size * 10 + static_cast<std::size_t>(data[i] - '0');
+					}
+
+					offset = newline + 1;
+					if (size > data.size() - offset)
+						return false;
+
+					chunks.emplace_back(stream, std::make_pair(offset, size));
+					offset += size;
+				}
+
+				// 기록이 온전한지 모두 확인한 뒤에 출력하므로, 손상된 기록은 아무것도 출력하지 않습니다.
+				for (const auto& chunk : chunks)
+				{
+					chunk.first->write(data.data() + chunk.second.first, static_cast<std::streamsize>(chunk.second.second));
+				}
+				return true;
+			}
+
+		private:
+			class Buffer_ final : public std::streambuf
+			{
+			public:
+				Buffer_(Transcript& transcript, std::ostream& target, char stream)
+					: transcript_(transcript), target_(target), stream_(stream)
+				{}
+
+			protected:
+				int_type overflow(int_type c) override
+				{
+					if (traits_type::eq_int_type(c, traits_type::eof()))
+						return traits_type::not_eof(c);
+
+					const char data = traits_type::to_char_type(c);
+					xsputn(&data, 1);
+					return c;
+				}
+				std::streamsize xsputn(const char* data, std::streamsize size) override
+				{
+					target_.write(data, size);
+					transcript_.append_(stream_, data, static_cast<std::size_t>(size));
+					return size;
+				}
+				int sync() override
+				{
+					target_.flush();
+					return target_ ? 0 : -1;
+				}
+
+			private:
+				Transcript& transcript_;
+				std::ostream& target_;
+				char stream_;
+			};
+
+		private:
+			void append_(char stream, const char* data, std::size_t size)
+			{
+				if (chunks_.empty() || chunks_.back().first != stream)
+				{
+					chunks_.emplace_back(stream, std::string());
+				}
+				chunks_.back().second.append(data, size);
+			}
+
+		private:
+			std::vector<std::pair<char, std::string>> chunks_;
+			Buffer_ out_buffer_;
+			Buffer_ err_buffer_;
+			std::ostream out_;
+			std::ostream err_;
+		};
+
+		const char* command_line_error_message(ParsedCommandLine::Error error)
+		{
+			switch (error)
+			{
+			case ParsedCommandLine::Error::Invalid_Value:
+				return "fatal: invalid value\n";
+			case ParsedCommandLine::Error::CouldntFind_Input:
+				return "fatal: couldn't find input file\n";
+			case ParsedCommandLine::Error::Conflicting_Output:
+				return "fatal: multiple input files write to the same output file\n";
+			case ParsedCommandLine::Error::Multi_Optimize:
+				return "fatal: unexpected multiple optimization options\n";
+			case ParsedCommandLine::Error::Multi_Jobs:
+				return "fatal: unexpected multiple job count options\n";
+			case ParsedCommandLine::Error::Multi_AST:
+				return "fatal: unexpected multiple ast output options\n";
+			case ParsedCommandLine::Error::Multi_Object:
+				return "fatal: unexpected multiple object output options\n";
+			case ParsedCommandLine::Error::Multi_Assembly:
+				return "fatal: unexpected multiple assembly output options\n";
+			case ParsedCommandLine::Error::Multi_Bitcode:
+				return "fatal: unexpected multiple bitcode output options\n";
+			case ParsedCommandLine::Error::Multi_Target:
+				return "fatal: unexpected multiple target options\n";
+			case ParsedCommandLine::Error::Multi_CPU:
+				return "fatal: unexpected multiple cpu options\n";
+			case ParsedCommandLine::Error::Multi_Run:
+				return "fatal: unexpected multiple run options\n";
+			case ParsedCommandLine::Error::Multi_Cache:
+				return "fatal: unexpected multiple cache directory options\n";
+			case ParsedCommandLine::Error::Multi_CacheSize:
+				return "fatal: unexpected multiple cache size options\n";
+			case ParsedCommandLine::Error::Multi_Server:
+				return "fatal: unexpected multiple server options\n";
+			case ParsedCommandLine::Error::Server_Run:
+				return "fatal: run option is not supported in server requests\n";
+			case ParsedCommandLine::Error::Multi_Input:
+				return "fatal: unexpected multiple input files with run option\n";
+			case ParsedCommandLine::Error::Multi_TimeTrace:
+				return "fatal: unexpected multiple time trace options\n";
+			case ParsedCommandLine::Error::Multi_SplitObject:
+				return "fatal: unexpected multiple split object options\n";
+			case ParsedCommandLine::Error::Multi_IR:
+				return "fatal: unexpected multiple ir output options\n";
+			case ParsedCommandLine::Error::No_Input:
+				return "fatal: no input\n";
+			case ParsedCommandLine::Error::Unknown:
+				return "fatal: unknown option\n";
+
+			default:
+				return "fatal: unhandled error caught\n";
+			}
+		}
+	}
+
+	/**
+	 * @brief 명령줄을 처리해 컴파일 작업을 실행하거나 서버 모드로 실행합니다.
+	 * @param argc 명령줄의 개수입니다.
+	 * @param argv 명령줄 배열입니다.
+	 * @param in 서버 모드에서 요청을 읽을 스트림입니다.
+	 * @param out 컴파일 결과를 출력할 스트림입니다.
+	 * @param err 오류와 경고를 출력할 스트림입니다.
+	 * @return 프로세스의 종료 코드입니다. 명령줄에 오류가 있으면 -1을 반환합니다.
+	 */
+	int Driver::run(int argc, char** argv, std::istream& in, std::ostream& out, std::ostream& err)
+	{
+		ProcessedType command_line;
+
+		try
+		{
+			command_line = ProcessCommandLine(argc, argv);
+		}
+		catch (ParsedCommandLine::Error error)
+		{
+			err << command_line_error_message(error);
+			return -1;
+		}
+		catch (const std::pair<ParsedCommandLine::Error, std::string>& error)
+		{
+			err << command_line_error_message(error.first);
+			return -1;
+		}
+		catch (const std::logic_error&)
+		{
+			// 숫자가 필요한 명령의 설정 값이 숫자가 아니거나 너무 큽니다.
+			err << command_line_error_message(ParsedCommandLine::Error::Invalid_Value);
+			return -1;
+		}
+
+		if (command_line.is_server)
+		{
+			if (is_serving_)
+			{
+				err << command_line_error_message(ParsedCommandLine::Error::Multi_Server);
+				return -1;
+			}
+
+			get_thread_pool_(command_line.options.thread_count);
+			return serve(in, out);
+		}
+		if (is_serving_ && command_line.options.run)
+		{
+			// 실행한 프로그램의 출력은 응답 프로토콜을 깨뜨리고, 프로그램이 비정상적으로 종료되면 서버도 함께 종료되므로 거부합니다.
+			err << command_line_error_message(ParsedCommandLine::Error::Server_Run);
+			return -1;
+		}
+		return compile(command_line, out, err);
+	}
+	/**
+	 * @brief 표준 입력 프로토콜로 컴파일 요청을 받아 처리합니다.
+	 * @details 요청은 한 줄이며, 명령줄처럼 공백으로 구분한 인수들로 이루어집니다. 공백이 있는 인수는 큰따옴표로 감쌉니다. 빈 줄은 무시하며, 입력이 끝나면 서버를 종료합니다.
+	 * 응답은 "<종료 코드> <출력의 바이트 수> <진단의 바이트 수>" 한 줄과 그 뒤에 이어지는 출력과 진단입니다. 출력은 명령줄로 실행했을 때 표준 출력에, 진단은 표준 오류에 출력하는 내용입니다.
+	 * 요청 사이에 작업 스레드 풀과 최적화 파이프라인, 내용이 바뀌지 않은 파일의 추상 구문 트리를 다시 사용합니다. 프로그램을 서버 안에서 실행하게 되므로, /Run이 있는 요청은 오류로 응답합니다.
+	 * @param in 요청을 읽을 스트림입니다.
+	 * @param out 응답을 쓸 스트림입니다.
+	 * @return 프로세스의 종료 코드입니다.
+	 */
+	int Driver::serve(std::istream& in, std::ostream& out)
+	{
+		is_serving_ = true;
+
+		std::string line;
+		while (std::getline(in, line))
+		{
+			std::vector<std::string> arguments = split_arguments_(line);
+			if (arguments.empty())
+				continue;
+
+			arguments.insert(arguments.begin(), "dlink");
+
+			std::vector<char*> argv;
+			for (std::string& argument : arguments)
+			{
+				argv.push_back(&argument[0]);
+			}
+			argv.push_back(nullptr);
+
+			std::ostringstream request_out;
+			std::ostringstream request_err;
+			const int exit_code = run(static_cast<int>(arguments.size()), argv.data(), in, request_out, request_err);
+
+			const std::string output = request_out.str();
+			const std::string diagnostics = request_err.str();
+			out << exit_code << ' ' << output.size() << ' ' << diagnostics.size() << '\n';
+			out << output << diagnostics;
+			out.flush();
+		}
+
+		is_serving_ = false;
+		return 0;
+	}
+	/**
+	 * @brief 명령줄로 요청받은 소스 파일들을 컴파일합니다.
+	 * @details 소스 파일이 하나라면 작업 스레드 풀로 렉싱, 코드 생성, 목적 파일 생성을 나눠서 합니다.
+	 * 여러개라면 소스 파일마다 자신만의 Assembler로 작업 스레드 풀에서 동시에 컴파일하고, 각 소스 파일 안의 작업은 나누지 않습니다. 출력과 진단은 소스 파일마다 모아 두었다가 명령줄에 적은 순서대로 출력합니다.
+	 * @param command_line 처리한 명령줄입니다. 소스 파일들이 열려 있어야 합니다.
+	 * @param out 컴파일 결과를 출력할 스트림입니다.
+	 * @param err 오류와 경고를 출력할 스트림입니다.
+	 * @return 프로세스의 종료 코드입니다. 소스 파일이 하나라면 compile_ 함수의 반환 값을, 여러개라면 모두 성공했을 때 0을, 아니라면 1을 반환합니다.
+	 */
+	int Driver::compile(ProcessedCommandLine& command_line, std::ostream& out, std::ostream& err)
+	{
+		ThreadPool& thread_pool = get_thread_pool_(command_line.options.thread_count);
+
+		// 보관하는 소스 파일은 다음 요청까지 파일이 바뀌거나 잘릴 수 있으므로, 파싱하기 전에 내용을 복사해 매핑과 분리합니다.
+		if (is_serving_)
+		{
+			for (SourceFile& source : command_line.sources)
+			{
+				source.detach();
+			}
+		}
+
+		const std::size_t count = command_line.sources.size();
+		if (count == 1)
+		{
+			SourceFile& source = command_line.sources[0];
+			const CompileOptions& options = command_line.source_options[0];
+
+			std::unique_ptr<Unit_> new_unit;
+			const int exit_code = compile_(source, options, thread_pool, get_optimizer_(options), find_unit_(source), new_unit, out, err);
+
+			if (new_unit)
+			{
+				store_unit_(std::move(new_unit));
+			}
+			return exit_code;
+		}
+
+		// 동시에 컴파일하는 소스 파일 하나의 상태입니다.
+		struct Job
+		{
+			std::string path;
+			Unit_* unit = nullptr;
+			std::unique_ptr<Unit_> new_unit;
+			std::ostringstream out;
+			std::ostringstream err;
+		};
+
+		// 작업들이 보관된 파일을 찾거나 지우지 않도록, 시작하기 전에 모두 찾아 둡니다.
+		// 새로 파싱한 소스 파일은 작업이 끝나면 new_unit으로 이동하므로, 출력할 경로도 미리 복사해 둡니다.
+		std::vector<std::unique_ptr<Job>> jobs;
+		for (SourceFile& source : command_line.sources)
+		{
+			jobs.push_back(std::make_unique<Job>());
+			jobs.back()->path = source.path();
+			jobs.back()->unit = find_unit_(source);
+		}
+
+		// 작업 스레드에서 다시 작업을 제출하고 기다리면 교착 상태가 될 수 있으므로, 각 작업에는 작업을 나누지 않는 스레드 풀을 넘깁니다.
+		ThreadPool& serial_thread_pool = get_serial_thread_pool_();
+
+		std::vector<std::future<int>> results;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			Job* job = jobs[i].get();
+			SourceFile* source = &command_line.sources[i];
+			const CompileOptions* options = &command_line.source_options[i];
+
+			results.push_back(thread_pool.submit([this, job, source, options, &serial_thread_pool]()
+			{
+				// 최적화 파이프라인은 동시에 사용할 수 없으므로, 각 Assembler가 자신의 것을 만듭니다.
+				return compile_(*source, *options, serial_thread_pool, nullptr, job->unit, job->new_unit, job->out, job->err);
+			}));
+		}
+
+		// 작업이 jobs를 참조하므로, 예외가 발생하더라도 모든 작업이 끝난 뒤에 결과를 가져옵니다.
+		for (std::future<int>& result : results)
+		{
+			result.wait();
+		}
+
+		int exit_code = 0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			Job& job = *jobs[i];
+
+			int job_exit_code = 1;
+			try
+			{
+				job_exit_code = results[i].get();
+			}
+			catch (const std::exception& exception)
+			{
+				job.err << "Compilation Failed\n";
+				job.err << exception.what() << '\n';
+			}
+
+			out << "Compiling " << job.path << '\n';
+			out << job.out.str();
+			err << job.err.str();
+
+			if (job_exit_code != 0)
+			{
+				exit_code = 1;
+			}
+		}
+
+		for (std::unique_ptr<Job>& job : jobs)
+		{
+			if (job->new_unit)
+			{
+				store_unit_(std::move(job->new_unit));
+			}
+		}
+
+		return exit_code;
+	}
+
+	/**
+	 * @brief 소스 파일 하나를 컴파일합니다.
+	 * @details 컴파일 설정에 컴파일 시간을 기록할 경로가 있다면, 각 단계에 걸린 시간을 기록해 컴파일이 끝난 뒤 그 경로에 씁니다.
+	 * 캐시를 사용한다면 성공한 컴파일이 출력한 내용도 덤프 형식마다 캐시에 저장해 두고, 요청한 파일들을 캐시에서 불러올 때 그 내용을 그대로 다시 출력하므로, 경고와 덤프는 캐시를 사용하지 않을 때와 같습니다. 목적 파일들의 경로는 불러온 결과로 출력합니다.
+	 * 보관된 파일이 있다면 그때 만든 추상 구문 트리와 이름 결정 결과를 다시 사용하고, 없다면 새로 파싱해 new_unit에 넣습니다. 이 함수는 Driver의 상태를 바꾸지 않으므로, 서로 다른 소스 파일에 대해 동시에 호출할 수 있습니다.
+	 * @param source 컴파일할 소스 파일입니다. 새로 파싱하면 new_unit으로 이동합니다.
+	 * @param options 소스 파일의 컴파일 설정입니다.
+	 * @param thread_pool 작업을 나눠 맡을 스레드 풀입니다.
+	 * @param optimizer Assembler가 사용할 Optimizer 인스턴스입니다. nullptr이면 Assembler가 새로 만듭니다.
+	 * @param unit find_unit_ 함수로 찾은 보관된 파일입니다. 없다면 nullptr입니다.
+	 * @param new_unit 새로 파싱한 파일을 넣을 곳입니다.
+	 * @param out 컴파일 결과를 출력할 스트림입니다.
+	 * @param err 오류와 경고를 출력할 스트림입니다.
+	 * @return 성공했다면 0을, 실패했다면 1을 반환합니다. /Run으로 실행했다면 main 함수의 반환 값입니다.
+	 */
+	int Driver::compile_(SourceFile& source, const CompileOptions& options, ThreadPool& thread_pool, std::shared_ptr<Optimizer> optimizer,
+		Unit_* unit, std::unique_ptr<Unit_>& new_unit, std::ostream& out, std::ostream& err)
+	{
+		std::unique_ptr<TimeTrace> time_trace;
+		if (!options.time_trace_path.empty())
+		{
+			time_trace = std::make_unique<TimeTrace>();
+		}
+
+		int exit_code = 0;
+		{
+			TimeTrace::Scope scope(time_trace.get(), "Driver::compile", source.path());
+
+			const bool has_outputs = !options.ir_path.empty() || !options.bitcode_path.empty() ||
+				!options.assembly_path.empty() || !options.object_path.empty();
+
+			// 기록에는 추상 구문 트리의 덤프도 들어 있으므로, 덤프 형식마다 따로 저장합니다.
+			const std::string transcript_kind = "transcript/" + std::to_string(static_cast<int>(options.ast_format));
+
+			std::unique_ptr<Cache> cache;
+			std::unique_ptr<Transcript> transcript;
+			bool is_restored = false;
+			if (!options.cache_directory.empty())
+			{
+				cache = std::make_unique<Cache>(options, source);
+
+				// 요청한 모든 파일과 컴파일하며 출력했던 내용이 캐시에 있다면, 소스 파일을 컴파일하지 않고 출력했던 내용을 그대로 다시 출력합니다.
+				if (has_outputs && !options.run)
+				{
+					TimeTrace::Scope restore_scope(time_trace.get(), "Emitter::restore");
+					Emitter emitter(options, cache.get());
+					std::string transcript_data;
+					std::vector<std::string> object_paths;
+
+					is_restored = cache->load(transcript_kind, transcript_data) && emitter.restore(object_paths) &&
+						Transcript::replay(transcript_data, out, err);
+					if (is_restored)
+					{
+						print_object_paths(out, object_paths);
+					}
+					else
+					{
+						transcript = std::make_unique<Transcript>(out, err);
+					}
+				}
+			}
+
+			if (transcript)
+			{
+				// 목적 파일의 경로는 컴파일 설정에 따라 달라지므로 기록하지 않고, 불러올 때 다시 출력합니다.
+				std::vector<std::string> object_paths;
+				exit_code = compile_unit_(source, options, thread_pool, std::move(optimizer), unit, new_unit, cache.get(), time_trace.get(),
+					transcript->out(), transcript->err(), &object_paths);
+				if (exit_code == 0)
+				{
+					cache->store(transcript_kind, transcript->str());
+					print_object_paths(out, object_paths);
+				}
+			}
+			else if (!is_restored)
+			{
+				exit_code = compile_unit_(source, options, thread_pool, std::move(optimizer), unit, new_unit, cache.get(), time_trace.get(), out, err);
+			}
+		}
+
+		if (time_trace && !time_trace->write(options.time_trace_path))
+		{
+			err << "Time trace Failed\n";
+			err << time_trace->get_error() << '\n';
+			return exit_code == 0 ? 1 : exit_code;
+		}
+		return exit_code;
+	}
+	int Driver::compile_unit_(SourceFile& source, const CompileOptions& options, ThreadPool& thread_pool, std::shared_ptr<Optimizer> optimizer,
+		Unit_* unit, std::unique_ptr<Unit_>& new_unit, Cache* cache, TimeTrace* time_trace, std::ostream& out, std::ostream& err,
+		std::vector<std::string>* object_paths)
+	{
+		const bool has_outputs = !options.ir_path.empty() || !options.bitcode_path.empty() ||
+			!options.assembly_path.empty() || !options.object_path.empty();
+
+		if (!unit)
+		{
+			new_unit = make_unit_(source, thread_pool, time_trace);
+			unit = new_unit.get();
+		}
+
+		const SourceManager& source_manager = *unit->source_manager;
+		Parser& parser = *unit->parser;
+
+		if (!unit->is_parsed)
+		{
+			out << "Parsing Failed\n";
+
+			for (auto error : parser.get_errors().get_errors())
+			{
+				print_message(err, source_manager, "Error", error);
+			}
+			return 1;
+		}
+
+		for (auto warning : parser.get_warnings().get_warnings())
+		{
+			print_message(err, source_manager, "Warning", warning);
+		}
+
+		out << "Parsing Succeed\n";
+		if (options.ast_format != ASTDumpFormat::None)
+		{
+			parser.get_ast().dump(out, options.ast_format);
+			out << "\n";
+		}
+
+		if (!unit->resolver)
+		{
+			TimeTrace::Scope scope(time_trace, "Resolver::resolve");
+			unit->resolver = std::make_unique<Resolver>(parser.get_ast());
+			unit->is_resolved = unit->resolver->resolve();
+		}
+		if (!unit->is_resolved)
+		{
+			err << "Name resolution Failed\n";
+			print_message(err, source_manager, "Error", unit->resolver->get_errors().get_errors()[0]);
+			return 1;
+		}
+
+		Assembler assembler(parser.get_ast(), options, std::move(optimizer), time_trace);
+		bool is_generated = false;
+		{
+			TimeTrace::Scope scope(time_trace, "Assembler::to_llvm_ir");
+			is_generated = assembler.to_llvm_ir(thread_pool);
+		}
+		if (!is_generated)
+		{
+			err << "Code generation Failed\n";
+			print_message(err, source_manager, "Error", assembler.get_errors().get_errors()[0]);
+			return 1;
+		}
+
+		for (auto warning : assembler.get_warnings().get_warnings())
+		{
+			print_message(err, source_manager, "Warning", warning);
+		}
+
+		out << "Code generation Succeed\n";
+
+		llvm::Module& module = *assembler.get_llvm_builder().module;
+		if (!options.run)
+		{
+			llvm::raw_os_ostream stream(out);
+			module.print(stream, nullptr);
+		}
+
+		if (has_outputs)
+		{
+			TimeTrace::Scope scope(time_trace, "Emitter::write");
+			Emitter emitter(options, cache, time_trace);
+			std::vector<std::string> written_paths;
+
+			// 기계어 코드를 만드는 동안 모듈이 바뀔 수 있으므로, LLVM IR과 비트코드를 먼저 씁니다.
+			if ((options.ir_path.empty() || emitter.write_ir(module, options.ir_path)) &&
+				(options.bitcode_path.empty() || emitter.write_bitcode(module, options.bitcode_path)) &&
+				(options.assembly_path.empty() || emitter.write_assembly(module, options.assembly_path)) &&
+				(options.object_path.empty() || emitter.write_object(module, thread_pool, options.object_path, written_paths)))
+			{
+				out << "Code emission Succeed\n";
+				if (object_paths)
+				{
+					*object_paths = std::move(written_paths);
+				}
+				else
+				{
+					print_object_paths(out, written_paths);
+				}
+			}
+			else
+			{
+				err << "Code emission Failed\n";
+				err << emitter.get_error() << '\n';
+				return 1;
+			}
+		}
+
+		if (options.run)
+		{
+			// JIT 컴파일한 프로그램의 출력이 컴파일러의 출력보다 앞서지 않도록 먼저 내보냅니다.
+			out.flush();
+			err.flush();
+
+			TimeTrace::Scope scope(time_trace, "Executor::run");
+			Executor executor(options, cache);
+
+			int exit_code = 0;
+			if (executor.run(module, exit_code))
+			{
+				return exit_code;
+			}
+
+			err << "Execution Failed\n";
+			err << executor.get_error() << '\n';
+			return 1;
+		}
+
+		return 0;
+	}
+
+	/**
+	 * @brief 보관된 파일 중 소스 파일과 경로와 내용이 같은 것을 찾습니다.
+	 * @details 경로가 같지만 내용이 바뀌었다면 보관된 파일을 버립니다. 보관된 파일은 파싱할 때 복사해 둔 내용과 비교하므로, 그 뒤에 파일이 바뀌거나 잘려도 안전합니다.
+	 * @param source 찾을 소스 파일입니다.
+	 * @return 찾은 파일을, 없다면 nullptr을 반환합니다.
+	 */
+	Driver::Unit_* Driver::find_unit_(const SourceFile& source)
+	{
+		auto iter = units_.find(source.path());
+		if (iter == units_.end())
+			return nullptr;
+
+		const SourceFile& cached = iter->second->source;
+		if (cached.size() == source.size() && std::memcmp(cached.data(), source.data(), source.size()) == 0)
+		{
+			iter->second->last_used = ++unit_clock_;
+			return iter->second.get();
+		}
+
+		units_.erase(iter);
+		return nullptr;
+	}
+	void Driver::store_unit_(std::unique_ptr<Unit_> unit)
+	{
+		// 서버가 아니라면 보관한 파일을 다시 사용할 일이 없고, 매핑과 분리되지 않은 파일은 보관하면 안 됩니다.
+		if (!is_serving_)
+			return;
+
+		const std::string path = unit->source.path();
+		if (units_.size() >= max_units_ && units_.find(path) == units_.end())
+		{
+			// 가장 오래 사용하지 않은 파일 하나만 버립니다.
+			auto oldest = std::min_element(units_.begin(), units_.end(), [](const auto& lhs, const auto& rhs)
+			{
+				return lhs.second->last_used < rhs.second->last_used;
+			});
+			units_.erase(oldest);
+		}
+
+		unit->last_used = ++unit_clock_;
+		units_[path] = std::move(unit);
+	}
+	std::unique_ptr<Driver::Unit_> Driver::make_unit_(SourceFile& source, ThreadPool& thread_pool, TimeTrace* time_trace)
+	{
+		std::unique_ptr<Unit_> unit = std::make_unique<Unit_>();
+		unit->source = std::move(source);
+		unit->source_manager = std::make_unique<SourceManager>(unit->source);
+		unit->lexer = std::make_unique<Lexer>(unit->source);
+		if (unit->source.size() >= Lexer::parallel_threshold)
+		{
+			TimeTrace::Scope scope(time_trace, "Lexer::lex");
+			unit->lexer->lex(thread_pool);
+		}
+
+		// 미리 렉싱하지 않았다면 파서가 토큰을 요청할 때마다 렉싱하므로, 렉싱 시간도 파싱 시간에 포함됩니다.
+		TimeTrace::Scope scope(time_trace, "Parser::parse");
+		unit->parser = std::make_unique<Parser>(*unit->lexer);
+		unit->is_parsed = unit->parser->parse();
+
+		return unit;
+	}
+	ThreadPool& Driver::get_thread_pool_(std::size_t thread_count)
+	{
+		if (!thread_pool_ || thread_count_ != thread_count)
+		{
+			thread_pool_.reset();
+			thread_pool_ = std::make_unique<ThreadPool>(thread_count);
+			thread_count_ = thread_count;
+		}
+		return *thread_pool_;
+	}
+	ThreadPool& Driver::get_serial_thread_pool_()
+	{
+		if (!serial_thread_pool_)
+		{
+			serial_thread_pool_ = std::make_unique<ThreadPool>(1);
+		}
+		return *serial_thread_pool_;
+	}
+	std::shared_ptr<Optimizer> Driver::get_optimizer_(const CompileOptions& options)
+	{
+		if (options.opt_level == 0)
+			return nullptr;
+
+		const std::string key = std::to_string(options.opt_level) + '/' + get_target_triple(options) + '/' + options.target_cpu;
+
+		std::shared_ptr<Optimizer>& optimizer = optimizers_[key];
+		if (!optimizer)
+		{
+			optimizer = std::make_shared<Optimizer>(options);
+		}
+		return optimizer;
+	}
+	std::vector<std::string> Driver::split_arguments_(const std::string& line)
+	{
+		std::vector<std::string> result;
+		std::string argument;
+		bool in_argument = false;
+		bool in_quote = false;
+
+		for (char c : line)
+		{
+			if (c == '"')
+			{
+				in_quote = !in_quote;
+				in_argument = true;
+			}
+			else if (!in_quote && (c == ' ' || c == '\t' || c == '\r'))
+			{
+				if (in_argument)
+				{
+					result.push_back(argument);
+					argument.clear();
+					in_argument = false;
+				}
+			}
+			else
+			{
+				argument += c;
+				in_argument = true;
+			}
+		}
+		if (in_argument)
+		{
+			result.push_back(argument);
+		}
+
+		return result;
+	}
+}
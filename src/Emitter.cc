@@ -0,0 +1,523 @@
+#include "Emitter.hh"
+#include "Target.hh"
+
+#include <algorithm>
+#include <future>
+#include <system_error>
+#include <utility>
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/SplitModule.h"
+
+namespace Dlink
+{
+	namespace
+	{
+		// 조각마다 만든 목적 파일들은 캐시 항목 하나에 "<크기>\n<내용>"을 이어 붙여 저장하므로, 일부 조각만 지워지는 일이 없습니다.
+		std::string pack_objects(const std::vector<std::string>& objects)
+		{
+			std::string result;
+			for (const std::string& object : objects)
+			{
+				result += std::to_string(object.size());
+				result += '\n';
+				result += object;
+			}
+			return result;
+		}
+		bool unpack_objects(const std::string& data, std::vector<std::string>& objects)
+		{
+			objects.clear();
+
+			std::size_t offset = 0;
+			while (offset < data.size())
+			{
+				const std::size_t newline = data.find('\n', offset);
+				if (newline == std::string::npos || newline == offset)
+					return false;
+
+				std::size_t size = 0;
+				for (std::size_t i = offset; i < newline; ++i)
+				{
+					if (data[i] < '0' || data[i] > '9')
+						return false;
+
+					size = size * 10 + static_cast<std::size_t>(data[i] - '0');
+				}
+
+				offset = newline + 1;
+				if (size > data.size() - offset)
+					return false;
+
+				objects.push_back(data.substr(offset, size));
+				offset += size;
+			}
+			return !objects.empty();
+		}
+		/**
+		 * @brief 현재 스레드의 LLVM 시간 측정 결과를 TimeTrace 인스턴스에 옮깁니다.
+		 * @details 레거시 패스 관리자는 코드 생성 패스마다 LLVM의 시간 측정 이벤트를 기록하므로, 그 이벤트들을 LLVM의 JSON 출력에서 읽어 옮깁니다. 옮긴 뒤 현재 스레드의 LLVM 시간 측정을 끝냅니다.
+		 * @param time_trace 이벤트를 옮길 TimeTrace 인스턴스입니다.
+		 * @param begin LLVM의 시간 측정을 시작한 시간입니다. TimeTrace::now 함수의 반환 값입니다.
+		 */
+		void move_llvm_time_trace(TimeTrace& time_trace, std::uint64_t begin)
+		{
+			llvm::SmallVector<char, 0> buffer;
+			llvm::raw_svector_ostream stream(buffer);
+			llvm::timeTraceProfilerWrite(stream);
+			llvm::timeTraceProfilerCleanup();
+
+			llvm::Expected<llvm::json::Value> json = llvm::json::parse(llvm::StringRef(buffer.data(), buffer.size()));
+			if (!json)
+			{
+				llvm::consumeError(json.takeError());
+				return;
+			}
+
+			const llvm::json::Object* root = json->getAsObject();
+			const llvm::json::Array* events = root ? root->getArray("traceEvents") : nullptr;
+			if (!events)
+				return;
+
+			for (const llvm::json::Value& value : *events)
+			{
+				const llvm::json::Object* event = value.getAsObject();
+				if (!event || event->getString("ph") != llvm::StringRef("X"))
+					continue;
+
+				const llvm::Optional<llvm::StringRef> name = event->getString("name");
+				const llvm::Optional<std::int64_t> timestamp = event->getInteger("ts");
+				const llvm::Optional<std::int64_t> duration = event->getInteger("dur");
+				// Total로 시작하는 이벤트는 같은 이름의 이벤트들의 시간을 합한 요약입니다.
+				if (!name || !timestamp || !duration || name->startswith("Total "))
+					continue;
+
+				std::string detail;
+				if (const llvm::json::Object* args = event->getObject("args"))
+				{
+					if (const llvm::Optional<llvm::StringRef> args_detail = args->getString("detail"))
+					{
+						detail = args_detail->str();
+					}
+				}
+
+				// 패스는 Optimizer의 이벤트처럼 패스의 이름으로 기록합니다.
+				std::string event_name;
+				if (*name == "RunPass")
+				{
+					event_name = std::move(detail);
+					detail.clear();
+				}
+				else if (*name == "OptFunction")
+				{
+					event_name = "Emitter::code_gen_function";
+				}
+				else if (*name == "OptModule")
+				{
+					event_name = "Emitter::code_gen_module";
+				}
+				else
+				{
+					event_name = name->str();
+				}
+
+				const std::uint64_t event_begin = begin + static_cast<std::uint64_t>(*timestamp) * 1000;
+				time_trace.add_event(event_name, detail, event_begin, event_begin + static_cast<std::uint64_t>(*duration) * 1000);
+			}
+		}
+	}
+
+	/**
+	 * @brief 새 Emitter 인스턴스를 만듭니다.
+	 * @param options 컴파일 설정입니다.
+	 * @param cache 쓴 파일들을 저장할 캐시입니다. nullptr이면 캐시를 사용하지 않습니다.
+	 * @param time_trace 기계어 코드를 만드는 각 패스에 걸린 시간을 기록할 TimeTrace 인스턴스입니다. nullptr이면 기록하지 않습니다.
+	 */
+	Emitter::Emitter(const CompileOptions& options, Cache* cache, TimeTrace* time_trace)
+		: options_(options), cache_(cache), time_trace_(time_trace)
+	{}
+
+	/**
+	 * @brief LLVM 모듈로 목적 파일들을 만듭니다.
+	 * @details 컴파일 설정의 split_objects가 true라면, 정의된 함수 parallel_threshold개마다 조각 하나씩, 최대 max_object_count개의 조각으로 모듈을 나누고, 각 조각을 작업 스레드마다 새 LLVMContext에서 읽어 자신만의 대상 머신으로 목적 파일을 만듭니다.
+	 * 명령어 선택과 레지스터 할당은 조각마다 독립적이므로 작업 스레드 개수에 비례해 빨라집니다. 조각의 개수는 작업 스레드 개수와 관계없으므로, 같은 모듈과 컴파일 설정으로는 항상 같은 목적 파일들을 만듭니다.
+	 * 작업 스레드가 하나뿐이라면 조각들을 비트코드로 직렬화하지 않고 현재 스레드에서 차례대로 목적 파일로 만듭니다. split_objects가 false이거나 조각이 하나뿐이라면 모듈을 나누지 않고 목적 파일 하나를 만듭니다.
+	 * 모듈에는 대상 머신의 트리플과 데이터 레이아웃을 설정합니다.
+	 * @param module 목적 파일로 만들 모듈입니다.
+	 * @param thread_pool 목적 파일을 만들 작업 스레드 풀입니다.
+	 * @param objects 만든 목적 파일들을 조각 순서대로 저장할 목록입니다.
+	 * @return 목적 파일을 만들었을 경우 true를, 실패했을 경우 false를 반환합니다.
+	 */
+	bool Emitter::emit_objects(llvm::Module& module, ThreadPool& thread_pool, std::vector<std::string>& objects)
+	{
+		std::unique_ptr<llvm::TargetMachine> target_machine = prepare_(module);
+		if (!target_machine)
+			return false;
+
+		std::size_t definition_count = 0;
+		if (options_.split_objects)
+		{
+			for (const llvm::Function& function : module)
+			{
+				if (!function.isDeclaration())
+				{
+					++definition_count;
+				}
+			}
+		}
+
+		const std::size_t piece_count = std::min(definition_count / parallel_threshold, max_object_count);
+		if (piece_count <= 1)
+		{
+			objects.assign(1, std::string());
+			return emit_file_(*target_machine, module, llvm::CGFT_ObjectFile, time_trace_, objects[0], error_);
+		}
+
+		// 작업 스레드가 하나뿐이라면 나눈 조각들을 동시에 만들 수 없으므로, 원래 모듈의 LLVMContext에서 바로 목적 파일로 만듭니다.
+		if (thread_pool.size() <= 1)
+		{
+			objects.clear();
+
+			bool is_succeeded = true;
+			llvm::SplitModule(module, static_cast<unsigned>(piece_count), [this, &target_machine, &objects, &is_succeeded](std::unique_ptr<llvm::Module> piece)
+			{
+				objects.emplace_back();
+				if (is_succeeded && !emit_file_(*target_machine, *piece, llvm::CGFT_ObjectFile, time_trace_, objects.back(), error_))
+				{
+					is_succeeded = false;
+				}
+			}, true);
+			return is_succeeded;
+		}
+
+		// 나눈 조각들은 원래 모듈과 LLVMContext를 공유하므로, 비트코드로 직렬화해 작업 스레드마다 새 LLVMContext에서 읽습니다.
+		std::vector<std::string> pieces;
+		llvm::SplitModule(module, static_cast<unsigned>(piece_count), [&pieces](std::unique_ptr<llvm::Module> piece)
+		{
+			pieces.emplace_back();
+
+			llvm::raw_string_ostream stream(pieces.back());
+			llvm::WriteBitcodeToFile(*piece, stream);
+		}, true);
+
+		objects.assign(pieces.size(), std::string());
+
+		// 작업 스레드들이 error_를 동시에 쓰지 않도록, 조각마다 오류 메세지를 따로 저장했다가 첫 번째 것을 보고합니다.
+		std::vector<std::string> errors(pieces.size());
+		std::vector<std::future<bool>> results;
+		for (std::size_t i = 0; i < pieces.size(); ++i)
+		{
+			results.push_back(thread_pool.submit([this, &pieces, &objects, &errors, i]()
+			{
+				llvm::LLVMContext context;
+				llvm::Expected<std::unique_ptr<llvm::Module>> piece =
+					llvm::parseBitcodeFile(llvm::MemoryBufferRef(pieces[i], "piece"), context);
+
+				if (!piece)
+				{
+					errors[i] = "Failed to read a split module piece: " + llvm::toString(piece.takeError());
+					return false;
+				}
+
+				std::unique_ptr<llvm::TargetMachine> target_machine = create_target_machine(options_, errors[i]);
+
+				return target_machine && emit_file_(*target_machine, *piece.get(), llvm::CGFT_ObjectFile, time_trace_, objects[i], errors[i]);
+			}));
+		}
+
+		// 작업이 pieces와 objects, errors를 참조하므로, 예외가 발생하더라도 모든 작업이 끝난 뒤에 결과를 가져옵니다.
+		for (std::future<bool>& result : results)
+		{
+			result.wait();
+		}
+
+		for (std::size_t i = 0; i < results.size(); ++i)
+		{
+			if (!results[i].get())
+			{
+				error_ = errors[i];
+				return false;
+			}
+		}
+
+		return true;
+	}
+	/**
+	 * @brief LLVM 모듈로 목적 파일을 만들어 씁니다.
+	 * @details emit_objects 함수가 목적 파일을 하나만 만들었다면 path에 쓰고, 모듈을 나눠 여러 개를 만들었다면 첫 번째 조각은 path에, 나머지 조각은 path의 확장자 앞에 .part<번호>를 붙인 경로에 씁니다.
+	 * 정적 라이브러리로 묶으면 링커가 아직 정의되지 않은 심볼이 있는 조각만 가져오므로, 조각들은 모두 링커에 목적 파일로 전달해야 합니다.
+	 * 컴파일 설정의 split_objects가 true라면, 쓴 조각의 개수를 path 뒤에 .parts를 붙인 목록 파일에 기록하고, 이전 컴파일이 그 목록에 기록한 조각 중 이번에 만들지 않은 조각은 지웁니다. split_objects가 false라면 다른 파일은 건드리지 않습니다.
+	 * @param module 목적 파일로 만들 모듈입니다.
+	 * @param thread_pool 목적 파일을 만들 작업 스레드 풀입니다.
+	 * @param path 목적 파일을 쓸 경로입니다.
+	 * @param paths 목적 파일들을 쓴 경로를 조각 순서대로 저장할 목록입니다.
+	 * @return 목적 파일을 모두 썼을 경우 true를, 실패했을 경우 false를 반환합니다.
+	 */
+	bool Emitter::write_object(llvm::Module& module, ThreadPool& thread_pool, const std::string& path, std::vector<std::string>& paths)
+	{
+		std::vector<std::string> objects;
+		if (!emit_objects(module, thread_pool, objects) || !write_objects_(path, objects, paths))
+			return false;
+
+		if (cache_)
+		{
+			cache_->store(objects_kind_(), pack_objects(objects));
+		}
+		return true;
+	}
+	/**
+	 * @brief LLVM 모듈로 어셈블리어 파일을 만들어 씁니다.
+	 * @details 조각마다 만든 어셈블리어를 이어 붙이면 지역 레이블이 겹치므로, 모듈을 나누지 않고 대상 머신 하나로 만듭니다.
+	 * @param module 어셈블리어로 만들 모듈입니다.
+	 * @param path 어셈블리어 파일을 쓸 경로입니다.
+	 * @return 어셈블리어 파일을 썼을 경우 true를, 실패했을 경우 false를 반환합니다.
+	 */
+	bool Emitter::write_assembly(llvm::Module& module, const std::string& path)
+	{
+		std::unique_ptr<llvm::TargetMachine> target_machine = prepare_(module);
+		if (!target_machine)
+			return false;
+
+		std::string assembly;
+		return emit_file_(*target_machine, module, llvm::CGFT_AssemblyFile, time_trace_, assembly, error_) &&
+			write_output_("s", path, assembly, llvm::sys::fs::OF_Text);
+	}
+	/**
+	 * @brief LLVM 모듈을 LLVM 비트코드 파일로 씁니다.
+	 * @details 모듈에는 대상 머신의 트리플과 데이터 레이아웃을 설정합니다.
+	 * @param module 쓸 모듈입니다.
+	 * @param path 비트코드 파일을 쓸 경로입니다.
+	 * @return 비트코드 파일을 썼을 경우 true를, 실패했을 경우 false를 반환합니다.
+	 */
+	bool Emitter::write_bitcode(llvm::Module& module, const std::string& path)
+	{
+		if (!prepare_(module))
+			return false;
+
+		std::string bitcode;
+		llvm::raw_string_ostream stream(bitcode);
+		llvm::WriteBitcodeToFile(module, stream);
+		stream.flush();
+
+		return write_output_("bc", path, bitcode, llvm::sys::fs::OF_None);
+	}
+	/**
+	 * @brief LLVM 모듈을 텍스트 형식의 LLVM IR 파일로 씁니다.
+	 * @details 모듈에는 대상 머신의 트리플과 데이터 레이아웃을 설정합니다.
+	 * @param module 쓸 모듈입니다.
+	 * @param path LLVM IR 파일을 쓸 경로입니다.
+	 * @return LLVM IR 파일을 썼을 경우 true를, 실패했을 경우 false를 반환합니다.
+	 */
+	bool Emitter::write_ir(llvm::Module& module, const std::string& path)
+	{
+		if (!prepare_(module))
+			return false;
+
+		std::string ir;
+		llvm::raw_string_ostream stream(ir);
+		module.print(stream, nullptr);
+		stream.flush();
+
+		return write_output_("ll", path, ir, llvm::sys::fs::OF_Text);
+	}
+	/**
+	 * @brief 컴파일 설정에 지정된 모든 파일을 캐시에서 불러와 씁니다.
+	 * @details 하나라도 캐시에 없다면 아무 파일도 쓰지 않으므로, 이 함수가 성공하면 소스 파일을 컴파일할 필요가 없습니다. 목적 파일들은 write_object 함수와 같은 경로에 씁니다.
+	 * @param object_paths 목적 파일들을 쓴 경로를 조각 순서대로 저장할 목록입니다.
+	 * @return 모든 파일을 썼을 경우 true를, 캐시가 없거나 캐시에 없는 파일이 있거나 쓰지 못했을 경우 false를 반환합니다.
+	 */
+	bool Emitter::restore(std::vector<std::string>& object_paths)
+	{
+		if (!cache_)
+			return false;
+
+		struct Output
+		{
+			std::string kind;
+			const std::string* path;
+			llvm::sys::fs::OpenFlags flags;
+			std::string data;
+		};
+		std::vector<Output> outputs = {
+			{ "ll", &options_.ir_path, llvm::sys::fs::OF_Text, std::string() },
+			{ "bc", &options_.bitcode_path, llvm::sys::fs::OF_None, std::string() },
+			{ "s", &options_.assembly_path, llvm::sys::fs::OF_Text, std::string() },
+		};
+
+		for (Output& output : outputs)
+		{
+			if (!output.path->empty() && !cache_->load(output.kind, output.data))
+				return false;
+		}
+
+		std::string objects_data;
+		std::vector<std::string> objects;
+		if (!options_.object_path.empty() && (!cache_->load(objects_kind_(), objects_data) || !unpack_objects(objects_data, objects)))
+			return false;
+
+		for (const Output& output : outputs)
+		{
+			if (!output.path->empty() && !write_file_(*output.path, output.data, output.flags))
+				return false;
+		}
+
+		object_paths.clear();
+		return objects.empty() || write_objects_(options_.object_path, objects, object_paths);
+	}
+	/**
+	 * @brief 마지막으로 발생한 오류의 메세지를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 오류 메세지를 반환합니다.
+	 */
+	const std::string& Emitter::get_error() const noexcept
+	{
+		return error_;
+	}
+
+	std::unique_ptr<llvm::TargetMachine> Emitter::prepare_(llvm::Module& module)
+	{
+		std::unique_ptr<llvm::TargetMachine> target_machine = create_target_machine(options_, error_);
+		if (!target_machine)
+			return nullptr;
+
+		module.setTargetTriple(target_machine->getTargetTriple().str());
+		module.setDataLayout(target_machine->createDataLayout());
+		return target_machine;
+	}
+	bool Emitter::emit_file_(llvm::TargetMachine& target_machine, llvm::Module& module, llvm::CodeGenFileType file_type, TimeTrace* time_trace,
+		std::string& output, std::string& error)
+	{
+		llvm::SmallVector<char, 0> buffer;
+		llvm::raw_svector_ostream stream(buffer);
+
+		llvm::legacy::PassManager pass_manager;
+		if (target_machine.addPassesToEmitFile(pass_manager, stream, nullptr, file_type))
+		{
+			error = "Target does not support emitting this file type";
+			return false;
+		}
+
+		// 레거시 패스 관리자는 패스 계측 콜백을 지원하지 않으므로, 현재 스레드에서 LLVM의 시간 측정을 켜고 실행한 뒤 결과를 옮깁니다.
+		const bool is_traced = time_trace && !llvm::timeTraceProfilerEnabled();
+		std::uint64_t begin = 0;
+		if (is_traced)
+		{
+			llvm::timeTraceProfilerInitialize(0, "Dlink");
+			begin = time_trace->now();
+		}
+
+		pass_manager.run(module);
+
+		if (is_traced)
+		{
+			move_llvm_time_trace(*time_trace, begin);
+		}
+
+		output.assign(buffer.begin(), buffer.end());
+		return true;
+	}
+	std::string Emitter::object_path_(const std::string& path, std::size_t index)
+	{
+		if (index == 0)
+			return path;
+
+		llvm::SmallString<128> result(path);
+		llvm::sys::path::replace_extension(result, ".part" + std::to_string(index) + llvm::sys::path::extension(path).str());
+		return result.str().str();
+	}
+	std::string Emitter::manifest_path_(const std::string& path)
+	{
+		return path + ".parts";
+	}
+	bool Emitter::write_objects_(const std::string& path, const std::vector<std::string>& objects, std::vector<std::string>& paths)
+	{
+		if (options_.split_objects)
+		{
+			remove_stale_objects_(path, objects.size());
+		}
+
+		paths.clear();
+		for (std::size_t i = 0; i < objects.size(); ++i)
+		{
+			paths.push_back(object_path_(path, i));
+			if (!write_file_(paths[i], objects[i], llvm::sys::fs::OF_None))
+				return false;
+		}
+
+		if (!options_.split_objects)
+			return true;
+
+		// 조각이 하나뿐이라면 나중에 지울 조각이 없으므로 목록 파일을 남기지 않습니다.
+		if (objects.size() <= 1)
+		{
+			llvm::sys::fs::remove(manifest_path_(path));
+			return true;
+		}
+		return write_file_(manifest_path_(path), std::to_string(objects.size()), llvm::sys::fs::OF_Text);
+	}
+	void Emitter::remove_stale_objects_(const std::string& path, std::size_t count)
+	{
+		// 사용자의 파일을 지우지 않도록, 이전 컴파일이 목록 파일에 기록한 조각들만 지웁니다.
+		llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> manifest = llvm::MemoryBuffer::getFile(manifest_path_(path));
+		if (!manifest)
+			return;
+
+		// 조각은 max_object_count개보다 많이 만들지 않으므로, 그보다 큰 개수는 잘못된 목록으로 보고 무시합니다.
+		std::size_t previous_count = 0;
+		for (char digit : manifest.get()->getBuffer())
+		{
+			if (digit < '0' || digit > '9')
+				break;
+
+			previous_count = previous_count * 10 + static_cast<std::size_t>(digit - '0');
+			if (previous_count > max_object_count)
+				return;
+		}
+
+		for (std::size_t i = std::max<std::size_t>(count, 1); i < previous_count; ++i)
+		{
+			llvm::sys::fs::remove(object_path_(path, i));
+		}
+	}
+	std::string Emitter::objects_kind_() const
+	{
+		// 모듈을 나누는지에 따라 목적 파일의 개수가 달라지므로 따로 저장합니다.
+		return options_.split_objects ? "objects/split" : "objects";
+	}
+	bool Emitter::write_output_(const std::string& kind, const std::string& path, llvm::StringRef data, llvm::sys::fs::OpenFlags flags)
+	{
+		if (!write_file_(path, data, flags))
+			return false;
+
+		if (cache_)
+		{
+			cache_->store(kind, data);
+		}
+		return true;
+	}
+	bool Emitter::write_file_(const std::string& path, llvm::StringRef data, llvm::sys::fs::OpenFlags flags)
+	{
+		std::error_code error_code;
+		llvm::raw_fd_ostream stream(path, error_code, flags);
+
+		if (error_code)
+		{
+			error_ = "Couldn't open \"" + path + "\": " + error_code.message();
+			return false;
+		}
+
+		stream << data;
+		return true;
+	}
+}
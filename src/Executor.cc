@@ -0,0 +1,147 @@
+#include "Executor.hh"
+#include "Target.hh"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/Support/raw_ostream.h"
+
+namespace Dlink
+{
+	/**
+	 * @brief 새 Executor 인스턴스를 만듭니다.
+	 * @param options 컴파일 설정입니다. 최적화 레벨에 따라 JIT 컴파일러의 코드 생성 최적화 레벨을 정합니다.
+	 * @param cache JIT 컴파일러가 컴파일한 목적 코드를 저장할 캐시입니다. nullptr이면 캐시를 사용하지 않습니다.
+	 */
+	Executor::Executor(const CompileOptions& options, Cache* cache)
+		: options_(options), cache_(cache)
+	{}
+
+	/**
+	 * @brief LLVM 모듈을 JIT 컴파일해 main 함수를 실행합니다.
+	 * @details 모듈을 비트코드로 직렬화해 JIT 컴파일러가 가지는 새 LLVMContext에서 읽으므로, 원래 모듈은 바뀌지 않습니다. JIT 컴파일러는 현재 플랫폼을 대상으로 하며, 현재 프로세스의 심볼을 사용할 수 있습니다.
+	 * 함수 본문은 처음 호출될 때 함수 단위로 컴파일하므로, 시작할 때는 main 함수만 컴파일합니다. 캐시가 있다면 함수 단위로 컴파일한 목적 코드를 캐시에서 불러오고, 없다면 컴파일한 뒤 저장합니다. main 함수는 매개변수가 없어야 하며, 반환 타입이 int가 아니라면 종료 코드는 0입니다.
+	 * @param module 실행할 모듈입니다.
+	 * @param exit_code main 함수의 반환 값을 저장할 변수입니다.
+	 * @return main 함수를 실행했을 경우 true를, 실패했을 경우 false를 반환합니다.
+	 */
+	bool Executor::run(const llvm::Module& module, int& exit_code)
+	{
+		const llvm::Function* main_function = module.getFunction("main");
+		if (!main_function || main_function->isDeclaration() || main_function->arg_size() != 0)
+		{
+			error_ = "Couldn't find a main function without parameters";
+			return false;
+		}
+		const bool returns_int = main_function->getReturnType()->isIntegerTy(32);
+
+		initialize_targets();
+
+		llvm::Expected<llvm::orc::JITTargetMachineBuilder> target_machine_builder = llvm::orc::JITTargetMachineBuilder::detectHost();
+		if (!target_machine_builder)
+		{
+			error_ = llvm::toString(target_machine_builder.takeError());
+			return false;
+		}
+
+		target_machine_builder->setCodeGenOptLevel(get_code_gen_opt_level(options_));
+
+		llvm::orc::LLLazyJITBuilder jit_builder;
+
+		// JIT 컴파일러보다 먼저 만들어야 JIT 컴파일러보다 나중에 소멸됩니다.
+		std::unique_ptr<JITCache> jit_cache;
+		if (cache_)
+		{
+			jit_cache = std::make_unique<JITCache>(*cache_, target_machine_builder->getTargetTriple().str() + "/" +
+				target_machine_builder->getCPU() + "/" + target_machine_builder->getFeatures().getString());
+
+			JITCache* object_cache = jit_cache.get();
+			jit_builder.setCompileFunctionCreator([object_cache](llvm::orc::JITTargetMachineBuilder builder)
+				-> llvm::Expected<std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>>
+			{
+				llvm::Expected<std::unique_ptr<llvm::TargetMachine>> target_machine = builder.createTargetMachine();
+				if (!target_machine)
+					return target_machine.takeError();
+
+				return std::make_unique<llvm::orc::TMOwningSimpleCompiler>(std::move(*target_machine), object_cache);
+			});
+		}
+
+		llvm::Expected<std::unique_ptr<llvm::orc::LLLazyJIT>> jit = jit_builder
+			.setJITTargetMachineBuilder(std::move(*target_machine_builder))
+			.create();
+		if (!jit)
+		{
+			error_ = llvm::toString(jit.takeError());
+			return false;
+		}
+
+		llvm::Expected<std::unique_ptr<llvm::orc::DynamicLibrarySearchGenerator>> process_symbols =
+			llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess((*jit)->getDataLayout().getGlobalPrefix());
+		if (!process_symbols)
+		{
+			error_ = llvm::toString(process_symbols.takeError());
+			return false;
+		}
+		(*jit)->getMainJITDylib().addGenerator(std::move(*process_symbols));
+
+		std::string bitcode;
+		llvm::raw_string_ostream stream(bitcode);
+		llvm::WriteBitcodeToFile(module, stream);
+		stream.flush();
+
+		std::unique_ptr<llvm::LLVMContext> context = std::make_unique<llvm::LLVMContext>();
+		llvm::Expected<std::unique_ptr<llvm::Module>> copy = llvm::parseBitcodeFile(llvm::MemoryBufferRef(bitcode, "run"), *context);
+		if (!copy)
+		{
+			error_ = llvm::toString(copy.takeError());
+			return false;
+		}
+
+		// 다른 플랫폼을 대상으로 만든 모듈이라도 현재 플랫폼에서 실행합니다.
+		(*copy)->setTargetTriple((*jit)->getTargetTriple().str());
+		(*copy)->setDataLayout((*jit)->getDataLayout());
+
+		if (llvm::Error error = (*jit)->addLazyIRModule(llvm::orc::ThreadSafeModule(std::move(*copy), std::move(context))))
+		{
+			error_ = llvm::toString(std::move(error));
+			return false;
+		}
+
+		llvm::Expected<llvm::JITEvaluatedSymbol> main_symbol = (*jit)->lookup("main");
+		if (!main_symbol)
+		{
+			error_ = llvm::toString(main_symbol.takeError());
+			return false;
+		}
+
+		if (returns_int)
+		{
+			exit_code = reinterpret_cast<int(*)()>(static_cast<std::uintptr_t>(main_symbol->getAddress()))();
+		}
+		else
+		{
+			reinterpret_cast<void(*)()>(static_cast<std::uintptr_t>(main_symbol->getAddress()))();
+			exit_code = 0;
+		}
+		return true;
+	}
+	/**
+	 * @brief 마지막으로 발생한 오류의 메세지를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 오류 메세지를 반환합니다.
+	 */
+	const std::string& Executor::get_error() const noexcept
+	{
+		return error_;
+	}
+}
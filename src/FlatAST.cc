@@ -0,0 +1,306 @@
+#include "FlatAST.hh"
+
+#include <utility>
+
+namespace Dlink
+{
+	/**
+	 * @brief AST를 변환해 새 FlatAST 인스턴스를 만듭니다.
+	 * @details 트리를 명시적 스택으로 한 번 순회하므로, 트리가 아무리 깊어도 네이티브 스택을 일정하게 사용하며 노드의 개수에 비례하는 시간이 걸립니다. 타입 노드와 nullptr인 하위 노드는 포함하지 않습니다.
+	 * @param ast 변환할 AST입니다. 변환한 FlatAST를 사용하는 동안 살아있어야 합니다.
+	 */
+	FlatAST::FlatAST(const AST& ast)
+	{
+		if (!ast.node_)
+			return;
+
+		static constexpr std::size_t no_parent = static_cast<std::size_t>(-1);
+
+		// 하위 노드를 오른쪽부터 방문하는 전위 순회를 뒤집으면 하위 노드를 왼쪽부터 방문하는 후위 순회가 됩니다.
+		std::vector<Node*> order;
+		std::vector<std::size_t> parent_positions;
+		std::vector<std::pair<Node*, std::size_t>> stack;
+		std::vector<Node*> children;
+
+		stack.emplace_back(ast.node_, no_parent);
+		while (!stack.empty())
+		{
+			std::pair<Node*, std::size_t> top = stack.back();
+			stack.pop_back();
+
+			const std::size_t position = order.size();
+			order.push_back(top.first);
+			parent_positions.push_back(top.second);
+
+			children.clear();
+			top.first->children(children);
+			for (Node* child : children)
+			{
+				if (child)
+				{
+					stack.emplace_back(child, position);
+				}
+			}
+		}
+
+		const std::uint32_t count = static_cast<std::uint32_t>(order.size());
+		std::vector<std::uint32_t> parents(count);
+
+		kinds_.resize(count);
+		ops_.resize(count, TokenType::none);
+		data_.resize(count, 0);
+		offsets_.resize(count);
+		lengths_.resize(count);
+		subtree_sizes_.resize(count, 1);
+		first_children_.resize(count, 0);
+		child_counts_.resize(count, 0);
+		nodes_.resize(count);
+
+		for (std::uint32_t index = 0; index < count; ++index)
+		{
+			const std::size_t position = count - 1 - index;
+			Node* node = order[position];
+
+			kinds_[index] = node->kind;
+			offsets_[index] = node->token.offset;
+			lengths_[index] = node->token.length;
+			nodes_[index] = node;
+
+			switch (node->kind)
+			{
+			case NodeKind::BinaryOperation:
+				ops_[index] = cast<BinaryOperation>(node)->op;
+				break;
+			case NodeKind::UnaryOperation:
+				ops_[index] = cast<UnaryOperation>(node)->op;
+				break;
+			case NodeKind::Integer32:
+				data_[index] = cast<Integer32>(node)->data;
+				break;
+			case NodeKind::Character:
+				data_[index] = cast<Character>(node)->data;
+				break;
+
+			default:
+				break;
+			}
+
+			parents[index] = parent_positions[position] == no_parent ? index :
+				static_cast<std::uint32_t>(count - 1 - parent_positions[position]);
+			if (parents[index] != index)
+			{
+				++child_counts_[parents[index]];
+			}
+		}
+
+		std::uint32_t child_offset = 0;
+		for (std::uint32_t index = 0; index < count; ++index)
+		{
+			first_children_[index] = child_offset;
+			child_offset += child_counts_[index];
+		}
+
+		// 하위 노드는 상위 노드보다 먼저, 왼쪽부터 나오므로 순서대로 채우면 됩니다.
+		std::vector<std::uint32_t> next_children(first_children_);
+		children_.resize(child_offset);
+		for (std::uint32_t index = 0; index < count; ++index)
+		{
+			const std::uint32_t parent = parents[index];
+			if (parent != index)
+			{
+				children_[next_children[parent]++] = index;
+				subtree_sizes_[parent] += subtree_sizes_[index];
+			}
+		}
+	}
+
+	/**
+	 * @brief 코드를 만들기 전에 필요한 작업을 수행합니다.
+	 * @details Node::preprocess와 같은 후위 순회 순서로 Node::preprocess_node를 호출하지만, 트리를 순회하지 않고 배열을 앞에서부터 훑습니다.
+	 */
+	void FlatAST::preprocess()
+	{
+		for (Node* node : nodes_)
+		{
+			node->preprocess_node();
+		}
+	}
+	/**
+	 * @brief 노드의 식을 Dlink 코드를 컴파일 하는 중에 계산합니다.
+	 * @details 노드의 하위 트리가 차지하는 범위를 앞에서부터 한 번 훑으며 값 스택으로 계산하므로, 포인터를 따라 트리를 순회하는 Expression::evaluate와 달리 작업 스택도 필요하지 않습니다. 결과는 Expression::evaluate와 같습니다.
+	 * @param index 계산할 노드의 번호입니다.
+	 * @param out 계산된 값을 저장할 Any 인스턴스입니다.
+	 * @return 컴파일 시간에 계산을 성공했을 경우 true를, 실패했을 경우 false를 반환합니다.
+	 */
+	bool FlatAST::evaluate(std::uint32_t index, Any& out) const
+	{
+		struct Value
+		{
+			bool ok;
+			Any value;
+		};
+
+		std::vector<Value> stack;
+
+		for (std::uint32_t i = index + 1 - subtree_sizes_[index]; i <= index; ++i)
+		{
+			const std::size_t base = stack.size() - child_counts_[i];
+			Value result = { false, Any() };
+
+			switch (kinds_[i])
+			{
+			case NodeKind::Integer32:
+				result.ok = true;
+				result.value = static_cast<std::int64_t>(data_[i]);
+				break;
+
+			case NodeKind::BinaryOperation:
+				if (child_counts_[i] == 2 && stack[base].ok && stack[base + 1].ok)
+				{
+					result.ok = Expression::evaluate_binary(ops_[i], stack[base].value, stack[base + 1].value, result.value);
+				}
+				break;
+
+			case NodeKind::UnaryOperation:
+				if (child_counts_[i] == 1 && stack[base].ok)
+				{
+					result.ok = Expression::evaluate_unary(ops_[i], stack[base].value, result.value);
+				}
+				break;
+
+			default:
+				break;
+			}
+
+			stack.resize(base);
+			stack.push_back(std::move(result));
+		}
+
+		if (stack.back().ok)
+		{
+			out = std::move(stack.back().value);
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief 노드의 개수를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 노드의 개수를 반환합니다.
+	 */
+	std::uint32_t FlatAST::size() const noexcept
+	{
+		return static_cast<std::uint32_t>(kinds_.size());
+	}
+	/**
+	 * @brief 노드가 하나도 없는지 확인합니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 노드가 없으면 true, 있으면 false를 반환합니다.
+	 */
+	bool FlatAST::empty() const noexcept
+	{
+		return kinds_.empty();
+	}
+	/**
+	 * @brief 루트 노드의 번호를 가져옵니다.
+	 * @details 루트 노드는 항상 마지막 노드입니다. 노드가 하나 이상 있어야 합니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 루트 노드의 번호를 반환합니다.
+	 */
+	std::uint32_t FlatAST::root() const noexcept
+	{
+		return size() - 1;
+	}
+
+	/**
+	 * @brief 노드의 실제 타입을 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param index 노드의 번호입니다.
+	 * @return 노드의 실제 타입을 반환합니다.
+	 */
+	NodeKind FlatAST::kind(std::uint32_t index) const noexcept
+	{
+		return kinds_[index];
+	}
+	/**
+	 * @brief 연산 노드의 연산자 타입을 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param index 노드의 번호입니다.
+	 * @return BinaryOperation이나 UnaryOperation 노드라면 연산자 타입을, 아니라면 TokenType::none을 반환합니다.
+	 */
+	TokenType FlatAST::op(std::uint32_t index) const noexcept
+	{
+		return ops_[index];
+	}
+	/**
+	 * @brief 상수 노드의 값을 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param index 노드의 번호입니다.
+	 * @return Integer32나 Character 노드라면 상수 값을, 아니라면 0을 반환합니다.
+	 */
+	std::int32_t FlatAST::data(std::uint32_t index) const noexcept
+	{
+		return data_[index];
+	}
+	/**
+	 * @brief 노드를 만드는데 사용된 가장 첫번째 토큰의 오프셋을 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param index 노드의 번호입니다.
+	 * @return 토큰의 원본 문장이 소스 버퍼에서 시작되는 오프셋을 반환합니다.
+	 */
+	std::uint32_t FlatAST::offset(std::uint32_t index) const noexcept
+	{
+		return offsets_[index];
+	}
+	/**
+	 * @brief 노드를 만드는데 사용된 가장 첫번째 토큰의 길이를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param index 노드의 번호입니다.
+	 * @return 토큰의 원본 문장의 길이를 반환합니다.
+	 */
+	std::uint32_t FlatAST::length(std::uint32_t index) const noexcept
+	{
+		return lengths_[index];
+	}
+	/**
+	 * @brief 노드를 루트로 하는 하위 트리의 노드 개수를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param index 노드의 번호입니다.
+	 * @return 노드 자신을 포함한 하위 트리의 노드 개수를 반환합니다.
+	 */
+	std::uint32_t FlatAST::subtree_size(std::uint32_t index) const noexcept
+	{
+		return subtree_sizes_[index];
+	}
+	/**
+	 * @brief 노드의 하위 노드 개수를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param index 노드의 번호입니다.
+	 * @return 하위 노드의 개수를 반환합니다.
+	 */
+	std::uint32_t FlatAST::child_count(std::uint32_t index) const noexcept
+	{
+		return child_counts_[index];
+	}
+	/**
+	 * @brief 노드의 하위 노드의 번호를 가져옵니다.
+	 * @details 하위 노드는 Node::children과 같은 순서이며, nullptr인 하위 노드는 건너뜁니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param index 노드의 번호입니다.
+	 * @param nth 가져올 하위 노드의 순서입니다. child_count(index)보다 작아야 합니다.
+	 * @return 하위 노드의 번호를 반환합니다.
+	 */
+	std::uint32_t FlatAST::child(std::uint32_t index, std::uint32_t nth) const noexcept
+	{
+		return children_[first_children_[index] + nth];
+	}
+	/**
+	 * @brief 노드의 원래 노드를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param index 노드의 번호입니다.
+	 * @return 변환하기 전 AST의 노드를 반환합니다.
+	 */
+	Node* FlatAST::node(std::uint32_t index) const noexcept
+	{
+		return nodes_[index];
+	}
+}
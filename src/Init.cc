@@ -1,12 +1,44 @@
 #include "Init.hh"
 
+#include <algorithm>
+#include <unordered_set>
+
 namespace Dlink
 {
+	namespace
+	{
+		std::string replace_extension(const std::string& path, const std::string& extension)
+		{
+			const std::size_t separator = path.find_last_of("/\\");
+			const std::size_t dot = path.find_last_of('.');
+
+			if (dot != std::string::npos && (separator == std::string::npos || dot > separator))
+			{
+				return path.substr(0, dot) + extension;
+			}
+			return path + extension;
+		}
+		std::string output_in_directory(const std::string& directory, const std::string& source_path, const std::string& extension)
+		{
+			const std::size_t separator = source_path.find_last_of("/\\");
+			const std::string filename = separator == std::string::npos ? source_path : source_path.substr(separator + 1);
+
+			std::string result = directory;
+			if (result.back() != '/' && result.back() != '\\')
+			{
+				result += '/';
+			}
+			return result + replace_extension(filename, extension);
+		}
+	}
+
 	/**
 	 * @brief 커맨드 라인에서 파싱된 데이터를 기반으로 파일 로드 등의 작업을 수행합니다.
 	 * @param argc 명령줄의 개수입니다.
 	 * @param argv 명령줄 배열입니다.
-	 * @return 로드된 파일의 내용입니다.
+	 * @details 소스 파일이 여러개라면 /Obj, /Asm, /BC로 지정한 경로를 디렉토리로 보고, 각 소스 파일의 출력은 그 디렉토리에 소스 파일의 확장자를 바꾼 이름으로 씁니다. 서로 다른 디렉토리에 있는 같은 이름의 소스 파일처럼 출력 경로가 겹치면, 한 출력이 다른 출력을 덮어쓰지 않도록 오류로 처리합니다.
+	 * @return 메모리에 매핑된 소스 파일들과 각 소스 파일의 컴파일 설정입니다.
+	 * @exception ParsedCommandLine::Error 명령줄에 오류가 있거나 소스 파일을 열지 못했습니다.
 	 */
 	ProcessedType ProcessCommandLine(int argc, char** argv)
 	{
@@ -18,32 +50,130 @@ namespace Dlink
 			throw cmd_line_err.first;
 		}
 
-		std::string code_filename;
-		long long opt_level = 0;
+		std::vector<std::string> code_filenames;
+		bool emit_ir = false;
+		bool time_trace = false;
+		ProcessedType result;
 
 		for (auto cmd : cmd_line)
 		{
 			if (cmd.type == Dlink::ParsedCommandLine::Type::Input)
 			{
-				code_filename = *reinterpret_cast<std::string*>(cmd.x);
+				const std::string& code_filename = cmd.str;
+				if (std::find(code_filenames.begin(), code_filenames.end(), code_filename) == code_filenames.end())
+				{
+					code_filenames.push_back(code_filename);
+				}
 			}
 			else if(cmd.type == Dlink::ParsedCommandLine::Type::Optimize)
 			{
-				opt_level = cmd.x;
+				result.options.opt_level = cmd.x;
+			}
+			else if (cmd.type == Dlink::ParsedCommandLine::Type::Jobs)
+			{
+				result.options.thread_count = static_cast<std::size_t>(cmd.x);
+			}
+			else if (cmd.type == Dlink::ParsedCommandLine::Type::AST)
+			{
+				result.options.ast_format = static_cast<ASTDumpFormat>(cmd.x);
+			}
+			else if (cmd.type == Dlink::ParsedCommandLine::Type::Object)
+			{
+				result.options.object_path = cmd.str;
+			}
+			else if (cmd.type == Dlink::ParsedCommandLine::Type::Assembly)
+			{
+				result.options.assembly_path = cmd.str;
+			}
+			else if (cmd.type == Dlink::ParsedCommandLine::Type::Bitcode)
+			{
+				result.options.bitcode_path = cmd.str;
+			}
+			else if (cmd.type == Dlink::ParsedCommandLine::Type::Target)
+			{
+				result.options.target_triple = cmd.str;
+			}
+			else if (cmd.type == Dlink::ParsedCommandLine::Type::CPU)
+			{
+				result.options.target_cpu = cmd.str;
+			}
+			else if (cmd.type == Dlink::ParsedCommandLine::Type::Server)
+			{
+				result.is_server = true;
+			}
+			else if (cmd.type == Dlink::ParsedCommandLine::Type::SplitObject)
+			{
+				result.options.split_objects = true;
+			}
+			else if (cmd.type == Dlink::ParsedCommandLine::Type::Run)
+			{
+				result.options.run = true;
+			}
+			else if (cmd.type == Dlink::ParsedCommandLine::Type::Cache)
+			{
+				result.options.cache_directory = cmd.str;
+			}
+			else if (cmd.type == Dlink::ParsedCommandLine::Type::CacheSize)
+			{
+				result.options.cache_size = static_cast<std::uint64_t>(cmd.x) * 1024 * 1024;
+			}
+			else if (cmd.type == Dlink::ParsedCommandLine::Type::IR)
+			{
+				emit_ir = true;
+			}
+			else if (cmd.type == Dlink::ParsedCommandLine::Type::TimeTrace)
+			{
+				time_trace = true;
 			}
 		}
 
-		Dlink::opt_level = opt_level;
+		std::unordered_set<std::string> output_paths;
+		for (const std::string& code_filename : code_filenames)
+		{
+			SourceFile source;
+			if (!source.open(code_filename))
+			{
+				throw Dlink::ParsedCommandLine::Error::CouldntFind_Input;
+			}
+			result.sources.push_back(std::move(source));
 
-		std::ifstream code_file(code_filename);
-		std::string code((std::istreambuf_iterator<char>(code_file)), std::istreambuf_iterator<char>());
+			CompileOptions options = result.options;
+			if (code_filenames.size() > 1)
+			{
+				if (!options.object_path.empty())
+				{
+					options.object_path = output_in_directory(options.object_path, code_filename, ".o");
+				}
+				if (!options.assembly_path.empty())
+				{
+					options.assembly_path = output_in_directory(options.assembly_path, code_filename, ".s");
+				}
+				if (!options.bitcode_path.empty())
+				{
+					options.bitcode_path = output_in_directory(options.bitcode_path, code_filename, ".bc");
+				}
 
-		return code;
-	}
+				for (const std::string* path : { &options.object_path, &options.assembly_path, &options.bitcode_path })
+				{
+					if (!path->empty() && !output_paths.insert(*path).second)
+					{
+						throw Dlink::ParsedCommandLine::Error::Conflicting_Output;
+					}
+				}
+			}
+			if (emit_ir)
+			{
+				// LLVM IR 파일은 소스 파일의 확장자를 .ll로 바꾼 경로에 씁니다.
+				options.ir_path = replace_extension(code_filename, ".ll");
+			}
+			if (time_trace)
+			{
+				// 컴파일 시간 기록은 소스 파일의 확장자를 .trace.json으로 바꾼 경로에 씁니다.
+				options.time_trace_path = replace_extension(code_filename, ".trace.json");
+			}
+			result.source_options.push_back(std::move(options));
+		}
 
-	/**
-	 * @brief 최적화 레벨입니다.
-	 * @details 값을 임의로 변경하지 마십시오. 치명적인 오류가 발생할 수 있습니다.
-	 */
-	long long opt_level = 0;
+		return result;
+	}
 }
\ No newline at end of file
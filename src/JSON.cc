@@ -0,0 +1,52 @@
+#include "JSON.hh"
+
+namespace Dlink
+{
+	/**
+	 * @brief 문자열을 큰따옴표로 감싼 JSON 문자열로 이스케이프해 덧붙입니다.
+	 * @details 큰따옴표와 역슬래시, 제어 문자만 이스케이프하며, 그 외의 바이트는 UTF-8 그대로 씁니다.
+	 * @param output 이스케이프한 문자열을 덧붙일 문자열입니다.
+	 * @param text 이스케이프할 문자열입니다.
+	 */
+	void append_json_string(std::string& output, const std::string& text)
+	{
+		static const char hex[] = "0123456789abcdef";
+
+		output += '"';
+		for (char c : text)
+		{
+			switch (c)
+			{
+			case '"':
+				output += "\\\"";
+				break;
+			case '\\':
+				output += "\\\\";
+				break;
+			case '\n':
+				output += "\\n";
+				break;
+			case '\r':
+				output += "\\r";
+				break;
+			case '\t':
+				output += "\\t";
+				break;
+
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+				{
+					output += "\\u00";
+					output += hex[static_cast<unsigned char>(c) >> 4];
+					output += hex[static_cast<unsigned char>(c) & 0xF];
+				}
+				else
+				{
+					output += c;
+				}
+				break;
+			}
+		}
+		output += '"';
+	}
+}
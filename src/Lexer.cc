@@ -1,489 +1,430 @@
 #include "Lexer.hh"
+#include "Scanner.hh"
+#include "SourceManager.hh"
 
-#include <cctype>
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <utility>
 
 namespace Dlink
 {
 	/**
 	 * @brief 새 Lexer 인스턴스를 만듭니다.
-	 * @param code Dlink 코드입니다.
+	 * @details 토큰이 source의 버퍼를 가리키므로, 토큰을 사용하는 동안에는 source가 살아있어야 합니다.
+	 * @param source Dlink 코드가 담긴 버퍼입니다.
 	 */
-	Lexer::Lexer(const std::string& code)
-		: code_(code)
-	{
-		keyword_map_["unsafe"] = TokenType::unsafe;
-		keyword_map_["if"] = TokenType::_if;
-		keyword_map_["else"] = TokenType::_else;
-		keyword_map_["switch"] = TokenType::_switch;
-		keyword_map_["case"] = TokenType::_case;
-		keyword_map_["for"] = TokenType::_for;
-		keyword_map_["while"] = TokenType::_while;
-		keyword_map_["do"] = TokenType::_do;
-		keyword_map_["break"] = TokenType::_break;
-		keyword_map_["continue"] = TokenType::_continue;
-		keyword_map_["return"] = TokenType::_return;
-		keyword_map_["null"] = TokenType::_null;
-		keyword_map_["const"] = TokenType::_const;
-		
-		keyword_map_["unsigned"] = TokenType::_unsigned;
-		keyword_map_["signed"] = TokenType::_signed;
-		keyword_map_["char"] = TokenType::_char;
-		keyword_map_["short"] = TokenType::_short;
-		keyword_map_["int"] = TokenType::_int;
-		keyword_map_["long"] = TokenType::_long;
-		keyword_map_["void"] = TokenType::_void;
-	}
+	Lexer::Lexer(const SourceFile& source)
+		: source_(source), position_(0), end_(source.size()), in_comment_(false)
+	{}
+	/**
+	 * @brief 버퍼의 일부분만 렉싱하는 새 Lexer 인스턴스를 만듭니다.
+	 * @details 병렬 렉싱에서 조각 하나를 맡는 렉서를 만들 때 사용합니다.
+	 * @param source Dlink 코드가 담긴 버퍼입니다.
+	 * @param begin 렉싱을 시작할 위치입니다. 줄의 시작이어야 합니다.
+	 * @param end 렉싱을 끝낼 위치입니다.
+	 * @param in_comment begin이 여러 줄 주석 안에 있으면 true입니다.
+	 */
+	Lexer::Lexer(const SourceFile& source, std::size_t begin, std::size_t end, bool in_comment)
+		: source_(source), position_(begin), end_(end), in_comment_(in_comment)
+	{}
 
 	/**
-	 * @brief Dlink 코드에 대해 렉싱 작업을 수행합니다.
-	 * @details 생성자를 통해 입력받은 Dlink 코드를 사용합니다.
-	 * @see Dlink::Lexer::Lexer(const std::string&)
+	 * @brief Dlink 코드 전체에 대해 렉싱 작업을 수행하고 결과를 토큰 목록에 저장합니다.
+	 * @details 생성자를 통해 입력받은 SourceFile의 버퍼를 처음부터 다시 읽습니다. 토큰 목록이 필요하지 않다면 next_token 함수를 사용하십시오.
+	 * @see Dlink::Lexer::Lexer(const SourceFile&)
+	 * @see Dlink::Lexer::next_token()
 	 */
 	void Lexer::lex()
 	{
-		std::size_t line = 1, i = 0;
+		position_ = 0;
+		end_ = source_.size();
+		in_comment_ = false;
+
+		token_seq_.clear();
+
+		do
+		{
+			token_seq_.push_back(next_token());
+		} while (token_seq_.back().type != TokenType::eof);
+	}
+	/**
+	 * @brief Dlink 코드 전체를 여러 조각으로 나눠 병렬로 렉싱하고 결과를 토큰 목록에 저장합니다.
+	 * @details 줄바꿈 바로 뒤에서만 코드를 나누며, 문자열과 한 줄 주석은 줄바꿈을 넘지 않으므로 각 조각의 시작이 여러 줄 주석 안인지만 알면 됩니다.
+	 * 먼저 각 조각을 주석 밖에서 시작한 경우와 안에서 시작한 경우로 나눠 가볍게 훑어보고, 그 결과를 앞에서부터 이어 붙여 조각마다 시작 상태를 정합니다.
+	 * 그 뒤 조각들을 thread_pool에서 렉싱하고 하나의 토큰 목록으로 합칩니다. 토큰은 오프셋만 저장하므로 보정할 필요가 없습니다. 결과는 lex() 함수와 같습니다.
+	 * 코드가 parallel_threshold보다 작거나 작업 스레드가 하나뿐이라면 lex() 함수를 호출합니다.
+	 * @param thread_pool 렉싱 작업을 나눠 맡을 스레드 풀입니다.
+	 * @see Dlink::Lexer::lex()
+	 */
+	void Lexer::lex(ThreadPool& thread_pool)
+	{
+		const char* code = source_.data();
+		const std::size_t size = source_.size();
+
+		if (size < parallel_threshold || thread_pool.size() <= 1)
+		{
+			lex();
+			return;
+		}
 
-		std::stringstream input_stream(code_);
-		std::string cur_line;
+		// 작업량이 고르지 않을 수 있으므로 스레드보다 조금 더 잘게 나눕니다.
+		const std::size_t chunk_goal = thread_pool.size() * 4;
 
-		bool inline_comment = false;
-		bool multi_line_comment = false;
+		std::vector<std::size_t> bounds = { 0 };
+		for (std::size_t i = 1; i < chunk_goal; ++i)
+		{
+			std::size_t target = size / chunk_goal * i;
+			if (target < bounds.back()) continue;
+
+			const void* newline = std::memchr(code + target, '\n', size - target);
+			if (!newline) break;
+
+			std::size_t bound = static_cast<std::size_t>(static_cast<const char*>(newline) - code) + 1;
+			if (bound < size) bounds.push_back(bound);
+		}
+		bounds.push_back(size);
 
-		while (std::getline(input_stream, cur_line, '\n'))
+		const std::size_t chunk_count = bounds.size() - 1;
+
+		// 조각마다 주석 밖/안에서 시작했을 때 끝나는 상태를 구합니다.
+		std::vector<std::future<std::pair<bool, bool>>> prescans;
+		prescans.reserve(chunk_count);
+		for (std::size_t i = 0; i < chunk_count; ++i)
 		{
-			for (i = 0; i < cur_line.length(); i++)
+			std::size_t begin = bounds[i], end = bounds[i + 1];
+			prescans.push_back(thread_pool.submit([code, begin, end]()
 			{
-				char ch = cur_line[i];
+				return std::make_pair(prescan_(code, begin, end, false), prescan_(code, begin, end, true));
+			}));
+		}
 
-				if (std::isalpha(ch))
-				{
-					std::string temp = "";
-					do
-					{
-						temp += cur_line[i];
-						i++;
-					} while (std::isalpha(cur_line[i]) || std::isdigit(cur_line[i]) || cur_line[i] == '_');
+		std::vector<bool> in_comment(chunk_count, false);
+		for (std::size_t i = 0; i + 1 < chunk_count; ++i)
+		{
+			std::pair<bool, bool> end_state = prescans[i].get();
+			in_comment[i + 1] = in_comment[i] ? end_state.second : end_state.first;
+		}
 
-					i--;
+		// 조각을 렉싱합니다. 마지막 조각을 제외하고는 eof 토큰을 버립니다.
+		std::vector<std::future<TokenSeq>> chunks;
+		chunks.reserve(chunk_count);
+		for (std::size_t i = 0; i < chunk_count; ++i)
+		{
+			std::size_t begin = bounds[i], end = bounds[i + 1];
+			bool chunk_in_comment = in_comment[i], is_last = i + 1 == chunk_count;
+			chunks.push_back(thread_pool.submit([this, begin, end, chunk_in_comment, is_last]()
+			{
+				Lexer lexer(source_, begin, end, chunk_in_comment);
+				TokenSeq token_seq;
 
-					bool is_keyword = (keyword_map_.find(temp) != keyword_map_.end());
+				while (true)
+				{
+					Token token = lexer.next_token();
+					if (token.type == TokenType::eof && !is_last) break;
 
-					if (is_keyword)
-					{
-						Token keyword_token(temp, keyword_map_[temp], line, i + 1);
-						if (!multi_line_comment) token_seq_.push_back(keyword_token);
-					}
-					else
-					{
-						Token identifier_token(temp, TokenType::identifier, line, i + 1);
-						if (!multi_line_comment) token_seq_.push_back(identifier_token);
-					}
+					token_seq.push_back(token);
+					if (token.type == TokenType::eof) break;
 				}
-				else if (std::isdigit(ch))
+
+				return token_seq;
+			}));
+		}
+
+		std::vector<TokenSeq> results;
+		results.reserve(chunk_count);
+		for (auto& chunk : chunks)
+		{
+			results.push_back(chunk.get());
+		}
+
+		// 각 조각의 토큰이 들어갈 위치를 구한 뒤, 조각별로 나눠 복사합니다.
+		std::vector<std::size_t> token_offsets(chunk_count + 1, 0);
+		for (std::size_t i = 0; i < chunk_count; ++i)
+		{
+			token_offsets[i + 1] = token_offsets[i] + results[i].size();
+		}
+
+		token_seq_.clear();
+		token_seq_.resize(token_offsets.back());
+
+		std::vector<std::future<void>> copies;
+		copies.reserve(chunk_count);
+		for (std::size_t i = 0; i < chunk_count; ++i)
+		{
+			copies.push_back(thread_pool.submit([this, &results, &token_offsets, i]()
+			{
+				std::copy(results[i].begin(), results[i].end(), token_seq_.begin() + token_offsets[i]);
+			}));
+		}
+		for (auto& copy : copies)
+		{
+			copy.get();
+		}
+
+		position_ = size;
+		end_ = size;
+		in_comment_ = false;
+	}
+	/**
+	 * @brief 다음 토큰 하나를 렉싱합니다.
+	 * @details 버퍼를 그대로 읽으며, 토큰마다 문자열을 할당하지 않습니다. 버퍼의 끝에 도달하면 TokenType::eof 토큰을 계속해서 반환합니다.
+	 * @return 렉싱한 토큰을 반환합니다.
+	 */
+	Token Lexer::next_token()
+	{
+		const char* code = source_.data();
+		const std::size_t size = end_;
+
+		std::size_t& i = position_;
+
+		// 버퍼는 null 문자로 끝나지 않을 수 있으므로 끝을 넘어서 읽으면 '\0'으로 취급합니다.
+		auto at = [code, size](std::size_t index)
+		{
+			return index < size ? code[index] : '\0';
+		};
+		auto make_token = [](TokenType type, std::size_t begin, std::size_t end)
+		{
+			return Token(static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(end - begin), type);
+		};
+		auto is_alpha = [](char ch)
+		{
+			return is_char_class(ch, char_alpha);
+		};
+		auto is_digit = [](char ch)
+		{
+			return is_char_class(ch, char_digit);
+		};
+		// scan_* 함수들은 포인터를 주고받으므로 오프셋으로 바꿔줍니다.
+		auto scan = [code, size](const char* (*scanner)(const char*, const char*), std::size_t begin)
+		{
+			return begin < size ? static_cast<std::size_t>(scanner(code + begin, code + size) - code) : begin;
+		};
+
+		if (in_comment_)
+		{
+			in_comment_ = false;
+			skip_comment_();
+		}
+
+		while (i < size)
+		{
+			char ch = code[i];
+
+			if (is_char_class(ch, char_space))
+			{
+				i = scan(scan_space, i + 1);
+			}
+			else if (is_alpha(ch))
+			{
+				std::size_t begin = i;
+				i = scan(scan_identifier, i + 1);
+
+				Token token = make_token(keyword_type(code + begin, i - begin), begin, i);
+				if (token.type == TokenType::identifier)
 				{
-					std::string temp = "";
+					token.symbol = Symbol::intern(code + begin, i - begin);
+				}
 
-					if (ch == '0' && i < cur_line.length() - 2)
-					{
-						char next_ch = cur_line[i + 1];
-						switch (next_ch)
-						{
-						case 'b':
-						case 'B':
-							temp += '0';
-							temp += next_ch;
-							i += 2;
-
-							do
-							{
-								temp += cur_line[i];
-								i++;
-							} while (cur_line[i] == '0' || cur_line[i] == '1');
-							i--;
-
-							if (!multi_line_comment) token_seq_.push_back(Token(temp, TokenType::bin_integer, line, i + 1));
-							break;
-
-						case '0':
-						case '1':
-						case '2':
-						case '3':
-						case '4':
-						case '5':
-						case '6':
-						case '7':
-							temp += '0';
-							i++;
-
-							do
-							{
-								temp += cur_line[i];
-								i++;
-							} while (('0' <= cur_line[i]) && (cur_line[i] <= '7'));
-							i--;
-
-							if (!multi_line_comment) token_seq_.push_back(Token(temp, TokenType::oct_integer, line, i + 1));
-							break;
-
-						case 'x':
-						case 'X':
-							temp += '0';
-							temp += next_ch;
-							i += 2;
-
-							do
-							{
-								temp += cur_line[i];
-								i++;
-							} while (i < cur_line.length() && (std::isdigit(cur_line[i]) ||
-								(('a' <= cur_line[i]) && (cur_line[i] <= 'f')) ||
-								(('A' <= cur_line[i]) && (cur_line[i] <= 'F'))));
-							i--;
-
-							if (!multi_line_comment) token_seq_.push_back(Token(temp, TokenType::hex_integer, line, i + 1));
-							break;
-
-						default:
-							if (!multi_line_comment) token_seq_.push_back(Token("0", TokenType::dec_integer, line, i + 1));
-							break;
-						}
-					}
-					else
-					{
-						do
-						{
-							temp += cur_line[i];
-							i++;
-						} while (i < cur_line.length() && std::isdigit(cur_line[i]));
+				return token;
+			}
+			else if (is_digit(ch))
+			{
+				std::size_t begin = i;
+				char next_ch = at(i + 1);
 
-						if (cur_line[i] == '.')
-						{
-							do
-							{
-								temp += cur_line[i];
-								i++;
-							} while (i < cur_line.length() && std::isdigit(cur_line[i]));
-
-							if (cur_line[i] == 'e' && (cur_line[i + 1] == '-' || cur_line[i + 1] == '+'))
-							{
-								temp += 'e';
-								temp += cur_line[i + 1];
-								i += 2;
-								do
-								{
-									temp += cur_line[i];
-									i++;
-								} while (i < cur_line.length() && std::isdigit(cur_line[i]));
-							}
-
-							if (!multi_line_comment) token_seq_.push_back(Token(temp, TokenType::floating, line, i));
-						}
-						else
-						{
-							if (!multi_line_comment) token_seq_.push_back(Token(temp, TokenType::dec_integer, line, i));
-						}
-						i--;
-					}
+				if (ch == '0' && (next_ch == 'b' || next_ch == 'B'))
+				{
+					i += 2;
+					while (at(i) == '0' || at(i) == '1') i++;
+
+					return make_token(TokenType::bin_integer, begin, i);
 				}
-				else if (ch == '\"')
+				else if (ch == '0' && ('0' <= next_ch && next_ch <= '7'))
 				{
-					std::string temp = "";
 					i++;
+					while ('0' <= at(i) && at(i) <= '7') i++;
 
-					while (cur_line[i] != '\"')
-					{
-						if (cur_line[i] == '\\')
-						{
-							if (i < cur_line.length() - 2 && cur_line[i + 1] == '\"')
-							{
-								temp += '\"';
-								i += 2;
-								continue;
-							}
-						}
-
-						temp += cur_line[i];
-						i++;
-					}
+					return make_token(TokenType::oct_integer, begin, i);
+				}
+				else if (ch == '0' && (next_ch == 'x' || next_ch == 'X'))
+				{
+					i += 2;
+					while (is_char_class(at(i), char_hex)) i++;
 
-					if (!multi_line_comment) token_seq_.push_back(Token(temp, TokenType::string, line, i - 1));
+					return make_token(TokenType::hex_integer, begin, i);
 				}
-				else if (ch == '\'')
+				else
 				{
-					std::string temp = "";
-					i++;
+					i = scan(scan_digits, i + 1);
 
-					while (cur_line[i] != '\'')
+					if (at(i) == '.')
 					{
-						if (cur_line[i] == '\\')
+						i = scan(scan_digits, i + 1);
+
+						if (at(i) == 'e' && (at(i + 1) == '-' || at(i + 1) == '+'))
 						{
-							if (i < cur_line.length() - 2 && cur_line[i + 1] == '\'')
-							{
-								temp += '\'';
-								i += 2;
-								continue;
-							}
+							i = scan(scan_digits, i + 2);
 						}
 
-						temp += cur_line[i];
-						i++;
+						return make_token(TokenType::floating, begin, i);
 					}
+					else
+					{
+						return make_token(TokenType::dec_integer, begin, i);
+					}
+				}
+			}
+			else if (ch == '\"' || ch == '\'')
+			{
+				// 이스케이프 시퀀스는 그대로 남겨두고, 파서에서 해석합니다.
+				std::size_t begin = ++i;
 
-					if (!multi_line_comment) token_seq_.push_back(Token(temp, TokenType::character, line, i - 1));
+				while (i < size && code[i] != ch && code[i] != '\n')
+				{
+					i += (code[i] == '\\' && at(i + 1) != '\n') ? 2 : 1;
 				}
-				else
+				if (i > size) i = size;
+
+				Token token = make_token(ch == '\"' ? TokenType::string : TokenType::character, begin, i);
+				if (at(i) == ch) i++;
+
+				return token;
+			}
+			else
+			{
+				std::size_t begin = i;
+				char next_ch = at(i + 1);
+
+				switch (ch)
 				{
-					switch (ch)
+				case '+':
+					if (next_ch == '+') return make_token(TokenType::increment, begin, i += 2);
+					else if (next_ch == '=') return make_token(TokenType::plus_assign, begin, i += 2);
+					else return make_token(TokenType::plus, begin, ++i);
+					break;
+				case '-':
+					if (next_ch == '-') return make_token(TokenType::decrement, begin, i += 2);
+					else if (next_ch == '=') return make_token(TokenType::minus_assign, begin, i += 2);
+					else return make_token(TokenType::minus, begin, ++i);
+					break;
+				case '*':
+					if (next_ch == '=') return make_token(TokenType::multiply_assign, begin, i += 2);
+					else if (next_ch == '/') i += 2;
+					else return make_token(TokenType::multiply, begin, ++i);
+					break;
+				case '/':
+					if (next_ch == '=')
 					{
-					case '+':
-						if (cur_line[i + 1] == '+')
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("++", TokenType::increment, line, i + 1));
-						}
-						else if (cur_line[i + 1] == '=')
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("+=", TokenType::plus_assign, line, i + 1));
-						}
-						else
-						{
-							if (!multi_line_comment) token_seq_.push_back(Token("+", TokenType::plus, line, i + 1));
-						}
-						break;
-					case '-':
-						if (cur_line[i + 1] == '-')
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("--", TokenType::decrement, line, i + 1));
-						}
-						else if (cur_line[i + 1] == '=')
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("-=", TokenType::minus_assign, line, i + 1));
-						}
-						else
-						{
-							if (!multi_line_comment) token_seq_.push_back(Token("-", TokenType::minus, line, i + 1));
-						}
-						break;
-					case '*':
-						if (cur_line[i + 1] == '=')
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("*=", TokenType::multiply_assign, line, i + 1));
-						}
-						else if (cur_line[i + 1] == '/')
-						{
-							i++;
-							multi_line_comment = false;
-						}
-						else
-						{
-							if (!multi_line_comment) token_seq_.push_back(Token("*", TokenType::multiply, line, i + 1));
-						}
-						break;
-					case '/':
-						if (cur_line[i + 1] == '=')
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("/=", TokenType::divide_assign, line, i + 1));
-						}
-						else if (cur_line[i + 1] == '/')
-						{
-							i++;
-							inline_comment = true;
-						}
-						else if (cur_line[i + 1] == '*')
-						{
-							i++;
-							multi_line_comment = true;
-						}
-						else
-						{
-							if (!multi_line_comment) token_seq_.push_back(Token("/", TokenType::divide, line, i + 1));
-						}
-						break;
-					case '%':
-						if (cur_line[i + 1] == '=')
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("%=", TokenType::modulo_assign, line, i + 1));
-						}
-						else
-						{
-							if (!multi_line_comment) token_seq_.push_back(Token("%", TokenType::modulo, line, i + 1));
-						}
-						break;
-					case '=':
-						if (cur_line[i + 1] != '=')
-						{
-							if (!multi_line_comment) token_seq_.push_back(Token("=", TokenType::assign, line, i + 1));
-						}
-						else
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("==", TokenType::equal, line, i + 1));
-						}
-						break;
-					case '>':
-						if (cur_line[i + 1] == '=')
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token(">=", TokenType::eqless, line, i + 1));
-						}
-						else if (cur_line[i + 1] == '>')
-						{
-							i++;
-							if (cur_line[i + 2] == '=')
-							{
-								i++;
-								if (!multi_line_comment) token_seq_.push_back(Token(">>=", TokenType::bit_lshift_assign, line, i + 1));
-							}
-							else
-							{
-								if (!multi_line_comment) token_seq_.push_back(Token(">>", TokenType::bit_lshift, line, i + 1));
-							}
-						}
-						else
-						{
-							if (!multi_line_comment) token_seq_.push_back(Token(">", TokenType::less, line, i + 1));
-						}
-						break;
-					case '<':
-						if (cur_line[i + 1] == '=')
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("<=", TokenType::eqless, line, i + 1));
-						}
-						else if (cur_line[i + 1] == '<')
-						{
-							i++;
-							if (cur_line[i + 2] == '=')
-							{
-								i++;
-								if (!multi_line_comment) token_seq_.push_back(Token("<<=", TokenType::bit_rshift_assign, line, i + 1));
-							}
-							else
-							{
-								if (!multi_line_comment) token_seq_.push_back(Token("<<", TokenType::bit_rshift, line, i + 1));
-							}
-						}
-						else
-						{
-							if (!multi_line_comment) token_seq_.push_back(Token("<", TokenType::less, line, i + 1));
-						}
-						break;
-					case '&':
-						if (cur_line[i + 1] == '&')
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("&&", TokenType::logic_and, line, i + 1));
-						}
-						else if (cur_line[i + 1] == '=')
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("&=", TokenType::bit_and_assign, line, i + 1));
-						}
-						else
-						{
-							if (!multi_line_comment) token_seq_.push_back(Token("&", TokenType::bit_and, line, i + 1));
-						}
-						break;
-					case '|':
-						if (cur_line[i + 1] == '|')
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("||", TokenType::logic_or, line, i + 1));
-						}
-						else if (cur_line[i + 1] == '=')
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("|=", TokenType::bit_or_assign, line, i + 1));
-						}
-						else
-						{
-							if (!multi_line_comment) token_seq_.push_back(Token("|", TokenType::bit_or, line, i + 1));
-						}
-						break;
-					case '~':
-						if (!multi_line_comment) token_seq_.push_back(Token("~", TokenType::bit_not, line, i + 1));
-						break;
-					case '^':
-						if (cur_line[i + 1] == '=')
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("^=", TokenType::bit_xor_assign, line, i + 1));
-						}
-						else
-						{
-							if (!multi_line_comment) token_seq_.push_back(Token("^", TokenType::bit_xor, line, i + 1));
-						}
-						break;
-					case '{':
-						if (!multi_line_comment) token_seq_.push_back(Token("{", TokenType::lbrace, line, i + 1));
-						break;
-					case '}':
-						if (!multi_line_comment) token_seq_.push_back(Token("}", TokenType::rbrace, line, i + 1));
-						break;
-					case '(':
-						if (!multi_line_comment) token_seq_.push_back(Token("(", TokenType::lparen, line, i + 1));
-						break;
-					case ')':
-						if (!multi_line_comment) token_seq_.push_back(Token(")", TokenType::rparen, line, i + 1));
-						break;
-					case '[':
-						if (!multi_line_comment) token_seq_.push_back(Token("[", TokenType::lbparen, line, i + 1));
-						break;
-					case ']':
-						if (!multi_line_comment) token_seq_.push_back(Token("]", TokenType::rbparen, line, i + 1));
-						break;
-					case '.':
-						if (!multi_line_comment) token_seq_.push_back(Token(".", TokenType::dot, line, i + 1));
-						break;
-					case ',':
-						if (!multi_line_comment) token_seq_.push_back(Token(",", TokenType::comma, line, i + 1));
-						break;
-					case '\'':
-						if (!multi_line_comment) token_seq_.push_back(Token("\'", TokenType::apostrophe, line, i + 1));
-						break;
-					case ';':
-						if (!multi_line_comment) token_seq_.push_back(Token(";", TokenType::semicolon, line, i + 1));
-						break;
-					case ':':
-						if (cur_line[i + 1] != ':')
-						{
-							if (!multi_line_comment) token_seq_.push_back(Token(":", TokenType::colon, line, i + 1));
-						}
-						break;
-					case '!':
-						if (cur_line[i + 1] != '=')
-						{
-							if (!multi_line_comment) token_seq_.push_back(Token("!", TokenType::exclamation, line, i + 1));
-						}
-						else
-						{
-							i++;
-							if (!multi_line_comment) token_seq_.push_back(Token("!=", TokenType::noteq, line, i + 1));
-						}
-						break;
-					case '?':
-						if (!multi_line_comment) token_seq_.push_back(Token("?", TokenType::question, line, i + 1));
-						break;
+						return make_token(TokenType::divide_assign, begin, i += 2);
 					}
-
-					if (inline_comment)
+					else if (next_ch == '/')
 					{
-						inline_comment = false;
-						break;
+						const void* newline = std::memchr(code + i, '\n', size - i);
+						i = newline ? static_cast<std::size_t>(static_cast<const char*>(newline) - code) : size;
 					}
+					else if (next_ch == '*')
+					{
+						i += 2;
+						skip_comment_();
+					}
+					else
+					{
+						return make_token(TokenType::divide, begin, ++i);
+					}
+					break;
+				case '%':
+					if (next_ch == '=') return make_token(TokenType::modulo_assign, begin, i += 2);
+					else return make_token(TokenType::modulo, begin, ++i);
+					break;
+				case '=':
+					if (next_ch == '=') return make_token(TokenType::equal, begin, i += 2);
+					else return make_token(TokenType::assign, begin, ++i);
+					break;
+				case '>':
+					if (next_ch == '=') return make_token(TokenType::eqgreater, begin, i += 2);
+					else if (next_ch == '>' && at(i + 2) == '=') return make_token(TokenType::bit_rshift_assign, begin, i += 3);
+					else if (next_ch == '>') return make_token(TokenType::bit_rshift, begin, i += 2);
+					else return make_token(TokenType::greater, begin, ++i);
+					break;
+				case '<':
+					if (next_ch == '=') return make_token(TokenType::eqless, begin, i += 2);
+					else if (next_ch == '<' && at(i + 2) == '=') return make_token(TokenType::bit_lshift_assign, begin, i += 3);
+					else if (next_ch == '<') return make_token(TokenType::bit_lshift, begin, i += 2);
+					else return make_token(TokenType::less, begin, ++i);
+					break;
+				case '&':
+					if (next_ch == '&') return make_token(TokenType::logic_and, begin, i += 2);
+					else if (next_ch == '=') return make_token(TokenType::bit_and_assign, begin, i += 2);
+					else return make_token(TokenType::bit_and, begin, ++i);
+					break;
+				case '|':
+					if (next_ch == '|') return make_token(TokenType::logic_or, begin, i += 2);
+					else if (next_ch == '=') return make_token(TokenType::bit_or_assign, begin, i += 2);
+					else return make_token(TokenType::bit_or, begin, ++i);
+					break;
+				case '~':
+					return make_token(TokenType::bit_not, begin, ++i);
+					break;
+				case '^':
+					if (next_ch == '=') return make_token(TokenType::bit_xor_assign, begin, i += 2);
+					else return make_token(TokenType::bit_xor, begin, ++i);
+					break;
+				case '{':
+					return make_token(TokenType::lbrace, begin, ++i);
+					break;
+				case '}':
+					return make_token(TokenType::rbrace, begin, ++i);
+					break;
+				case '(':
+					return make_token(TokenType::lparen, begin, ++i);
+					break;
+				case ')':
+					return make_token(TokenType::rparen, begin, ++i);
+					break;
+				case '[':
+					return make_token(TokenType::lbparen, begin, ++i);
+					break;
+				case ']':
+					return make_token(TokenType::rbparen, begin, ++i);
+					break;
+				case '.':
+					return make_token(TokenType::dot, begin, ++i);
+					break;
+				case ',':
+					return make_token(TokenType::comma, begin, ++i);
+					break;
+				case ';':
+					return make_token(TokenType::semicolon, begin, ++i);
+					break;
+				case ':':
+					if (next_ch != ':') return make_token(TokenType::colon, begin, ++i);
+					else i++;
+					break;
+				case '!':
+					if (next_ch == '=') return make_token(TokenType::noteq, begin, i += 2);
+					else return make_token(TokenType::exclamation, begin, ++i);
+					break;
+				case '?':
+					return make_token(TokenType::question, begin, ++i);
+					break;
+				default:
+					i++;
+					break;
 				}
 			}
-
-			line++;
 		}
 
-		if (!multi_line_comment) token_seq_.push_back(Token("", TokenType::eof, line, i));
+		return make_token(TokenType::eof, size, size);
+	}
+	/**
+	 * @brief 렉서가 읽고 있는 소스 버퍼를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 소스 버퍼를 반환합니다.
+	 */
+	const SourceFile& Lexer::get_source() const noexcept
+	{
+		return source_;
 	}
 	/**
 	 * @brief 렉싱 작업을 수행한 결과를 가져옵니다.
@@ -507,10 +448,79 @@ namespace Dlink
 	 */
 	void Lexer::dump(std::ostream& out) const
 	{
+		SourceManager source_manager(source_);
+
 		for (const Token& token : token_seq_)
 		{
-			out << "Line " << token.line << " Col " << token.col
-				<< " -> " << token_map.at(token.type) << "(" << token.data << ")\n";
+			SourceLocation location = source_manager.location(token);
+			out << "Line " << location.line << " Col " << location.col
+				<< " -> " << token_map.at(token.type) << "(";
+			out.write(source_.data() + token.offset, token.length);
+			out << ")\n";
+		}
+	}
+
+	void Lexer::skip_comment_()
+	{
+		const char* code = source_.data();
+		const std::size_t end = static_cast<std::size_t>(find_comment_end(code + position_, code + end_) - code);
+
+		position_ = end < end_ ? end + 2 : end_;
+	}
+	// next_token 함수와 같은 규칙으로 문자열, 한 줄 주석, 여러 줄 주석만 따라가며 [begin, end)의 끝에서 여러 줄 주석 안에 있는지 구합니다.
+	bool Lexer::prescan_(const char* code, std::size_t begin, std::size_t end, bool in_comment) noexcept
+	{
+		std::size_t i = begin;
+
+		auto at = [code, end](std::size_t index)
+		{
+			return index < end ? code[index] : '\0';
+		};
+		auto skip_comment = [code, end, &i]()
+		{
+			std::size_t comment_end = static_cast<std::size_t>(find_comment_end(code + i, code + end) - code);
+			if (comment_end == end) return false;
+
+			i = comment_end + 2;
+			return true;
+		};
+
+		if (in_comment && !skip_comment()) return true;
+
+		while (i < end)
+		{
+			char ch = code[i];
+			char next_ch = at(i + 1);
+
+			if (ch == '\"' || ch == '\'')
+			{
+				++i;
+				while (i < end && code[i] != ch && code[i] != '\n')
+				{
+					i += (code[i] == '\\' && at(i + 1) != '\n') ? 2 : 1;
+				}
+				if (at(i) == ch) i++;
+			}
+			else if (ch == '/' && next_ch == '/')
+			{
+				const void* newline = std::memchr(code + i, '\n', end - i);
+				i = newline ? static_cast<std::size_t>(static_cast<const char*>(newline) - code) : end;
+			}
+			else if (ch == '/' && next_ch == '*')
+			{
+				i += 2;
+				if (!skip_comment()) return true;
+			}
+			else if ((ch == '*' && next_ch == '/') || (ch == '/' && next_ch == '='))
+			{
+				i += 2;
+			}
+			else
+			{
+				i++;
+			}
 		}
+
+		return false;
 	}
 }
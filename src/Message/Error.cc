@@ -32,8 +32,7 @@ namespace Dlink
 			const Token& old_token = old_error.message_token();
 
 			if (error.what() == old_error.what() &&
-				error_token.line == old_token.line &&
-				error_token.col == old_token.col)
+				error_token.offset == old_token.offset)
 			{
 				return;
 			}
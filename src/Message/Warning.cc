@@ -32,8 +32,7 @@ namespace Dlink
 			const Token& old_token = old_warning.message_token();
 
 			if (warning.what() == old_warning.what() &&
-				warning_token.line == old_token.line &&
-				warning_token.col == old_token.col)
+				warning_token.offset == old_token.offset)
 			{
 				return;
 			}
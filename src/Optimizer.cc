@@ -0,0 +1,170 @@
+#include "Optimizer.hh"
+#include "Target.hh"
+
+#include <string>
+
+#include "llvm/ADT/Any.h"
+#include "llvm/Analysis/LazyCallGraph.h"
+#include "llvm/Analysis/LoopInfo.h"
+
+namespace Dlink
+{
+	namespace
+	{
+		std::string ir_name(const llvm::Any& ir)
+		{
+			if (llvm::any_isa<const llvm::Function*>(ir))
+				return llvm::any_cast<const llvm::Function*>(ir)->getName().str();
+			if (llvm::any_isa<const llvm::Loop*>(ir))
+				return llvm::any_cast<const llvm::Loop*>(ir)->getHeader()->getParent()->getName().str();
+			if (llvm::any_isa<const llvm::LazyCallGraph::SCC*>(ir))
+				return llvm::any_cast<const llvm::LazyCallGraph::SCC*>(ir)->getName();
+			if (llvm::any_isa<const llvm::Module*>(ir))
+				return llvm::any_cast<const llvm::Module*>(ir)->getName().str();
+			return std::string();
+		}
+	}
+
+	/**
+	 * @brief 새 Optimizer 인스턴스를 만듭니다.
+	 * @details 최적화 레벨이 0이라면 아무 파이프라인도 만들지 않습니다. 아니라면 대상 머신을 만들어 PassBuilder에 전달하므로, 벡터화와 인라이닝이 대상 머신의 비용 모델을 사용합니다. 대상 머신을 만들지 못했다면 대상 머신 없이 최적화합니다.
+	 * 루프 벡터화와 SLP 벡터화, 루프 인터리빙은 최적화 레벨이 2 이상일 때만 사용합니다.
+	 * @param options 컴파일 설정입니다.
+	 * @param is_function_only true라면 함수 단위 단순화 파이프라인만 만들고, optimize_module 함수는 아무 작업도 하지 않습니다.
+	 */
+	Optimizer::Optimizer(const CompileOptions& options, bool is_function_only)
+		: options_(options), is_function_only_(is_function_only)
+	{
+		if (!is_enabled())
+			return;
+
+		std::string error;
+		target_machine_ = create_target_machine(options_, error);
+
+		llvm::PipelineTuningOptions tuning_options;
+		tuning_options.LoopInterleaving = options_.opt_level >= 2;
+		tuning_options.LoopVectorization = options_.opt_level >= 2;
+		tuning_options.SLPVectorization = options_.opt_level >= 2;
+
+		register_instrumentation_();
+
+		pass_builder_ = std::make_unique<llvm::PassBuilder>(target_machine_.get(), tuning_options, llvm::None, &instrumentation_);
+		pass_builder_->registerModuleAnalyses(module_am_);
+		pass_builder_->registerCGSCCAnalyses(cgscc_am_);
+		pass_builder_->registerFunctionAnalyses(function_am_);
+		pass_builder_->registerLoopAnalyses(loop_am_);
+		pass_builder_->crossRegisterProxies(loop_am_, function_am_, cgscc_am_, module_am_);
+
+		function_pm_ = pass_builder_->buildFunctionSimplificationPipeline(level_(), llvm::ThinOrFullLTOPhase::None);
+		if (!is_function_only_)
+		{
+			module_pm_ = pass_builder_->buildPerModuleDefaultPipeline(level_());
+		}
+	}
+
+	/**
+	 * @brief 모듈에 대상 머신의 트리플과 데이터 레이아웃을 설정합니다.
+	 * @details 최적화 패스들은 데이터 레이아웃으로 타입의 크기와 정렬을 계산하므로, 모듈에 코드를 만들기 전에 호출해야 합니다. 대상 머신이 없다면 아무 작업도 하지 않습니다.
+	 * @param module 설정할 모듈입니다.
+	 */
+	void Optimizer::configure_module(llvm::Module& module) const
+	{
+		if (!target_machine_)
+			return;
+
+		module.setTargetTriple(target_machine_->getTargetTriple().str());
+		module.setDataLayout(target_machine_->createDataLayout());
+	}
+	/**
+	 * @brief 코드를 다 만든 함수 하나를 단순화합니다.
+	 * @details SROA와 mem2reg, 명령어 결합, 루프 단순화 등 함수 단위 단순화 파이프라인을 실행합니다. 함수마다 코드를 만든 직후 호출하므로, 병렬로 코드를 만들 때는 이 작업도 작업 스레드에서 나눠서 실행됩니다.
+	 * 실행한 뒤에는 함수의 분석 결과를 버리므로, 이후 optimize_module 함수가 같은 함수를 다시 분석합니다.
+	 * @param function 단순화할 함수입니다.
+	 */
+	void Optimizer::optimize_function(llvm::Function& function)
+	{
+		if (!pass_builder_)
+			return;
+
+		TimeTrace::Scope scope(time_trace_, "Optimizer::optimize_function", function.getName().str());
+		function_pm_.run(function, function_am_);
+		function_am_.clear(function, function.getName());
+	}
+	/**
+	 * @brief 모듈 전체를 최적화 레벨에 맞는 파이프라인으로 최적화합니다.
+	 * @details 함수 인라이닝과 함수 속성 추론, 상수 전파 등 프로시저 간 최적화와 LICM, 루프 벡터화, SLP 벡터화를 포함한 파이프라인을 실행합니다. 4 이상의 최적화 레벨은 3과 같습니다. 함수 단위 파이프라인만 만든 인스턴스라면 아무 작업도 하지 않습니다.
+	 * @param module 최적화할 모듈입니다.
+	 */
+	void Optimizer::optimize_module(llvm::Module& module)
+	{
+		if (!pass_builder_ || is_function_only_)
+			return;
+
+		TimeTrace::Scope scope(time_trace_, "Optimizer::optimize_module");
+		module_pm_.run(module, module_am_);
+		module_am_.clear();
+		cgscc_am_.clear();
+		function_am_.clear();
+		loop_am_.clear();
+	}
+	/**
+	 * @brief 최적화를 하는지 확인합니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 최적화 레벨이 1 이상이면 true를, 아니라면 false를 반환합니다.
+	 */
+	bool Optimizer::is_enabled() const noexcept
+	{
+		return options_.opt_level > 0;
+	}
+	/**
+	 * @brief 최적화에 걸린 시간을 기록할 TimeTrace 인스턴스를 설정합니다.
+	 * @details 설정하면 optimize_function과 optimize_module 함수, 그리고 실행되는 각 패스의 시간을 기록합니다. 패스의 이벤트에는 패스가 처리한 함수나 모듈의 이름을 함께 기록합니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param time_trace 시간을 기록할 TimeTrace 인스턴스입니다. nullptr이면 기록하지 않습니다.
+	 */
+	void Optimizer::set_time_trace(TimeTrace* time_trace) noexcept
+	{
+		time_trace_ = time_trace;
+		pass_begins_.clear();
+	}
+
+	llvm::PassBuilder::OptimizationLevel Optimizer::level_() const noexcept
+	{
+		if (options_.opt_level == 1)
+		{
+			return llvm::PassBuilder::OptimizationLevel::O1;
+		}
+		else if (options_.opt_level == 2)
+		{
+			return llvm::PassBuilder::OptimizationLevel::O2;
+		}
+		return llvm::PassBuilder::OptimizationLevel::O3;
+	}
+	void Optimizer::register_instrumentation_()
+	{
+		// 파이프라인은 여러 컴파일 작업에서 다시 사용하므로, 콜백은 호출될 때마다 현재 설정된 TimeTrace 인스턴스를 확인합니다.
+		instrumentation_.registerBeforeNonSkippedPassCallback([this](llvm::StringRef, llvm::Any)
+		{
+			if (time_trace_)
+			{
+				pass_begins_.push_back(time_trace_->now());
+			}
+		});
+		instrumentation_.registerAfterPassCallback([this](llvm::StringRef pass, llvm::Any ir, const llvm::PreservedAnalyses&)
+		{
+			if (time_trace_ && !pass_begins_.empty())
+			{
+				time_trace_->add_event(pass.str(), ir_name(ir), pass_begins_.back(), time_trace_->now());
+				pass_begins_.pop_back();
+			}
+		});
+		instrumentation_.registerAfterPassInvalidatedCallback([this](llvm::StringRef pass, const llvm::PreservedAnalyses&)
+		{
+			// 패스가 IR 단위를 지웠으므로 이름을 가져올 수 없습니다.
+			if (time_trace_ && !pass_begins_.empty())
+			{
+				time_trace_->add_event(pass.str(), std::string(), pass_begins_.back(), time_trace_->now());
+				pass_begins_.pop_back();
+			}
+		});
+	}
+}
@@ -5,27 +5,46 @@
 
 namespace Dlink
 {
-	std::string tree_prefix(std::size_t depth)
+	AST::AST(AST&& ast) noexcept
+		: context_(std::move(ast.context_)), node_(ast.node_)
 	{
-		return std::string(depth * 4, ' ');
+		ast.node_ = nullptr;
 	}
 
-	AST::AST(AST&& ast) noexcept
-		: node_(std::move(ast.node_))
-	{}
-
 	AST& AST::operator=(AST&& ast) noexcept
 	{
-		node_ = std::move(ast.node_);
+		context_ = std::move(ast.context_);
+		node_ = ast.node_;
+		ast.node_ = nullptr;
 		return *this;
 	}
 
-	void AST::dump() const
+	/**
+	 * @brief 트리를 표준 출력에 출력합니다.
+	 * @param format 출력 형식입니다.
+	 */
+	void AST::dump(ASTDumpFormat format) const
+	{
+		dump(std::cout, format);
+	}
+	/**
+	 * @brief 트리를 스트림에 출력합니다.
+	 * @details 출력의 길이에 비례하는 시간이 걸리며, 트리가 아무리 깊어도 네이티브 스택을 일정하게 사용합니다.
+	 * @param stream 트리를 출력할 스트림입니다.
+	 * @param format 출력 형식입니다.
+	 */
+	void AST::dump(std::ostream& stream, ASTDumpFormat format) const
 	{
-		dump(std::cout);
+		ASTDumper dumper(stream, format);
+		dumper.dump(node_);
 	}
-	void AST::dump(std::ostream& stream) const
+	/**
+	 * @brief 노드들을 소유하는 아레나를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 아레나를 반환합니다.
+	 */
+	ASTContext& AST::get_context() noexcept
 	{
-		std::cout << node_->tree_gen(0) << '\n';
+		return context_;
 	}
 }
\ No newline at end of file
@@ -7,7 +7,6 @@
 
 namespace Dlink
 {
-	extern std::string tree_prefix(std::size_t depth);
 
 	/**
 	 * @brief 새 VariableDeclaration 인스턴스를 만듭니다.
@@ -16,8 +15,8 @@ namespace Dlink
 	 * @param identifier 변수의 식별자입니다.
 	 */
 	VariableDeclaration::VariableDeclaration(const Token& token, TypePtr type,
-		const std::string& identifier)
-		: Statement(token), type(type), identifier(identifier)
+		Symbol identifier)
+		: Statement(NodeKind::VariableDeclaration, token), type(type), identifier(identifier)
 	{}
 	/**
 	* @brief 새 VariableDeclaration 인스턴스를 만듭니다.
@@ -27,72 +26,85 @@ namespace Dlink
 	* @param expression 변수의 초기화 식입니다.
 	*/
 	VariableDeclaration::VariableDeclaration(const Token& token, TypePtr type,
-		const std::string& identifier, ExpressionPtr expression)
-		: Statement(token), type(type), identifier(identifier), expression(expression)
+		Symbol identifier, ExpressionPtr expression)
+		: Statement(NodeKind::VariableDeclaration, token), type(type), identifier(identifier), expression(expression)
 	{}
-	std::string VariableDeclaration::tree_gen(std::size_t depth) const
+	bool VariableDeclaration::classof(const Node* node) noexcept
 	{
-		std::string result;
-		result += tree_prefix(depth) + "VariableDeclaration:\n";
-		++depth;
-		result += tree_prefix(depth) + "type:\n" + type->tree_gen(depth + 1) + '\n';
-		result += tree_prefix(depth) + "identifier: " + identifier + '\n';
-		if (expression)
-			result += tree_prefix(depth) + "expression: \n" + expression->tree_gen(depth + 1);
-		else
-			result += tree_prefix(depth) + "expression: empty";
-
-		return result;
+		return node->kind == NodeKind::VariableDeclaration;
 	}
-	void VariableDeclaration::array_helper(llvm::Value* var, std::shared_ptr<ArrayInitList> array_list)
+	/**
+	 * @brief 배열 초기화 리스트의 원소들을 배열에 저장합니다.
+	 * @details 중첩된 배열 초기화 리스트를 재귀 호출 대신 명시적 스택으로 방문합니다.
+	 * @param var 원소들을 저장할 배열입니다.
+	 * @param array_list 배열 초기화 리스트입니다.
+	 */
+	void VariableDeclaration::array_helper(llvm::Value* var, ArrayInitList* array_list)
 	{
-		std::size_t idx = 0;
+		struct Pending
+		{
+			llvm::Value* gep;
+			ArrayInitList* array_list;
+			std::size_t index;
+		};
 
-		llvm::Value* indexList[2] = { llvm::ConstantInt::get(LLVM::builder().getInt64Ty(), 0),
-									 llvm::ConstantInt::get(LLVM::builder().getInt64Ty(), idx) };
-		llvm::Value* prev_gep = LLVM::builder().CreateInBoundsGEP(var, indexList);
+		llvm::Value* zero = llvm::ConstantInt::get(LLVM::builder().getInt64Ty(), 0);
+		llvm::Value* one = llvm::ConstantInt::get(LLVM::builder().getInt64Ty(), 1);
+		llvm::Value* indexList[2] = { zero, zero };
 
-		std::size_t i = 0;
-		for (; i < array_list->elements.size() - 1; ++i)
+		std::vector<Pending> stack;
+		stack.push_back({ LLVM::builder().CreateInBoundsGEP(var, indexList), array_list, 0 });
+
+		while (!stack.empty())
 		{
-			ExpressionPtr expression = array_list->elements[i];
+			Pending& top = stack.back();
 
-			std::shared_ptr<ArrayInitList> sub_array_list;
-			if ((sub_array_list = std::dynamic_pointer_cast<ArrayInitList>(expression)))
+			if (top.index == top.array_list->elements.size())
 			{
-				array_helper(prev_gep, sub_array_list);
-				prev_gep = LLVM::builder().CreateInBoundsGEP(prev_gep, llvm::ConstantInt::get(LLVM::builder().getInt64Ty(), 1));
+				stack.pop_back();
+				continue;
 			}
-			else
+
+			llvm::Value* prev_gep = top.gep;
+			if (top.index != 0)
 			{
-				LLVM::builder().CreateStore(expression->code_gen(), prev_gep);
-				prev_gep = LLVM::builder().CreateInBoundsGEP(prev_gep, llvm::ConstantInt::get(LLVM::builder().getInt64Ty(), 1));
+				prev_gep = top.gep = LLVM::builder().CreateInBoundsGEP(prev_gep, one);
 			}
-		}
 
-		ExpressionPtr expression = array_list->elements[i];
+			ExpressionPtr expression = top.array_list->elements[top.index++];
 
-		std::shared_ptr<ArrayInitList> sub_array_list;
-		if ((sub_array_list = std::dynamic_pointer_cast<ArrayInitList>(expression)))
-		{
-			array_helper(prev_gep, sub_array_list);
-		}
-		else
-		{
-			LLVM::builder().CreateStore(expression->code_gen(), prev_gep);
+			ArrayInitList* sub_array_list;
+			if ((sub_array_list = dyn_cast<ArrayInitList>(expression)))
+			{
+				stack.push_back({ LLVM::builder().CreateInBoundsGEP(prev_gep, indexList), sub_array_list, 0 });
+			}
+			else
+			{
+				LLVM::builder().CreateStore(expression->code_gen(), prev_gep);
+			}
 		}
 	}
-	LLVM::Value VariableDeclaration::code_gen()
+	Node* VariableDeclaration::code_gen_step(CodeGenFrame& frame)
 	{
-		if (!in_unsafe_block && !type->is_safe())
+		// frame.values[0]은 변수이고, frame.values[1]은 초기화 식의 값입니다.
+		if (frame.step == 1)
+		{
+			LLVM::builder().CreateStore(frame.values[1], frame.values[0]);
+
+			set_address(frame.values[0]);
+			frame.result = frame.values[0];
+			return nullptr;
+		}
+
+		if (!in_unsafe_block() && !type->is_safe())
 		{
 			throw Error(token, "Unsafe declaration outside of unsafe statement");
 		}
 
-		llvm::AllocaInst* var = LLVM::builder().CreateAlloca(type->get_type(), nullptr, identifier);
+		llvm::AllocaInst* var = LLVM::builder().CreateAlloca(type->get_type(), nullptr, identifier.str());
 		var->setAlignment(4);
 
-		if (dynamic_cast<LValueReference*>(type.get()))
+		if (isa<LValueReference>(type))
 		{
 			if (!expression)
 			{
@@ -106,26 +118,45 @@ namespace Dlink
 		}
 		else if (expression) // Reference가 아닌데 expression이 있는 상황
 		{
-			std::shared_ptr<ArrayInitList> array_list;
-			if ((array_list = std::dynamic_pointer_cast<ArrayInitList>(expression)))
+			ArrayInitList* array_list;
+			if ((array_list = dyn_cast<ArrayInitList>(expression)))
 			{
 				array_helper(var, array_list);
 			}
 			else
 			{
-				LLVM::Value init_expr = expression->code_gen();
-
-				LLVM::builder().CreateStore(init_expr, var);
+				frame.values.push_back(var);
+				return expression;
 			}
 		}
 
-		symbol_table->map.insert(std::make_pair(identifier, var));
-		return var;
+		set_address(var);
+		frame.result = var;
+		return nullptr;
 	}
-	void VariableDeclaration::preprocess()
+	void VariableDeclaration::children(std::vector<Node*>& out)
 	{
-		if (expression)
-			expression->preprocess();
+		out.push_back(expression);
+	}
+	/**
+	 * @brief 현재 LLVM IR 코드를 만들고 있는 Assembler에서 변수의 주소를 가져옵니다.
+	 * @details FunctionDeclaration::function 함수와 같은 이유로, 변수의 주소는 노드가 아니라 Assembler가 가집니다.
+	 * @return 변수의 LLVM IR 코드를 만들었다면 변수의 주소를, 아니라면 nullptr을 반환합니다.
+	 */
+	LLVM::Value VariableDeclaration::address() const
+	{
+		const auto& variables = get_current_assembler().get_code_gen_state().variables;
+		auto iter = variables.find(this);
+
+		return iter != variables.end() ? iter->second : nullptr;
+	}
+	/**
+	 * @brief 현재 LLVM IR 코드를 만들고 있는 Assembler에 변수의 주소를 기록합니다.
+	 * @param value 변수의 주소입니다.
+	 */
+	void VariableDeclaration::set_address(LLVM::Value value)
+	{
+		get_current_assembler().get_code_gen_state().variables[this] = value;
 	}
 
 	/**
@@ -136,55 +167,43 @@ namespace Dlink
 	 * @param parameter 함수의 매개 변수입니다.
 	 * @param body 함수의 몸체입니다.
 	 */
-	FunctionDeclaration::FunctionDeclaration(const Token& token, TypePtr return_type, const std::string& identifier,
+	FunctionDeclaration::FunctionDeclaration(const Token& token, TypePtr return_type, Symbol identifier,
 		const std::vector<VariableDeclaration>& parameter, StatementPtr body)
-		: Statement(token), return_type(return_type), identifier(identifier), parameter(parameter), body(body),
-		func_(nullptr), func_type_(nullptr)
+		: Statement(NodeKind::FunctionDeclaration, token), return_type(return_type), identifier(identifier), parameter(parameter), body(body)
 	{}
-	std::string FunctionDeclaration::tree_gen(std::size_t depth) const
+	bool FunctionDeclaration::classof(const Node* node) noexcept
 	{
-		std::string result;
-		result += tree_prefix(depth) + "FunctionDeclaration:\n";
-		++depth;
-		result += tree_prefix(depth) + "return_type:\n" + return_type->tree_gen(depth + 1) + '\n';
-		result += tree_prefix(depth) + "identifier: " + identifier + '\n';
-		result += tree_prefix(depth) + "parameter:";
-		if (parameter.size() == 0)
-			result += " empty\n";
-		else
-		{
-			result += '\n';
+		return node->kind == NodeKind::FunctionDeclaration;
+	}
+	Node* FunctionDeclaration::code_gen_step(CodeGenFrame& frame)
+	{
+		llvm::Function* func = function();
 
-			++depth;
+		if (frame.step == 0)
+		{
+			current_func() = this;
 
-			for (auto& param : parameter)
+			if (TimeTrace* time_trace = get_current_assembler().get_time_trace())
 			{
-				result += param.tree_gen(depth) + '\n';
+				get_current_assembler().get_code_gen_state().function_begins.push_back(time_trace->now());
 			}
 
-			--depth;
-		}
-		result += tree_prefix(depth) + "body:\n" + body->tree_gen(depth + 1);
-
-		return result;
-	}
-	LLVM::Value FunctionDeclaration::code_gen()
-	{
-		// Note: It's dummy.
-		current_func = std::make_shared<FunctionDeclaration>(token, return_type, identifier, parameter, body);
+			llvm::BasicBlock* func_block = llvm::BasicBlock::Create(LLVM::context(), "entry", func, nullptr);
+			LLVM::builder().SetInsertPoint(func_block);
 
-		llvm::BasicBlock* func_block = llvm::BasicBlock::Create(LLVM::context(), "entry", func_, nullptr);
-		LLVM::builder().SetInsertPoint(func_block);
+			std::size_t i = 0;
+			for (auto& param : func->args())
+			{
+				llvm::AllocaInst* param_alloca = LLVM::builder().CreateAlloca(param.getType(), nullptr, param.getName());
+				LLVM::builder().CreateStore(&param, param_alloca);
 
-		for (auto& param : func_->args())
-		{
-			llvm::AllocaInst* param_alloca = LLVM::builder().CreateAlloca(param.getType(), nullptr, param.getName());
-			LLVM::builder().CreateStore(&param, param_alloca);
+				parameter[i++].set_address(param_alloca);
+			}
 
-			symbol_table->map.insert(std::make_pair(param.getName(), param_alloca));
+			return body;
 		}
 
-		llvm::Value* body_gen = body->code_gen();
+		llvm::Value* body_gen = frame.values[0];
 		llvm::ReturnInst* ret = nullptr;
 
 		if (body_gen)
@@ -207,44 +226,65 @@ namespace Dlink
 			}
 		}
 
-		LLVM::function_pm()->run(*func_);
-
-		for (auto& param : func_->args())
+		// 함수마다 걸린 시간을 볼 수 있도록, 단순화하기 전까지를 코드 생성 시간으로 기록합니다.
+		if (TimeTrace* time_trace = get_current_assembler().get_time_trace())
 		{
-			symbol_table->map.erase(param.getName());
+			std::vector<std::uint64_t>& function_begins = get_current_assembler().get_code_gen_state().function_begins;
+			time_trace->add_event("FunctionDeclaration::code_gen", identifier.str(), function_begins.back(), time_trace->now());
+			function_begins.pop_back();
 		}
 
-		current_func = nullptr;
+		// 모듈 파이프라인 전에 함수마다 미리 단순화하면 병렬로 처리되고, 모듈 파이프라인만 실행할 때보다 빠릅니다.
+		LLVM::optimizer().optimize_function(*func);
 
-		return func_;
+		current_func() = nullptr;
+
+		frame.result = func;
+		return nullptr;
 	}
-	void FunctionDeclaration::preprocess()
+	void FunctionDeclaration::children(std::vector<Node*>& out)
 	{
-		body->preprocess();
+		out.push_back(body);
 		for (VariableDeclaration& var : parameter)
 		{
-			var.preprocess();
+			out.push_back(&var);
 		}
-
+	}
+	void FunctionDeclaration::preprocess_node()
+	{
 		std::vector<llvm::Type*> param_type;
 		for (const auto& param : parameter)
 		{
 			param_type.push_back(param.type->get_type());
 		}
 
-		func_type_ =
+		llvm::FunctionType* func_type =
 			param_type.size() != 0 ?
 			llvm::FunctionType::get(return_type->get_type(), param_type, false) :
 			llvm::FunctionType::get(return_type->get_type(), false);
-		func_ =
-			llvm::Function::Create(func_type_, llvm::GlobalValue::ExternalLinkage, identifier, LLVM::module().get());
+		llvm::Function* func =
+			llvm::Function::Create(func_type, llvm::GlobalValue::ExternalLinkage, identifier.str(), LLVM::module().get());
 
 		std::size_t i = 0;
-		for (auto& param : func_->args())
+		for (auto& param : func->args())
 		{
-			param.setName(parameter[i++].identifier);
+			param.setName(parameter[i++].identifier.str());
 		}
 
-		symbol_table->map.insert(std::make_pair(identifier, func_));
+		Assembler::CodeGenState& state = get_current_assembler().get_code_gen_state();
+		state.functions[this] = func;
+		state.declarations.push_back(this);
+	}
+	/**
+	 * @brief 현재 LLVM IR 코드를 만들고 있는 모듈에서 함수의 LLVM Function을 가져옵니다.
+	 * @details 여러 Assembler가 같은 추상 구문 트리로 동시에 코드를 만들 수 있으므로, LLVM Function은 노드가 아니라 Assembler가 가집니다.
+	 * @return preprocess_node가 호출되었다면 LLVM Function을, 아니라면 nullptr을 반환합니다.
+	 */
+	llvm::Function* FunctionDeclaration::function() const
+	{
+		const auto& functions = get_current_assembler().get_code_gen_state().functions;
+		auto iter = functions.find(this);
+
+		return iter != functions.end() ? iter->second : nullptr;
 	}
 }
\ No newline at end of file
@@ -1,11 +1,12 @@
 #include "ParseStruct/Operation.hh"
+#include "ParseStruct/Declaration.hh"
+#include "ParseStruct/Type.hh"
 #include "CodeGen.hh"
 
 #include <iostream>
 
 namespace Dlink
 {
-	extern std::string tree_prefix(std::size_t depth);
 	std::string operator_string(TokenType operator_type)
 	{
 		switch (operator_type)
@@ -58,6 +59,8 @@ namespace Dlink
 			return "&&";
 		case TokenType::logic_or:
 			return "||";
+		case TokenType::exclamation:
+			return "!";
 
 		case TokenType::bit_not:
 			return "~";
@@ -97,21 +100,17 @@ namespace Dlink
 	 * @param data 32비트 부호 있는 정수 상수입니다.
 	 */
 	Integer32::Integer32(const Token& token, std::int32_t data) noexcept
-		: Expression(token), data(data)
+		: Expression(NodeKind::Integer32, token), data(data)
 	{}
 
-	std::string Integer32::tree_gen(std::size_t depth) const
+	bool Integer32::classof(const Node* node) noexcept
 	{
-		return tree_prefix(depth) + "Integer32(" + std::to_string(data) + ')';
+		return node->kind == NodeKind::Integer32;
 	}
-	LLVM::Value Integer32::code_gen()
+	Node* Integer32::code_gen_step(CodeGenFrame& frame)
 	{
-		return LLVM::builder().getInt32(data);
-	}
-	bool Integer32::evaluate(Any& out)
-	{
-		out = static_cast<std::int64_t>(data);
-		return true;
+		frame.result = LLVM::builder().getInt32(data);
+		return nullptr;
 	}
 
 	/**
@@ -121,16 +120,17 @@ namespace Dlink
 	 * @param data 문자열입니다.
 	 */
 	String::String(const Token& token, const std::string& data) noexcept
-		: Expression(token), data(data)
+		: Expression(NodeKind::String, token), data(data)
 	{}
 
-	std::string String::tree_gen(std::size_t depth) const
+	bool String::classof(const Node* node) noexcept
 	{
-		return tree_prefix(depth) + "String(" + data + ')';
+		return node->kind == NodeKind::String;
 	}
-	LLVM::Value String::code_gen()
+	Node* String::code_gen_step(CodeGenFrame& frame)
 	{
-		return LLVM::builder().CreateGlobalStringPtr(data.c_str());
+		frame.result = LLVM::builder().CreateGlobalStringPtr(data.c_str());
+		return nullptr;
 	}
 
 	/**
@@ -140,16 +140,17 @@ namespace Dlink
 	 * @param data 문자입니다.
 	 */
 	Character::Character(const Token& token, char data) noexcept
-		: Expression(token), data(data)
+		: Expression(NodeKind::Character, token), data(data)
 	{}
 
-	std::string Character::tree_gen(std::size_t depth) const
+	bool Character::classof(const Node* node) noexcept
 	{
-		return tree_prefix(depth) + "Character(" + data + ')';
+		return node->kind == NodeKind::Character;
 	}
-	LLVM::Value Character::code_gen()
+	Node* Character::code_gen_step(CodeGenFrame& frame)
 	{
-		return LLVM::builder().getInt8(data);
+		frame.result = LLVM::builder().getInt8(data);
+		return nullptr;
 	}
 }
 
@@ -163,101 +164,233 @@ namespace Dlink
 	 * @param rhs 우측 피연산자입니다.
 	 */
 	BinaryOperation::BinaryOperation(const Token& token, TokenType op, ExpressionPtr lhs, ExpressionPtr rhs)
-		: Expression(token), op(op), lhs(lhs), rhs(rhs)
+		: Expression(NodeKind::BinaryOperation, token), op(op), lhs(lhs), rhs(rhs)
 	{}
-	std::string BinaryOperation::tree_gen(std::size_t depth) const
+	bool BinaryOperation::classof(const Node* node) noexcept
 	{
-		std::string tree = tree_prefix(depth) + "BinaryOperation:\n";
-		++depth;
-		tree += tree_prefix(depth) + "lhs:\n";
-		tree += lhs->tree_gen(depth + 1) + '\n';
-		tree += tree_prefix(depth) + "rhs:\n";
-		tree += rhs->tree_gen(depth + 1) + '\n';
-		tree += tree_prefix(depth) + "op:\n";
-		tree += tree_prefix(depth + 1) + operator_string(op) + '(' + token_map.at(op) + ')';
-
-		return tree;
+		return node->kind == NodeKind::BinaryOperation;
 	}
-	LLVM::Value BinaryOperation::code_gen()
+	namespace
 	{
-		LLVM::Value lhs_value = lhs->code_gen();
-		LLVM::Value rhs_value = rhs->code_gen();
-
-		switch (op)
+		/**
+		 * @brief 값을 0과 비교해 논리 값(i1)으로 바꿉니다.
+		 * @param value 바꿀 값입니다.
+		 * @return value가 0이 아니라면 true인 논리 값을 반환합니다.
+		 */
+		llvm::Value* to_bool(llvm::Value* value)
 		{
-		case TokenType::plus:
-			return LLVM::builder().CreateAdd(lhs_value, rhs_value);
-
-		case TokenType::minus:
-			return LLVM::builder().CreateSub(lhs_value, rhs_value);
-
-		case TokenType::multiply:
-			return LLVM::builder().CreateMul(lhs_value, rhs_value);
-
-		case TokenType::divide:
-			// TODO: 임시 방안
-			return LLVM::builder().CreateSDiv(lhs_value, rhs_value);
+			if (value->getType()->isIntegerTy(1))
+				return value;
 
-		case TokenType::assign:
+			return LLVM::builder().CreateICmpNE(value, llvm::Constant::getNullValue(value->getType()));
+		}
+		/**
+		 * @brief 복합 대입 연산자가 대입 전에 수행하는 이항 연산자를 가져옵니다.
+		 * @details 이 함수는 예외를 발생시키지 않습니다.
+		 * @param op 복합 대입 연산자입니다.
+		 * @return 대응하는 이항 연산자를 반환합니다. 복합 대입 연산자가 아니라면 TokenType::none을 반환합니다.
+		 */
+		TokenType compound_operator(TokenType op) noexcept
 		{
-			llvm::LoadInst* load_inst = llvm::dyn_cast_or_null<llvm::LoadInst>(lhs_value.get());
-			if (load_inst)
+			switch (op)
 			{
-				return LLVM::builder().CreateStore(rhs_value, load_inst->getPointerOperand());
+			case TokenType::plus_assign: return TokenType::plus;
+			case TokenType::minus_assign: return TokenType::minus;
+			case TokenType::multiply_assign: return TokenType::multiply;
+			case TokenType::divide_assign: return TokenType::divide;
+			case TokenType::modulo_assign: return TokenType::modulo;
+			case TokenType::bit_and_assign: return TokenType::bit_and;
+			case TokenType::bit_or_assign: return TokenType::bit_or;
+			case TokenType::bit_xor_assign: return TokenType::bit_xor;
+			case TokenType::bit_lshift_assign: return TokenType::bit_lshift;
+			case TokenType::bit_rshift_assign: return TokenType::bit_rshift;
+			default: return TokenType::none;
 			}
-			return LLVM::builder().CreateStore(rhs_value, lhs_value);
 		}
+		/**
+		 * @brief 두 피연산자로 하는 이항 연산을 unsigned로 해야 하는지 확인합니다.
+		 * @details 부호에 따라 명령어가 달라지는 나눗셈, 나머지, 오른쪽 시프트, 대소 비교 연산만 피연산자의 부호를 확인합니다. 피연산자의 부호는 Resolver가 미리 계산하므로 상수 시간이 걸립니다. 이 함수는 예외를 발생시키지 않습니다.
+		 * @param op 연산자 타입입니다. 복합 대입 연산자가 아니어야 합니다.
+		 * @param lhs 좌측 피연산자입니다.
+		 * @param rhs 우측 피연산자입니다.
+		 * @return 오른쪽 시프트 연산이라면 좌측 피연산자가, 그 외에는 피연산자 중 하나라도 unsigned라면 true를 반환합니다. 부호와 관계없는 연산이라면 false를 반환합니다.
+		 * @see Dlink::Expression::is_unsigned
+		 */
+		bool is_unsigned_operation(TokenType op, const Expression* lhs, const Expression* rhs) noexcept
+		{
+			switch (op)
+			{
+			case TokenType::divide:
+			case TokenType::modulo:
+			case TokenType::less:
+			case TokenType::eqless:
+			case TokenType::greater:
+			case TokenType::eqgreater:
+				return lhs->is_unsigned || rhs->is_unsigned;
 
-		default:
-			return nullptr;
-		}
-	}
-	void BinaryOperation::preprocess()
-	{
-		lhs->preprocess();
-		rhs->preprocess();
-	}
-	bool BinaryOperation::evaluate(Any& out)
-	{
-		Any lhs_eval, rhs_eval;
-		bool lhs_eval_ok = lhs->evaluate(lhs_eval);
-		bool rhs_eval_ok = rhs->evaluate(rhs_eval);
+			case TokenType::bit_rshift:
+				return lhs->is_unsigned;
 
-		if (lhs_eval_ok && rhs_eval_ok)
+			default:
+				return false;
+			}
+		}
+		/**
+		 * @brief 두 피연산자 값으로 이항 산술, 비트, 비교 연산 코드를 만듭니다.
+		 * @details 비교 연산의 결과는 int 타입으로 확장됩니다. 나눗셈, 나머지, 오른쪽 시프트, 대소 비교 연산은 is_unsigned에 따라 unsigned 또는 signed 명령어를 사용합니다.
+		 * @param op 연산자 타입입니다.
+		 * @param lhs 좌측 피연산자 값입니다.
+		 * @param rhs 우측 피연산자 값입니다.
+		 * @param is_unsigned 연산을 unsigned로 할지 여부입니다.
+		 * @return 만든 값을 반환합니다. 지원하지 않는 연산자라면 nullptr를 반환합니다.
+		 */
+		llvm::Value* arithmetic_gen(TokenType op, llvm::Value* lhs, llvm::Value* rhs, bool is_unsigned)
 		{
-			Any eval;
-			bool eval_ok;
+			llvm::IRBuilder<>& builder = LLVM::builder();
 
 			switch (op)
 			{
 			case TokenType::plus:
-				eval_ok = any_add(lhs_eval, rhs_eval, eval);
-				break;
-
+				return builder.CreateAdd(lhs, rhs);
 			case TokenType::minus:
-				eval_ok = any_sub(lhs_eval, rhs_eval, eval);
-				break;
-
+				return builder.CreateSub(lhs, rhs);
 			case TokenType::multiply:
-				eval_ok = any_mul(lhs_eval, rhs_eval, eval);
-				break;
-
+				return builder.CreateMul(lhs, rhs);
 			case TokenType::divide:
-				eval_ok = any_div(lhs_eval, rhs_eval, eval);
-				break;
+				return is_unsigned ? builder.CreateUDiv(lhs, rhs) : builder.CreateSDiv(lhs, rhs);
+			case TokenType::modulo:
+				return is_unsigned ? builder.CreateURem(lhs, rhs) : builder.CreateSRem(lhs, rhs);
+
+			case TokenType::bit_and:
+				return builder.CreateAnd(lhs, rhs);
+			case TokenType::bit_or:
+				return builder.CreateOr(lhs, rhs);
+			case TokenType::bit_xor:
+				return builder.CreateXor(lhs, rhs);
+			case TokenType::bit_lshift:
+				return builder.CreateShl(lhs, rhs);
+			case TokenType::bit_rshift:
+				return is_unsigned ? builder.CreateLShr(lhs, rhs) : builder.CreateAShr(lhs, rhs);
+
+			case TokenType::equal:
+				return builder.CreateZExt(builder.CreateICmpEQ(lhs, rhs), builder.getInt32Ty());
+			case TokenType::noteq:
+				return builder.CreateZExt(builder.CreateICmpNE(lhs, rhs), builder.getInt32Ty());
+			case TokenType::less:
+				return builder.CreateZExt(is_unsigned ? builder.CreateICmpULT(lhs, rhs) : builder.CreateICmpSLT(lhs, rhs), builder.getInt32Ty());
+			case TokenType::eqless:
+				return builder.CreateZExt(is_unsigned ? builder.CreateICmpULE(lhs, rhs) : builder.CreateICmpSLE(lhs, rhs), builder.getInt32Ty());
+			case TokenType::greater:
+				return builder.CreateZExt(is_unsigned ? builder.CreateICmpUGT(lhs, rhs) : builder.CreateICmpSGT(lhs, rhs), builder.getInt32Ty());
+			case TokenType::eqgreater:
+				return builder.CreateZExt(is_unsigned ? builder.CreateICmpUGE(lhs, rhs) : builder.CreateICmpSGE(lhs, rhs), builder.getInt32Ty());
 
 			default:
-				return false;
+				return nullptr;
 			}
+		}
+	}
+
+	Node* BinaryOperation::code_gen_step(CodeGenFrame& frame)
+	{
+		if (frame.step == 0)
+		{
+			return lhs;
+		}
 
-			if (eval_ok)
+		if (op == TokenType::logic_and || op == TokenType::logic_or)
+		{
+			// 단락 평가: 좌측 피연산자만으로 결과가 정해지면 우측 피연산자를 계산하지 않습니다.
+			// 우측 피연산자를 만드는 동안 유지해야 하는 기본 블록들은 frame.values[1], frame.values[2]에 저장합니다.
+			llvm::IRBuilder<>& builder = LLVM::builder();
+
+			if (frame.step == 1)
+			{
+				llvm::Value* lhs_bool = to_bool(frame.values[0]);
+				llvm::BasicBlock* lhs_block = builder.GetInsertBlock();
+				llvm::Function* func = lhs_block->getParent();
+
+				llvm::BasicBlock* rhs_block = llvm::BasicBlock::Create(LLVM::context(), "logic_rhs", func);
+				llvm::BasicBlock* end_block = llvm::BasicBlock::Create(LLVM::context(), "logic_end", func);
+
+				if (op == TokenType::logic_and)
+				{
+					builder.CreateCondBr(lhs_bool, rhs_block, end_block);
+				}
+				else
+				{
+					builder.CreateCondBr(lhs_bool, end_block, rhs_block);
+				}
+
+				builder.SetInsertPoint(rhs_block);
+
+				frame.values.push_back(lhs_block);
+				frame.values.push_back(end_block);
+				return rhs;
+			}
+
+			llvm::BasicBlock* lhs_block = llvm::cast<llvm::BasicBlock>(frame.values[1].get());
+			llvm::BasicBlock* end_block = llvm::cast<llvm::BasicBlock>(frame.values[2].get());
+
+			llvm::Value* rhs_bool = to_bool(frame.values[3]);
+			llvm::BasicBlock* rhs_block = builder.GetInsertBlock();
+			builder.CreateBr(end_block);
+
+			builder.SetInsertPoint(end_block);
+			llvm::PHINode* result = builder.CreatePHI(builder.getInt1Ty(), 2);
+			result->addIncoming(builder.getInt1(op == TokenType::logic_or), lhs_block);
+			result->addIncoming(rhs_bool, rhs_block);
+
+			frame.result = builder.CreateZExt(result, builder.getInt32Ty());
+			return nullptr;
+		}
+
+		if (frame.step == 1)
+		{
+			return rhs;
+		}
+
+		LLVM::Value lhs_value = frame.values[0];
+		LLVM::Value rhs_value = frame.values[1];
+
+		// 대입 연산자는 오른쪽부터 결합하므로, 연쇄 대입이 가능하도록 대입한 값을 결과로 사용합니다.
+		if (op == TokenType::assign)
+		{
+			llvm::LoadInst* load_inst = llvm::dyn_cast_or_null<llvm::LoadInst>(lhs_value.get());
+			if (load_inst)
+			{
+				LLVM::builder().CreateStore(rhs_value, load_inst->getPointerOperand());
+			}
+			else
+			{
+				LLVM::builder().CreateStore(rhs_value, lhs_value);
+			}
+			frame.result = rhs_value;
+			return nullptr;
+		}
+
+		TokenType compound_op = compound_operator(op);
+		if (compound_op != TokenType::none)
+		{
+			llvm::LoadInst* load_inst = llvm::dyn_cast_or_null<llvm::LoadInst>(lhs_value.get());
+			if (!load_inst)
 			{
-				out = eval;
-				return true;
+				throw Error(token, "Expected lvalue for left operand of assignment operator");
 			}
+
+			llvm::Value* result = arithmetic_gen(compound_op, lhs_value, rhs_value, is_unsigned_operation(compound_op, lhs, rhs));
+			LLVM::builder().CreateStore(result, load_inst->getPointerOperand());
+			frame.result = result;
+			return nullptr;
 		}
 
-		return false;
+		frame.result = arithmetic_gen(op, lhs_value, rhs_value, is_unsigned_operation(op, lhs, rhs));
+		return nullptr;
+	}
+	void BinaryOperation::children(std::vector<Node*>& out)
+	{
+		out.push_back(lhs);
+		out.push_back(rhs);
 	}
 
 	/**
@@ -267,35 +400,42 @@ namespace Dlink
 	 * @param rhs 피연산자입니다.
 	 */
 	UnaryOperation::UnaryOperation(const Token& token, TokenType op, ExpressionPtr rhs)
-		: Expression(token), op(op), rhs(rhs)
+		: Expression(NodeKind::UnaryOperation, token), op(op), rhs(rhs)
 	{}
-	std::string UnaryOperation::tree_gen(std::size_t depth) const
+	bool UnaryOperation::classof(const Node* node) noexcept
 	{
-		std::string tree = tree_prefix(depth) + "UnaryOperation:\n";
-		++depth;
-		tree += tree_prefix(depth) + "rhs:\n";
-		tree += rhs->tree_gen(depth + 1) + '\n';
-		tree += tree_prefix(depth) + "op:\n";
-		tree += tree_prefix(depth + 1) + operator_string(op) + '(' + token_map.at(op) + ')';
-
-		return tree;
+		return node->kind == NodeKind::UnaryOperation;
 	}
-	LLVM::Value UnaryOperation::code_gen()
+	Node* UnaryOperation::code_gen_step(CodeGenFrame& frame)
 	{
-		LLVM::Value rhs_value = rhs->code_gen();
+		if (frame.step == 0)
+		{
+			return rhs;
+		}
+
+		LLVM::Value rhs_value = frame.values[0];
 
 		switch (op)
 		{
 		case TokenType::plus:
-			return LLVM::builder().CreateMul(LLVM::builder().getInt32(1), rhs_value);
+			frame.result = LLVM::builder().CreateMul(LLVM::builder().getInt32(1), rhs_value);
+			break;
 
 		case TokenType::minus:
-			return LLVM::builder().CreateMul(LLVM::builder().getInt32(-1), rhs_value);
+			frame.result = LLVM::builder().CreateMul(LLVM::builder().getInt32(-1), rhs_value);
+			break;
 
 		case TokenType::multiply: // 값 참조 연산
-		{
-			return LLVM::builder().CreateLoad(rhs_value);
-		}
+			frame.result = LLVM::builder().CreateLoad(rhs_value);
+			break;
+
+		case TokenType::exclamation:
+			frame.result = LLVM::builder().CreateZExt(LLVM::builder().CreateNot(to_bool(rhs_value)), LLVM::builder().getInt32Ty());
+			break;
+
+		case TokenType::bit_not:
+			frame.result = LLVM::builder().CreateNot(rhs_value);
+			break;
 
 		case TokenType::bit_and: // 주소 참조 연산
 		{
@@ -304,7 +444,8 @@ namespace Dlink
 				llvm::LoadInst* temp = nullptr;
 				if ((temp = llvm::dyn_cast_or_null<llvm::LoadInst>(rhs_value.get())))
 				{
-					return temp->getPointerOperand();
+					frame.result = temp->getPointerOperand();
+					break;
 				}
 			}
 
@@ -313,45 +454,15 @@ namespace Dlink
 
 		default:
 			// TODO: 오류 처리
-			return LLVM::builder().getFalse();
+			frame.result = LLVM::builder().getFalse();
+			break;
 		}
+
+		return nullptr;
 	}
-	void UnaryOperation::preprocess()
-	{
-		rhs->preprocess();
-	}
-	bool UnaryOperation::evaluate(Any& out)
+	void UnaryOperation::children(std::vector<Node*>& out)
 	{
-		Any rhs_eval;
-		bool rhs_eval_ok = rhs->evaluate(rhs_eval);
-
-		if (rhs_eval_ok)
-		{
-			Any eval;
-			bool eval_ok;
-
-			switch (op)
-			{
-			case TokenType::plus:
-				eval_ok = any_add(0, rhs_eval, eval);
-				break;
-
-			case TokenType::minus:
-				eval_ok = any_sub(0, rhs_eval, eval);
-				break;
-
-			default:
-				return false;
-			}
-
-			if (eval_ok)
-			{
-				out = eval;
-				return true;
-			}
-		}
-
-		return false;
+		out.push_back(rhs);
 	}
 
 	/**
@@ -361,63 +472,53 @@ namespace Dlink
 	 * @param argument 인수입니다.
 	 */
 	FunctionCallOperation::FunctionCallOperation(const Token& token, ExpressionPtr func_expr, const std::vector<ExpressionPtr>& arugment)
-		: Expression(token), func_expr(func_expr), argument(arugment)
+		: Expression(NodeKind::FunctionCallOperation, token), func_expr(func_expr), argument(arugment)
 	{}
-	std::string FunctionCallOperation::tree_gen(std::size_t depth) const
+	bool FunctionCallOperation::classof(const Node* node) noexcept
 	{
-		std::string result;
-		result += tree_prefix(depth) + "FunctionCallOperation:\n";
-		++depth;
-		result += tree_prefix(depth) + "func_expr:\n";
-		result += func_expr->tree_gen(depth + 1) + '\n';
-		result += tree_prefix(depth) + "argument:\n";
-		++depth;
-		for (auto arg : argument)
-		{
-			result += arg->tree_gen(depth) + '\n';
-		}
-
-		return result;
+		return node->kind == NodeKind::FunctionCallOperation;
 	}
-	LLVM::Value FunctionCallOperation::code_gen()
+	Node* FunctionCallOperation::code_gen_step(CodeGenFrame& frame)
 	{
-		llvm::Function* function;
-
-		Identifier* dest;
-		if ((dest = dynamic_cast<Identifier*>(func_expr.get())))
+		// frame.values[0]은 호출할 함수이고, 그 뒤로는 지금까지 만든 인수들입니다.
+		if (frame.step == 0)
 		{
-			function = llvm::dyn_cast<llvm::Function>(symbol_table->find(dest->id).get());
+			Identifier* dest;
+			if ((dest = dyn_cast<Identifier>(func_expr)))
+			{
+				frame.values.push_back(dest->value());
+			}
+			else
+			{
+				return func_expr;
+			}
 		}
-		else
+
+		llvm::Function* function = llvm::dyn_cast_or_null<llvm::Function>(frame.values[0].get());
+		if (!function)
 		{
-			function = llvm::dyn_cast<llvm::Function>(func_expr->code_gen().get());
+			throw Error(token, "Expected callable function expression");
 		}
 
-
-		if (function)
+		std::size_t arg_index = frame.values.size() - 1;
+		if (arg_index < argument.size())
 		{
-			std::vector<llvm::Value*> arg_real;
-
-			for (auto arg : argument)
-			{
-				arg_real.push_back(arg->code_gen());
-			}
-
-			return LLVM::builder().CreateCall(function, arg_real);
+			return argument[arg_index];
 		}
-		else
+
+		std::vector<llvm::Value*> arg_real;
+		for (std::size_t i = 1; i < frame.values.size(); ++i)
 		{
-			throw Error(token, "Expected callable function expression");
+			arg_real.push_back(frame.values[i]);
 		}
+
+		frame.result = LLVM::builder().CreateCall(function, arg_real);
+		return nullptr;
 	}
-	void FunctionCallOperation::preprocess()
+	void FunctionCallOperation::children(std::vector<Node*>& out)
 	{
-		func_expr->preprocess();
-
-		for (ExpressionPtr arg : argument)
-		{
-			arg->preprocess();
-		}
+		out.push_back(func_expr);
+		out.insert(out.end(), argument.begin(), argument.end());
 	}
 
 	/**
@@ -426,32 +527,19 @@ namespace Dlink
 	 * @param elements 배열 리스트의 원소들입니다.
 	 */
 	ArrayInitList::ArrayInitList(const Token& token, const std::vector<ExpressionPtr>& elements)
-		: Expression(token), elements(elements)
+		: Expression(NodeKind::ArrayInitList, token), elements(elements)
 	{}
-	std::string ArrayInitList::tree_gen(std::size_t depth) const
+	bool ArrayInitList::classof(const Node* node) noexcept
 	{
-		std::string result;
-		result += tree_prefix(depth) + "ArrayInitList:\n";
-		++depth;
-		result += tree_prefix(depth) + "elements:\n";
-		++depth;
-		for (auto element : elements)
-		{
-			result += element->tree_gen(depth) + '\n';
-		}
-
-		return result;
+		return node->kind == NodeKind::ArrayInitList;
 	}
-	LLVM::Value ArrayInitList::code_gen()
+	Node* ArrayInitList::code_gen_step(CodeGenFrame& frame)
 	{
 		throw Error(token, "Expected expression");
 	}
-	void ArrayInitList::preprocess()
+	void ArrayInitList::children(std::vector<Node*>& out)
 	{
-		for (ExpressionPtr expr : elements)
-		{
-			expr->preprocess();
-		}
+		out.insert(out.end(), elements.begin(), elements.end());
 	}
 
 	/**
@@ -460,36 +548,41 @@ namespace Dlink
 	 * @param expression 안전하지 않은 식입니다.
 	 */
 	UnsafeExpression::UnsafeExpression(const Token& token, ExpressionPtr expression)
-		: Expression(token), expression(expression)
+		: Expression(NodeKind::UnsafeExpression, token), expression(expression)
 	{}
-	std::string UnsafeExpression::tree_gen(std::size_t depth) const
+	bool UnsafeExpression::classof(const Node* node) noexcept
 	{
-		return tree_prefix(depth) + "UnsafeExpression:\n" +
-			tree_prefix(depth + 1) + "expression:\n" +
-			expression->tree_gen(depth + 2);
+		return node->kind == NodeKind::UnsafeExpression;
 	}
-	LLVM::Value UnsafeExpression::code_gen()
+	Node* UnsafeExpression::code_gen_step(CodeGenFrame& frame)
 	{
-		LLVM::Value result = nullptr;
-
-		if (in_unsafe_block)
+		// frame.state는 이 노드가 in_unsafe_block을 켰는지 여부입니다.
+		if (frame.step == 0)
 		{
-			get_current_assembler().get_warnings().add_warning(Warning(token, "Unnecessary unsafe expression"));
+			if (in_unsafe_block())
+			{
+				get_current_assembler().get_warnings().add_warning(Warning(token, "Unnecessary unsafe expression"));
+			}
+			else
+			{
+				in_unsafe_block() = true;
+				frame.state = 1;
+			}
 
-			result = expression->code_gen();
+			return expression;
 		}
-		else
+
+		if (frame.state)
 		{
-			in_unsafe_block = true;
-			result = expression->code_gen();
-			in_unsafe_block = false;
+			in_unsafe_block() = false;
 		}
 
-		return result;
+		frame.result = frame.values[0];
+		return nullptr;
 	}
-	void UnsafeExpression::preprocess()
+	void UnsafeExpression::children(std::vector<Node*>& out)
 	{
-		expression->preprocess();
+		out.push_back(expression);
 	}
 }
 
@@ -501,32 +594,27 @@ namespace Dlink
 	 * @param return_expr 반환할 식입니다.
 	 */
 	ReturnStatement::ReturnStatement(const Token& token, ExpressionPtr return_expr)
-		: Statement(token), return_expr(return_expr)
+		: Statement(NodeKind::ReturnStatement, token), return_expr(return_expr)
 	{}
 
-	std::string ReturnStatement::tree_gen(std::size_t depth) const
+	bool ReturnStatement::classof(const Node* node) noexcept
 	{
-		std::string tree = tree_prefix(depth) + "ReturnStatement:\n";
-		if (return_expr)
-		{
-			tree += return_expr->tree_gen(depth + 1);
-		}
-		else
-		{
-			tree += tree_prefix(depth + 1) + "empty";
-		}
-
-		return tree;
+		return node->kind == NodeKind::ReturnStatement;
 	}
-	LLVM::Value ReturnStatement::code_gen()
+	Node* ReturnStatement::code_gen_step(CodeGenFrame& frame)
 	{
 		if (return_expr)
 		{
-			if (LLVM::builder().getCurrentFunctionReturnType() == LLVM::builder().getVoidTy())
+			if (frame.step == 0)
 			{
-				throw Error(token, "Unexpected value return statement in void function");
+				if (LLVM::builder().getCurrentFunctionReturnType() == LLVM::builder().getVoidTy())
+				{
+					throw Error(token, "Unexpected value return statement in void function");
+				}
+				return return_expr;
 			}
-			return LLVM::builder().CreateRet(return_expr->code_gen());
+
+			frame.result = LLVM::builder().CreateRet(frame.values[0]);
 		}
 		else
 		{
@@ -534,12 +622,14 @@ namespace Dlink
 			{
 				throw Error(token, "Expected value return statement in non-void returning function");
 			}
-			return LLVM::builder().CreateRetVoid();
+			frame.result = LLVM::builder().CreateRetVoid();
 		}
+
+		return nullptr;
 	}
-	void ReturnStatement::preprocess()
+	void ReturnStatement::children(std::vector<Node*>& out)
 	{
-		return_expr->preprocess();
+		out.push_back(return_expr);
 	}
 
 	/**
@@ -548,35 +638,40 @@ namespace Dlink
 	 * @param statement 안전하지 않은 문입니다.
 	 */
 	UnsafeStatement::UnsafeStatement(const Token& token, StatementPtr statement)
-		: Statement(token), statement(statement)
+		: Statement(NodeKind::UnsafeStatement, token), statement(statement)
 	{}
-	std::string UnsafeStatement::tree_gen(std::size_t depth) const
+	bool UnsafeStatement::classof(const Node* node) noexcept
 	{
-		return tree_prefix(depth) + "UnsafeStatement:\n" +
-			tree_prefix(depth + 1) + "statement:\n" +
-			statement->tree_gen(depth + 2);
+		return node->kind == NodeKind::UnsafeStatement;
 	}
-	LLVM::Value UnsafeStatement::code_gen()
+	Node* UnsafeStatement::code_gen_step(CodeGenFrame& frame)
 	{
-		LLVM::Value result = nullptr;
-
-		if (in_unsafe_block)
+		// frame.state는 이 노드가 in_unsafe_block을 켰는지 여부입니다.
+		if (frame.step == 0)
 		{
-			get_current_assembler().get_warnings().add_warning(Warning(token, "Unnecessary unsafe statement"));
+			if (in_unsafe_block())
+			{
+				get_current_assembler().get_warnings().add_warning(Warning(token, "Unnecessary unsafe statement"));
+			}
+			else
+			{
+				in_unsafe_block() = true;
+				frame.state = 1;
+			}
 
-			result = statement->code_gen();
+			return statement;
 		}
-		else
+
+		if (frame.state)
 		{
-			in_unsafe_block = true;
-			result = statement->code_gen();
-			in_unsafe_block = false;
+			in_unsafe_block() = false;
 		}
 
-		return result;
+		frame.result = frame.values[0];
+		return nullptr;
 	}
-	void UnsafeStatement::preprocess()
+	void UnsafeStatement::children(std::vector<Node*>& out)
 	{
-		statement->preprocess();
+		out.push_back(statement);
 	}
 }
\ No newline at end of file
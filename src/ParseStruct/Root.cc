@@ -1,24 +1,157 @@
 #include <iostream>
+#include <utility>
 
 #include "ParseStruct/Root.hh"
+#include "ParseStruct/Declaration.hh"
+#include "ParseStruct/Operation.hh"
+#include "ParseStruct/Type.hh"
 #include "CodeGen.hh"
 
 namespace Dlink
 {
-	extern std::string tree_prefix(std::size_t depth);
+	/**
+	 * @brief 새 CodeGenFrame 인스턴스를 만듭니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param node 코드를 만들 노드입니다.
+	 */
+	CodeGenFrame::CodeGenFrame(Node* node) noexcept
+		: node(node)
+	{}
 
 	/**
 	 * @brief 이 Node 인스턴스의 멤버를 초기화합니다.
+	 * @param kind 이 노드의 실제 타입입니다.
 	 * @param token 이 노드를 만드는데 사용된 가장 첫번째 토큰입니다.
 	 */
-	Node::Node(const Token& token)
-		: token(token)
+	Node::Node(NodeKind kind, const Token& token)
+		: kind(kind), token(token)
 	{}
 
+	/**
+	 * @brief 이 노드의 실제 타입에 맞는 방문자의 visit 함수를 호출합니다.
+	 * @details 가상 함수를 거치지 않고 kind로 분기합니다. 하위 노드는 방문하지 않습니다.
+	 * @param visitor 이 노드를 방문할 방문자입니다.
+	 */
+	void Node::accept(ASTVisitor& visitor) const
+	{
+		switch (kind)
+		{
+		case NodeKind::Identifier:
+			return visitor.visit(static_cast<const Identifier&>(*this));
+		case NodeKind::Integer32:
+			return visitor.visit(static_cast<const Integer32&>(*this));
+		case NodeKind::String:
+			return visitor.visit(static_cast<const String&>(*this));
+		case NodeKind::Character:
+			return visitor.visit(static_cast<const Character&>(*this));
+		case NodeKind::BinaryOperation:
+			return visitor.visit(static_cast<const BinaryOperation&>(*this));
+		case NodeKind::UnaryOperation:
+			return visitor.visit(static_cast<const UnaryOperation&>(*this));
+		case NodeKind::FunctionCallOperation:
+			return visitor.visit(static_cast<const FunctionCallOperation&>(*this));
+		case NodeKind::ArrayInitList:
+			return visitor.visit(static_cast<const ArrayInitList&>(*this));
+		case NodeKind::UnsafeExpression:
+			return visitor.visit(static_cast<const UnsafeExpression&>(*this));
+
+		case NodeKind::Block:
+			return visitor.visit(static_cast<const Block&>(*this));
+		case NodeKind::Scope:
+			return visitor.visit(static_cast<const Scope&>(*this));
+		case NodeKind::ExpressionStatement:
+			return visitor.visit(static_cast<const ExpressionStatement&>(*this));
+		case NodeKind::ReturnStatement:
+			return visitor.visit(static_cast<const ReturnStatement&>(*this));
+		case NodeKind::UnsafeStatement:
+			return visitor.visit(static_cast<const UnsafeStatement&>(*this));
+		case NodeKind::VariableDeclaration:
+			return visitor.visit(static_cast<const VariableDeclaration&>(*this));
+		case NodeKind::FunctionDeclaration:
+			return visitor.visit(static_cast<const FunctionDeclaration&>(*this));
+		}
+	}
+
+	/**
+	 * @brief 이 노드의 트리를 LLVM IR 코드로 만듭니다.
+	 * @details 하위 노드를 재귀 호출로 방문하지 않고 CodeGenFrame을 명시적 스택에 쌓아 방문하므로, 트리가 아무리 깊어도 네이티브 스택을 일정하게 사용합니다.
+	 * @return 파싱 노드에서 생성한 LLVM::Value를 반환합니다. 생성한 값이 없을 경우 nullptr을 반환합니다.
+	 * @see Dlink::Node::code_gen_step
+	 */
+	LLVM::Value Node::code_gen()
+	{
+		std::vector<CodeGenFrame> frames;
+		frames.emplace_back(this);
+
+		while (true)
+		{
+			CodeGenFrame& frame = frames.back();
+			Node* child = frame.node->code_gen_step(frame);
+			++frame.step;
+
+			if (child)
+			{
+				frames.emplace_back(child);
+				continue;
+			}
+
+			LLVM::Value result = frame.result;
+			frames.pop_back();
+
+			if (frames.empty())
+				return result;
+
+			frames.back().values.push_back(result);
+		}
+	}
 	/**
 	 * @brief Assembler가 본격적인 어셈블 작업을 하기 전 미리 수행해야 할 필요가 있는 명령어들의 집합입니다.
+	 * @details 이 노드를 루트로 하는 트리를 명시적 스택으로 후위 순회하며 각 노드의 preprocess_node 함수를 호출합니다.
 	 */
 	void Node::preprocess()
+	{
+		// 두번째 값은 하위 노드들을 이미 스택에 쌓았는지 여부입니다.
+		std::vector<std::pair<Node*, bool>> stack;
+		std::vector<Node*> children;
+		stack.emplace_back(this, false);
+
+		while (!stack.empty())
+		{
+			Node* node = stack.back().first;
+
+			if (stack.back().second)
+			{
+				stack.pop_back();
+				node->preprocess_node();
+				continue;
+			}
+
+			stack.back().second = true;
+
+			children.clear();
+			node->children(children);
+			for (auto iter = children.rbegin(); iter != children.rend(); ++iter)
+			{
+				if (*iter)
+				{
+					stack.emplace_back(*iter, false);
+				}
+			}
+		}
+	}
+	/**
+	 * @brief 이 노드 하나에 대해서만 수행할 전처리 작업입니다.
+	 * @details 하위 노드들의 preprocess_node 함수가 모두 호출된 뒤에 호출됩니다.
+	 * @see Dlink::Node::preprocess
+	 */
+	void Node::preprocess_node()
+	{}
+	/**
+	 * @brief 이 노드의 하위 노드들을 순서대로 가져옵니다.
+	 * @details 타입 노드는 포함하지 않습니다.
+	 * @param out 하위 노드들을 추가할 목록입니다.
+	 */
+	void Node::children(std::vector<Node*>& out)
 	{}
 
 	/**
@@ -42,42 +175,157 @@ namespace Dlink
 
 	/**
 	 * @brief 이 식을 Dlink 코드를 컴파일 하는 중에 계산합니다.
+	 * @details StaticArray의 길이처럼 임의의 식을 계산할 수 있으므로, 재귀 호출 대신 명시적 스택으로 하위 식부터 계산합니다. 식이 아무리 깊어도 네이티브 스택을 일정하게 사용합니다.
+	 * Integer32, BinaryOperation, UnaryOperation으로만 이루어진 식을 계산할 수 있으며, 결과는 FlatAST::evaluate와 같습니다.
 	 * @param out 계산된 값을 저장할 Any 인스턴스입니다.
 	 * @return 컴파일 시간에 계산을 성공했을 경우 true를, 실패했을 경우 false를 반환합니다.
 	 */
 	bool Expression::evaluate(Any& out)
 	{
+		struct Value
+		{
+			bool ok;
+			Any value;
+		};
+
+		// 두 번째 값이 true인 항목은 하위 식을 모두 계산한 뒤 연산을 수행할 차례인 항목입니다.
+		std::vector<std::pair<Expression*, bool>> work{ { this, false } };
+		std::vector<Value> stack;
+
+		while (!work.empty())
+		{
+			const std::pair<Expression*, bool> top = work.back();
+			work.pop_back();
+
+			Expression* const node = top.first;
+			Value result = { false, Any() };
+
+			if (!node)
+			{
+				stack.push_back(std::move(result));
+				continue;
+			}
+
+			switch (node->kind)
+			{
+			case NodeKind::Integer32:
+				result.ok = true;
+				result.value = static_cast<std::int64_t>(cast<Integer32>(node)->data);
+				break;
+
+			case NodeKind::BinaryOperation:
+			{
+				BinaryOperation* operation = cast<BinaryOperation>(node);
+				if (!top.second)
+				{
+					work.emplace_back(node, true);
+					work.emplace_back(operation->rhs, false);
+					work.emplace_back(operation->lhs, false);
+					continue;
+				}
+
+				const std::size_t base = stack.size() - 2;
+				if (stack[base].ok && stack[base + 1].ok)
+				{
+					result.ok = evaluate_binary(operation->op, stack[base].value, stack[base + 1].value, result.value);
+				}
+				stack.resize(base);
+				break;
+			}
+
+			case NodeKind::UnaryOperation:
+			{
+				UnaryOperation* operation = cast<UnaryOperation>(node);
+				if (!top.second)
+				{
+					work.emplace_back(node, true);
+					work.emplace_back(operation->rhs, false);
+					continue;
+				}
+
+				const std::size_t base = stack.size() - 1;
+				if (stack[base].ok)
+				{
+					result.ok = evaluate_unary(operation->op, stack[base].value, result.value);
+				}
+				stack.resize(base);
+				break;
+			}
+
+			default:
+				break;
+			}
+
+			stack.push_back(std::move(result));
+		}
+
+		if (stack.back().ok)
+		{
+			out = std::move(stack.back().value);
+			return true;
+		}
 		return false;
 	}
+	bool Expression::classof(const Node* node) noexcept
+	{
+		return node->kind >= NodeKind::First_Expression && node->kind <= NodeKind::Last_Expression;
+	}
+
+	bool Statement::classof(const Node* node) noexcept
+	{
+		return node->kind >= NodeKind::First_Statement && node->kind <= NodeKind::Last_Statement;
+	}
 
 	/**
 	 * @brief 새 Identifier 인스턴스를 만듭니다.
 	 * @param token 이 노드를 만드는데 사용된 가장 첫번째 토큰입니다.
 	 * @param id 식별자 값입니다.
 	 */
-	Identifier::Identifier(const Token& token, const std::string& id)
-		: Expression(token), id(id)
+	Identifier::Identifier(const Token& token, Symbol id)
+		: Expression(NodeKind::Identifier, token), id(id)
 	{}
 
-	std::string Identifier::tree_gen(std::size_t depth) const
+	bool Identifier::classof(const Node* node) noexcept
 	{
-		return tree_prefix(depth) + "Identifier(\"" + id + "\")";
+		return node->kind == NodeKind::Identifier;
 	}
-	LLVM::Value Identifier::code_gen()
+	Node* Identifier::code_gen_step(CodeGenFrame& frame)
 	{
-		LLVM::Value result = symbol_table->find(id);
+		LLVM::Value result = value();
 
 		if (result == nullptr)
 		{
-			throw Error(token, "Unbound symbol \"" + id + "\"");
+			throw Error(token, "Unbound symbol \"" + id.str() + "\"");
 		}
 
-		return LLVM::builder().CreateLoad(result);
+		frame.result = LLVM::builder().CreateLoad(result);
+		return nullptr;
 	}
 	bool Identifier::is_lvalue() const noexcept
 	{
 		return true;
 	}
+	/**
+	 * @brief 식별자가 가리키는 선언의 LLVM Value를 가져옵니다.
+	 * @details 심볼 테이블을 찾지 않고 Resolver가 연결한 선언에서 바로 가져옵니다.
+	 * @return 변수라면 변수의 주소를, 함수라면 함수를, 연결된 선언이 없거나 선언의 코드를 아직 만들지 않았다면 nullptr을 반환합니다.
+	 */
+	LLVM::Value Identifier::value() const
+	{
+		if (!declaration)
+			return nullptr;
+
+		switch (declaration->kind)
+		{
+		case NodeKind::VariableDeclaration:
+			return cast<VariableDeclaration>(declaration)->address();
+		case NodeKind::FunctionDeclaration:
+			return cast<FunctionDeclaration>(declaration)->function();
+
+		default:
+			return nullptr;
+		}
+	}
 
 	/**
 	 * @brief 새 Block 인스턴스를 만듭니다.
@@ -85,39 +333,38 @@ namespace Dlink
 	 * @param statements Statement들의 집합입니다.
 	 */
 	Block::Block(const Token& token, const std::vector<StatementPtr>& statements)
-		: Statement(token), statements(statements)
+		: Block(NodeKind::Block, token, statements)
+	{}
+	/**
+	 * @brief Block을 상속받는 노드의 Block 부분을 초기화합니다.
+	 * @param kind 노드의 실제 타입입니다.
+	 * @param token 이 노드를 만드는데 사용된 가장 첫번째 토큰입니다.
+	 * @param statements Statement들의 집합입니다.
+	 */
+	Block::Block(NodeKind kind, const Token& token, const std::vector<StatementPtr>& statements)
+		: Statement(kind, token), statements(statements)
 	{}
 
-	std::string Block::tree_gen(std::size_t depth) const
+	bool Block::classof(const Node* node) noexcept
 	{
-		std::string tree = tree_prefix(depth) + "Block Start\n";
-
-		for (StatementPtr statement : statements)
-		{
-			tree += statement->tree_gen(depth + 1) + '\n';
-		}
-
-		tree += tree_prefix(depth) + "Block End";
-
-		return tree;
+		return node->kind == NodeKind::Block || node->kind == NodeKind::Scope;
 	}
-	LLVM::Value Block::code_gen()
+	Node* Block::code_gen_step(CodeGenFrame& frame)
 	{
-		LLVM::Value last_value;
-
-		for (StatementPtr statement : statements)
+		if (frame.step < statements.size())
 		{
-			last_value = statement->code_gen();
+			return statements[frame.step];
 		}
 
-		return last_value;
-	}
-	void Block::preprocess()
-	{
-		for (StatementPtr statement : statements)
+		if (!frame.values.empty())
 		{
-			statement->preprocess();
+			frame.result = frame.values.back();
 		}
+		return nullptr;
+	}
+	void Block::children(std::vector<Node*>& out)
+	{
+		out.insert(out.end(), statements.begin(), statements.end());
 	}
 
 	/**
@@ -127,40 +374,12 @@ namespace Dlink
 	 * @param parent 현재 스코프의 상위 스코프입니다.
 	 */
 	Scope::Scope(const Token& token, const std::vector<StatementPtr>& statements, StatementPtr parent)
-		: Block(token, statements), parent(parent)
+		: Block(NodeKind::Scope, token, statements), parent(parent)
 	{}
 
-	std::string Scope::tree_gen(std::size_t depth) const
+	bool Scope::classof(const Node* node) noexcept
 	{
-		std::string tree = tree_prefix(depth) + "Scope Start\n";
-
-		++depth;
-		for (StatementPtr statement : statements)
-		{
-			tree += statement->tree_gen(depth) + '\n';
-		}
-		--depth;
-
-		tree += tree_prefix(depth) + "Scope End";
-
-		return tree;
-	}
-	LLVM::Value Scope::code_gen()
-	{
-		SymbolTablePtr new_symbol_table = std::make_shared<SymbolTable>();
-		new_symbol_table->parent = symbol_table;
-		symbol_table = new_symbol_table;
-
-		LLVM::Value last_value;
-
-		for (StatementPtr statement : statements)
-		{
-			last_value = statement->code_gen();
-		}
-
-		symbol_table = symbol_table->parent;
-
-		return last_value;
+		return node->kind == NodeKind::Scope;
 	}
 
 	/**
@@ -169,20 +388,26 @@ namespace Dlink
 	 * @param expression 식입니다.
 	 */
 	ExpressionStatement::ExpressionStatement(const Token& token, ExpressionPtr expression)
-		: Statement(token), expression(expression)
+		: Statement(NodeKind::ExpressionStatement, token), expression(expression)
 	{}
 
-	std::string ExpressionStatement::tree_gen(std::size_t depth) const
+	bool ExpressionStatement::classof(const Node* node) noexcept
 	{
-		return expression->tree_gen(depth);
+		return node->kind == NodeKind::ExpressionStatement;
 	}
-	LLVM::Value ExpressionStatement::code_gen()
+	Node* ExpressionStatement::code_gen_step(CodeGenFrame& frame)
 	{
-		return expression->code_gen();
+		if (frame.step == 0)
+		{
+			return expression;
+		}
+
+		frame.result = frame.values[0];
+		return nullptr;
 	}
-	void ExpressionStatement::preprocess()
+	void ExpressionStatement::children(std::vector<Node*>& out)
 	{
-		expression->preprocess();
+		out.push_back(expression);
 	}
 }
 
@@ -190,12 +415,33 @@ namespace Dlink
 {
 	/**
 	 * @brief 이 Type 인스턴스의 멤버를 초기화합니다.
+	 * @param kind 이 타입 노드의 실제 타입입니다.
 	 * @param token 이 노드를 만드는데 사용된 가장 첫번째 토큰입니다.
 	 */
-	Type::Type(const Token& token)
-		: token(token)
+	Type::Type(TypeKind kind, const Token& token)
+		: kind(kind), token(token)
 	{}
 
+	/**
+	 * @brief 이 타입 노드의 실제 타입에 맞는 방문자의 visit 함수를 호출합니다.
+	 * @details 가상 함수를 거치지 않고 kind로 분기합니다.
+	 * @param visitor 이 타입 노드를 방문할 방문자입니다.
+	 */
+	void Type::accept(ASTVisitor& visitor) const
+	{
+		switch (kind)
+		{
+		case TypeKind::SimpleType:
+			return visitor.visit(static_cast<const SimpleType&>(*this));
+		case TypeKind::StaticArray:
+			return visitor.visit(static_cast<const StaticArray&>(*this));
+		case TypeKind::LValueReference:
+			return visitor.visit(static_cast<const LValueReference&>(*this));
+		case TypeKind::Pointer:
+			return visitor.visit(static_cast<const Pointer&>(*this));
+		}
+	}
+
 	/**
 	 * @brief 이 노드가 Dlink 코드 내에서 안전한 코드를 담고 있는지 여부입니다.
 	 * @details 이 함수는 예외를 발생시키지 않습니다.
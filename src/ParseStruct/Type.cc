@@ -3,7 +3,6 @@
 
 namespace Dlink
 {
-	extern std::string tree_prefix(std::size_t depth);
 
 	/**
 	 * @brief 새 SimpleType 인스턴스를 만듭니다.
@@ -21,13 +20,12 @@ namespace Dlink
 	 * @param is_unsigned 타입이 unsigned인지 여부입니다.
 	 */
 	SimpleType::SimpleType(const Token& token, const std::string& identifier, bool is_unsigned)
-		: Type(token), identifier(identifier), is_unsigned(is_unsigned)
+		: Type(TypeKind::SimpleType, token), identifier(identifier), is_unsigned(is_unsigned)
 	{}
 
-	std::string SimpleType::tree_gen(std::size_t depth) const
+	bool SimpleType::classof(const Type* node) noexcept
 	{
-		return tree_prefix(depth) + "SimpleType(" + identifier + ")\n"
-			+ tree_prefix(depth + 1) + "is_unsigned: " + (is_unsigned ? "true" : "false");
+		return node->kind == TypeKind::SimpleType;
 	}
 	llvm::Type* SimpleType::get_type()
 	{
@@ -50,17 +48,11 @@ namespace Dlink
 	 * @param length 배열의 길이입니다.
 	 */
 	StaticArray::StaticArray(const Token& token, TypePtr type, ExpressionPtr length)
-		: Type(token), type(type), length(length)
+		: Type(TypeKind::StaticArray, token), type(type), length(length)
 	{}
-	std::string StaticArray::tree_gen(std::size_t depth) const
+	bool StaticArray::classof(const Type* node) noexcept
 	{
-		std::string result;
-		result += tree_prefix(depth) + "StaticArray:\n";
-		++depth;
-		result += tree_prefix(depth) + "type:\n" + type->tree_gen(depth + 1) + '\n';
-		result += tree_prefix(depth) + "length:\n" + length->tree_gen(depth + 1);
-
-		return result;
+		return node->kind == TypeKind::StaticArray;
 	}
 	llvm::Type* StaticArray::get_type()
 	{
@@ -95,21 +87,33 @@ namespace Dlink
 
 	/**
 	 * @brief 이 Reference 인스턴스의 멤버를 초기화합니다.
+	 * @param kind 이 타입 노드의 실제 타입입니다.
 	 * @param token 이 노드를 만드는데 사용된 가장 첫번째 토큰입니다.
 	 * @param type 참조할 값의 타입입니다.
 	 */
-	Reference::Reference(const Token& token, TypePtr type)
-		: Type(token), type(type)
+	Reference::Reference(TypeKind kind, const Token& token, TypePtr type)
+		: Type(kind, token), type(type)
 	{}
+	bool Reference::classof(const Type* node) noexcept
+	{
+		return node->kind == TypeKind::LValueReference;
+	}
 	llvm::Type* Reference::get_type()
 	{
 		return type->get_type()->getPointerTo();
 	}
 
-	std::string LValueReference::tree_gen(std::size_t depth) const
+	/**
+	 * @brief 새 LValueReference 인스턴스를 만듭니다.
+	 * @param token 이 노드를 만드는데 사용된 가장 첫번째 토큰입니다.
+	 * @param type 참조할 값의 타입입니다.
+	 */
+	LValueReference::LValueReference(const Token& token, TypePtr type)
+		: Reference(TypeKind::LValueReference, token, type)
+	{}
+	bool LValueReference::classof(const Type* node) noexcept
 	{
-		return tree_prefix(depth) + "LValueReference:\n" +
-			tree_prefix(depth + 1) + "type:\n" + type->tree_gen(depth + 1);
+		return node->kind == TypeKind::LValueReference;
 	}
 
 	/**
@@ -118,12 +122,11 @@ namespace Dlink
 	 * @param type 포인터의 원본 타입입니다.
 	 */
 	Pointer::Pointer(const Token& token, TypePtr type)
-		: Type(token), type(type)
+		: Type(TypeKind::Pointer, token), type(type)
 	{}
-	std::string Pointer::tree_gen(std::size_t depth) const
+	bool Pointer::classof(const Type* node) noexcept
 	{
-		return tree_prefix(depth) + "PointerType:\n" +
-			type->tree_gen(depth + 1);
+		return node->kind == TypeKind::Pointer;
 	}
 	llvm::Type* Pointer::get_type()
 	{
@@ -3,23 +3,34 @@
 
 namespace Dlink
 {
+	/**
+	 * @brief 렉서로부터 토큰을 하나씩 가져오며 파싱하는 새 Parser 인스턴스를 만듭니다.
+	 * @details 토큰 목록을 만들지 않으므로 렉싱 작업과 파싱 작업이 번갈아 수행됩니다.
+	 * @param lexer 토큰을 가져올 렉서입니다.
+	 */
+	Parser::Parser(Lexer& lexer)
+		: token_stream_(lexer), source_(lexer.get_source())
+	{}
 	/**
 	 * @brief 새 Parser 인스턴스를 만듭니다.
+	 * @details input을 복사하지 않으므로, 파싱하는 동안에는 input이 살아있어야 합니다.
 	 * @param input 렉서를 통해 만들어진 토큰 목록입니다.
+	 * @param source input을 만드는데 사용된 소스 버퍼입니다.
 	 */
-	Parser::Parser(const TokenSeq& input)
-		: token_seq_(input), token_iter_(token_seq_.cbegin())
+	Parser::Parser(const TokenSeq& input, const SourceFile& source)
+		: token_stream_(input), source_(source)
 	{}
 
 	/**
 	 * @brief 토큰 목록을 이용해 파싱한 후 추상 구문 트리를 만듭니다.
-	 * @details 생성자를 통해 입력받은 토큰 목록을 사용합니다.
+	 * @details 생성자를 통해 입력받은 렉서나 토큰 목록을 사용합니다.
 	 * @return 파싱에 성공하면 true, 실패하면 false를 반환합니다.
-	 * @see Dlink::Parser::Parser(const TokenSeq&)
+	 * @see Dlink::Parser::Parser(Lexer&)
+	 * @see Dlink::Parser::Parser(const TokenSeq&, const SourceFile&)
 	 */
 	bool Parser::parse()
 	{
-		StatementPtr statement;
+		StatementPtr statement = nullptr;
 		bool ret = block(statement);
 
 		ast_.node_ = statement;
@@ -62,7 +73,7 @@ namespace Dlink
 		return warnings_;
 	}
 
-	void Parser::assign_token(Token* dest, Token source)
+	void Parser::assign_token(Token* dest, const Token& source)
 	{
 		if (dest)
 		{
@@ -70,23 +81,23 @@ namespace Dlink
 		}
 	}
 
-	Token Parser::current_token() const
+	const Token& Parser::current_token() const noexcept
 	{
-		return *token_iter_;
+		return token_stream_.current();
 	}
-	Token Parser::previous_token() const
+	const Token& Parser::previous_token() const noexcept
 	{
-		return *(token_iter_ - 1);
+		return token_stream_.previous();
 	}
-	Token Parser::next_token() const
+	const Token& Parser::next_token() const noexcept
 	{
-		return *(token_iter_ + 1);
+		return token_stream_.next();
 	}
 	bool Parser::accept(TokenType token_type, Token* start_token)
 	{
-		if ((*token_iter_).type == token_type)
+		if (token_stream_.current().type == token_type)
 		{
-			token_iter_++;
+			token_stream_.advance();
 
 			assign_token(start_token, previous_token());
 			return true;
@@ -101,7 +112,7 @@ namespace Dlink
 	bool Parser::block(StatementPtr& out, Token* start_token)
 	{
 		std::vector<StatementPtr> statements;
-		StatementPtr statement;
+		StatementPtr statement = nullptr;
 
 		Token block_start;
 		while (scope(statement, &block_start))
@@ -112,7 +123,7 @@ namespace Dlink
 
 		if (errors_.get_errors().empty())
 		{
-			out = std::make_shared<Block>(block_start, statements);
+			out = make_node<Block>(block_start, statements);
 
 			assign_token(start_token, block_start);
 			return true;
@@ -123,54 +134,82 @@ namespace Dlink
 		}
 	}
 
+	/**
+	 * @brief 중괄호로 감싸진 스코프나 문 하나를 파싱합니다.
+	 * @details 중첩된 스코프를 재귀 호출 대신 명시적 스택으로 파싱하므로, 스코프가 아무리 깊게 중첩되어도 네이티브 스택을 일정하게 사용합니다.
+	 * @param out 파싱한 문을 저장할 포인터입니다.
+	 * @param start_token 문의 첫번째 토큰을 저장할 포인터입니다.
+	 * @return 파싱에 성공했다면 true, 실패했다면 false를 반환합니다.
+	 */
 	bool Parser::scope(StatementPtr& out, Token* start_token)
 	{
-		Token scope_start;
-		if (accept(TokenType::lbrace, &scope_start))
+		struct OpenScope
 		{
+			Token start;
 			std::vector<StatementPtr> statements;
-			StatementPtr statement;
-			while (scope(statement))
+		};
+
+		std::vector<OpenScope> open_scopes;
+
+		while (true)
+		{
+			Token scope_start;
+			if (accept(TokenType::lbrace, &scope_start))
 			{
-				statements.push_back(statement);
-				statement = nullptr;
+				open_scopes.push_back({ scope_start, {} });
+				continue;
 			}
 
-			if (accept(TokenType::rbrace))
+			StatementPtr statement = nullptr;
+
+			Token statement_start;
+			if (var_decl(statement, &statement_start))
 			{
-				out = std::make_shared<Scope>(scope_start, statements, nullptr/* TODO: it's temp */);
+				if (open_scopes.empty())
+				{
+					out = statement;
 
-				assign_token(start_token, scope_start);
-				return true;
+					assign_token(start_token, statement_start);
+					return true;
+				}
+
+				open_scopes.back().statements.push_back(statement);
+				continue;
 			}
-			else
+
+			if (open_scopes.empty())
 			{
-				errors_.add_error(Error(current_token(), "Expected '}', but got \"" + current_token().data + "\""));
 				return false;
 			}
-		}
-		else
-		{
-			StatementPtr statement;
 
-			Token var_decl_start;
-			if (var_decl(statement, &var_decl_start))
+			if (accept(TokenType::rbrace))
 			{
-				out = statement;
+				OpenScope closed = std::move(open_scopes.back());
+				open_scopes.pop_back();
 
-				assign_token(start_token, var_decl_start);
-				return true;
-			}
+				statement = make_node<Scope>(closed.start, closed.statements, nullptr/* TODO: it's temp */);
 
-			return false;
-		}
+				if (open_scopes.empty())
+				{
+					out = statement;
 
-		return true;
+					assign_token(start_token, closed.start);
+					return true;
+				}
+
+				open_scopes.back().statements.push_back(statement);
+			}
+			else
+			{
+				errors_.add_error(Error(current_token(), "Expected '}', but got \"" + source_.text(current_token()) + "\""));
+				return false;
+			}
+		}
 	}
 
 	bool Parser::var_decl(StatementPtr& out, Token* start_token)
 	{
-		TypePtr type_expr;
+		TypePtr type_expr = nullptr;
 
 		Token unsafe_start;
 		bool is_unsafe = false;
@@ -184,21 +223,21 @@ namespace Dlink
 		{
 			if (accept(TokenType::identifier))
 			{
-				std::string name = previous_token().data;
+				Symbol name = previous_token().symbol;
 
 				if (accept(TokenType::assign))
 				{
-					ExpressionPtr expression;
+					ExpressionPtr expression = nullptr;
 
 					if (expr(expression))
 					{
 						if (accept(TokenType::semicolon))
 						{
-							StatementPtr var = std::make_shared<VariableDeclaration>(var_decl_start, type_expr, name, expression);
+							StatementPtr var = make_node<VariableDeclaration>(var_decl_start, type_expr, name, expression);
 
 							if (is_unsafe)
 							{
-								out = std::make_shared<UnsafeStatement>(unsafe_start, var);
+								out = make_node<UnsafeStatement>(unsafe_start, var);
 								assign_token(start_token, unsafe_start);
 							}
 							else
@@ -211,23 +250,23 @@ namespace Dlink
 						}
 						else
 						{
-							errors_.add_error(Error(current_token(), "Expected ';', but got \"" + current_token().data + "\""));
+							errors_.add_error(Error(current_token(), "Expected ';', but got \"" + source_.text(current_token()) + "\""));
 							return false;
 						}
 					}
 					else
 					{
-						errors_.add_error(Error(current_token(), "Expected expression, but got \"" + current_token().data + "\""));
+						errors_.add_error(Error(current_token(), "Expected expression, but got \"" + source_.text(current_token()) + "\""));
 						return false;
 					}
 				}
 				else if (accept(TokenType::semicolon))
 				{
-					StatementPtr var = std::make_shared<VariableDeclaration>(var_decl_start, type_expr, name);
+					StatementPtr var = make_node<VariableDeclaration>(var_decl_start, type_expr, name);
 
 					if (is_unsafe)
 					{
-						out = std::make_shared<UnsafeStatement>(unsafe_start, var);
+						out = make_node<UnsafeStatement>(unsafe_start, var);
 						assign_token(start_token, unsafe_start);
 					}
 					else
@@ -244,7 +283,7 @@ namespace Dlink
 				}
 			}
 
-			errors_.add_error(Error(current_token(), "Expected identifier, but got \"" + current_token().data + "\""));
+			errors_.add_error(Error(current_token(), "Expected identifier, but got \"" + source_.text(current_token()) + "\""));
 			return false;
 		}
 		else
@@ -255,7 +294,7 @@ namespace Dlink
 				return false;
 			}
 
-			StatementPtr statement;
+			StatementPtr statement = nullptr;
 
 			Token return_start;
 			if (return_stmt(statement, &return_start))
@@ -270,13 +309,13 @@ namespace Dlink
 		}
 	}
 
-	bool Parser::func_decl(StatementPtr& out, Token var_decl_start_token, TypePtr return_type, const std::string& identifier, Token unsafe_start, bool is_unsafe, Token* start_token)
+	bool Parser::func_decl(StatementPtr& out, Token var_decl_start_token, TypePtr return_type, Symbol identifier, Token unsafe_start, bool is_unsafe, Token* start_token)
 	{
 		std::vector<VariableDeclaration> param_list;
 
 		while (true)
 		{
-			TypePtr param_type;
+			TypePtr param_type = nullptr;
 			if (type(param_type))
 			{
 				if (param_type->token.type == TokenType::_void)
@@ -293,7 +332,7 @@ namespace Dlink
 				{
 					if (accept(TokenType::identifier))
 					{
-						VariableDeclaration param(var_decl_start_token, param_type, previous_token().data);
+						VariableDeclaration param(var_decl_start_token, param_type, previous_token().symbol);
 						param_list.push_back(param);
 
 						if (accept(TokenType::comma))
@@ -301,7 +340,7 @@ namespace Dlink
 					}
 					else if (accept(TokenType::comma))
 					{
-						VariableDeclaration param(var_decl_start_token, param_type, "");
+						VariableDeclaration param(var_decl_start_token, param_type, Symbol());
 						param_list.push_back(param);
 						continue;
 					}
@@ -311,24 +350,24 @@ namespace Dlink
 				break;
 			else
 			{
-				errors_.add_error(Error(current_token(), "Unexpected \"" + current_token().data + "\""));
+				errors_.add_error(Error(current_token(), "Unexpected \"" + source_.text(current_token()) + "\""));
 				return false;
 			}
 		}
 
-		StatementPtr body;
+		StatementPtr body = nullptr;
 
 		if (!scope(body))
 		{
-			errors_.add_error(Error(current_token(), "Unexpected \"" + current_token().data + "\""));
+			errors_.add_error(Error(current_token(), "Unexpected \"" + source_.text(current_token()) + "\""));
 			return false;
 		}
 
-		StatementPtr func = std::make_shared<FunctionDeclaration>(var_decl_start_token, return_type, identifier, param_list, body);
+		StatementPtr func = make_node<FunctionDeclaration>(var_decl_start_token, return_type, identifier, param_list, body);
 
 		if (is_unsafe)
 		{
-			out = std::make_shared<UnsafeStatement>(unsafe_start, func);
+			out = make_node<UnsafeStatement>(unsafe_start, func);
 			assign_token(start_token, unsafe_start);
 		}
 		else
@@ -345,26 +384,26 @@ namespace Dlink
 		Token return_start;
 		if (accept(TokenType::_return, &return_start))
 		{
-			ExpressionPtr return_expr;
+			ExpressionPtr return_expr = nullptr;
 
 			expr(return_expr);
 
 			if (accept(TokenType::semicolon))
 			{
-				out = std::make_shared<ReturnStatement>(return_start, return_expr);
+				out = make_node<ReturnStatement>(return_start, return_expr);
 
 				assign_token(start_token, return_start);
 				return true;
 			}
 			else
 			{
-				errors_.add_error(Error(current_token(), "Expected ';', but got \"" + current_token().data + "\""));
+				errors_.add_error(Error(current_token(), "Expected ';', but got \"" + source_.text(current_token()) + "\""));
 				return false;
 			}
 		}
 		else
 		{
-			StatementPtr statement;
+			StatementPtr statement = nullptr;
 
 			Token expr_stmt_start;
 			if (expr_stmt(statement, &expr_stmt_start))
@@ -388,7 +427,7 @@ namespace Dlink
 
 	bool Parser::expr_stmt(StatementPtr& out, Token* start_token)
 	{
-		ExpressionPtr expression;
+		ExpressionPtr expression = nullptr;
 
 		Token expr_stmt_start;
 		if (!expr(expression, &expr_stmt_start))
@@ -398,14 +437,14 @@ namespace Dlink
 
 		if (accept(TokenType::semicolon))
 		{
-			out = std::make_shared<ExpressionStatement>(expr_stmt_start, expression);
+			out = make_node<ExpressionStatement>(expr_stmt_start, expression);
 
 			assign_token(start_token, expr_stmt_start);
 			return true;
 		}
 		else
 		{
-			errors_.add_error(Error(current_token(), "Expected ';', but got \"" + current_token().data + "\""));
+			errors_.add_error(Error(current_token(), "Expected ';', but got \"" + source_.text(current_token()) + "\""));
 			return false;
 		}
 	}
@@ -413,294 +452,389 @@ namespace Dlink
 
 namespace Dlink
 {
-	bool Parser::expr(ExpressionPtr& out, Token* start_token)
+	namespace
 	{
-		Token unsafe_start;
-		if (accept(TokenType::unsafe, &unsafe_start))
+		/**
+		 * @brief Parser::expr에서 하위 식을 기다리고 있는 문법 규칙 하나입니다.
+		 * @details 재귀 하강 파서에서 하위 식을 파싱하기 위해 호출된 함수 하나에 대응합니다.
+		 */
+		struct ExpressionFrame
 		{
-			ExpressionPtr expr;
-			if (!assign(expr))
+			enum Kind
 			{
-				errors_.add_error(Error(current_token(), "Expected expression, but got \"" + current_token().data + "\""));
-				return false;
-			}
-
-			out = std::make_shared<UnsafeExpression>(unsafe_start, expr);
-			assign_token(start_token, unsafe_start);
-			return true;
-		}
-		else
-		{
-			return assign(out, start_token);
-		}
+				unsafe,
+				unary,
+				binary,
+				paren,
+				array_init_list,
+				func_call,
+			};
+
+			Kind kind;
+			/** 이 규칙이 만들 식의 가장 첫번째 토큰입니다. */
+			Token start;
+			/** 단항 연산자이거나, 우측 피연산자를 기다리는 이항 연산자입니다. 이항 연산에서 아직 첫번째 피연산자를 기다리고 있다면 TokenType::none입니다. */
+			TokenType op = TokenType::none;
+			/** 결합할 이항 연산자의 최소 우선순위입니다. */
+			int min_precedence = 0;
+			/** 이항 연산의 좌측 피연산자이거나, 호출할 함수의 식입니다. */
+			ExpressionPtr lhs = nullptr;
+			/** 배열 초기화 리스트의 원소들이거나, 함수 호출의 인수들입니다. */
+			std::vector<ExpressionPtr> operands;
+		};
 	}
 
-	bool Parser::assign(ExpressionPtr& out, Token* start_token)
+	/**
+	 * @brief 식을 파싱합니다.
+	 * @details 재귀 하강 대신 ExpressionFrame의 명시적 스택을 사용하므로, 괄호나 배열 초기화 리스트, 단항 연산자가 아무리 깊게 중첩되어도 네이티브 스택을 일정하게 사용합니다. 이항 연산자는 우선순위 상승(precedence climbing) 방식으로 결합합니다.
+	 * @param out 파싱한 식을 저장할 포인터입니다.
+	 * @param start_token 식의 첫번째 토큰을 저장할 포인터입니다.
+	 * @return 파싱에 성공했다면 true, 실패했다면 false를 반환합니다.
+	 */
+	bool Parser::expr(ExpressionPtr& out, Token* start_token)
 	{
-		ExpressionPtr lhs;
-
-		Token assign_start;
-		if (!addsub(lhs, &assign_start))
+		enum
 		{
-			return false;
-		}
-
-		TokenType op;
+			begin_expr,		// 'unsafe'가 붙을 수 있는 식을 시작합니다.
+			begin_operand,	// 단항 연산자가 붙을 수 있는 피연산자를 시작합니다.
+			postfix,		// 방금 만든 식 뒤에 함수 호출이 이어지는지 확인합니다.
+			reduce,			// 방금 만든 식을 스택 맨 위의 규칙에 전달합니다.
+			fail,			// 스택 맨 위의 규칙에 하위 식이 실패했음을 알립니다.
+		} action = begin_expr;
 
-		std::vector<ExpressionPtr> operands;
-		operands.push_back(lhs);
+		std::vector<ExpressionFrame> frames;
+		ExpressionPtr value = nullptr;
+		Token value_start;
 
-		while (accept(TokenType::assign))
+		while (true)
 		{
-			op = previous_token().type;
-
-			ExpressionPtr rhs;
-			if (!addsub(rhs))
+			switch (action)
 			{
-				errors_.add_error(Error(current_token(), "Expected expression, but got \"" + current_token().data + "\""));
-				return false;
-			}
+			case begin_expr:
+			{
+				ExpressionFrame frame;
+				if (accept(TokenType::unsafe, &frame.start))
+				{
+					frame.kind = ExpressionFrame::unsafe;
+					frames.push_back(frame);
+				}
 
-			operands.push_back(rhs);
-		}
+				frame = ExpressionFrame();
+				frame.kind = ExpressionFrame::binary;
+				frame.min_precedence = lowest_precedence_;
+				frames.push_back(frame);
 
-		ExpressionPtr result;
+				action = begin_operand;
+				break;
+			}
 
-		result = operands.back();
-		operands.pop_back();
-		std::reverse(operands.begin(), operands.end());
+			case begin_operand:
+			{
+				ExpressionFrame frame;
+				if (accept(TokenType::plus, &frame.start) || accept(TokenType::minus, &frame.start) ||
+					accept(TokenType::multiply, &frame.start) || accept(TokenType::bit_and, &frame.start) ||
+					accept(TokenType::exclamation, &frame.start) || accept(TokenType::bit_not, &frame.start))
+				{
+					frame.kind = ExpressionFrame::unary;
+					frame.op = previous_token().type;
+					frames.push_back(frame);
+				}
+				else if (accept(TokenType::lparen, &frame.start))
+				{
+					frame.kind = ExpressionFrame::paren;
+					frames.push_back(frame);
 
-		for (ExpressionPtr operand : operands)
-		{
-			result = std::make_shared<BinaryOperation>(assign_start, TokenType::assign, operand, result);
-		}
+					action = begin_expr;
+				}
+				else if (accept(TokenType::lbrace, &frame.start))
+				{
+					if (accept(TokenType::rbrace))
+					{
+						value = make_node<ArrayInitList>(frame.start, std::vector<ExpressionPtr>{});
+						value_start = frame.start;
 
-		out = result;
+						action = postfix;
+					}
+					else
+					{
+						frame.kind = ExpressionFrame::array_init_list;
+						frames.push_back(frame);
 
-		assign_token(start_token, assign_start);
-		return true;
-	}
+						action = begin_expr;
+					}
+				}
+				else
+				{
+					value = nullptr;
+					action = atom(value, &value_start) ? postfix : fail;
+				}
+				break;
+			}
 
-	bool Parser::addsub(ExpressionPtr& out, Token* start_token)
-	{
-		ExpressionPtr lhs;
+			case postfix:
+			{
+				if (accept(TokenType::lparen))
+				{
+					ExpressionFrame frame;
+					frame.kind = ExpressionFrame::func_call;
+					frame.start = value_start;
+					frame.lhs = value;
+					frames.push_back(frame);
 
-		Token addsub_start;
-		if (!muldiv(lhs, &addsub_start))
-		{
-			return false;
-		}
+					action = begin_expr;
+				}
+				else
+				{
+					action = reduce;
+				}
+				break;
+			}
 
-		TokenType op;
+			case reduce:
+			{
+				if (frames.empty())
+				{
+					out = value;
 
-		while (accept(TokenType::plus) || accept(TokenType::minus))
-		{
-			op = previous_token().type;
+					assign_token(start_token, value_start);
+					return true;
+				}
 
-			ExpressionPtr rhs;
-			if (!muldiv(rhs))
-			{
-				errors_.add_error(Error(current_token(), "Expected expression, but got \"" + current_token().data + "\""));
-				return false;
-			}
+				ExpressionFrame& frame = frames.back();
 
-			lhs = std::make_shared<BinaryOperation>(addsub_start, op, lhs, rhs);
-		}
+				switch (frame.kind)
+				{
+				case ExpressionFrame::unsafe:
+					value = make_node<UnsafeExpression>(frame.start, value);
+					value_start = frame.start;
+					frames.pop_back();
+					break;
 
-		out = lhs;
+				case ExpressionFrame::unary:
+					value = make_node<UnaryOperation>(frame.start, frame.op, value);
+					value_start = frame.start;
+					frames.pop_back();
+					break;
 
-		assign_token(start_token, addsub_start);
-		return true;
-	}
+				case ExpressionFrame::binary:
+				{
+					if (frame.op == TokenType::none)
+					{
+						frame.lhs = value;
+						frame.start = value_start;
+					}
+					else
+					{
+						frame.lhs = make_node<BinaryOperation>(frame.start, frame.op, frame.lhs, value);
+					}
 
-	bool Parser::muldiv(ExpressionPtr& out, Token* start_token)
-	{
-		ExpressionPtr lhs;
+					TokenType op = current_token().type;
+					int precedence = binary_precedence_(op);
 
-		Token muldiv_start;
-		if (!unary(lhs, &muldiv_start))
-		{
-			return false;
-		}
+					if (precedence == 0 || precedence < frame.min_precedence)
+					{
+						value = frame.lhs;
+						value_start = frame.start;
+						frames.pop_back();
+						break;
+					}
 
-		TokenType op;
+					accept(op);
+					frame.op = op;
 
-		while (accept(TokenType::multiply) || accept(TokenType::divide))
-		{
-			op = previous_token().type;
+					// 대입 연산자는 오른쪽부터, 나머지 연산자는 왼쪽부터 결합합니다.
+					ExpressionFrame rhs_frame;
+					rhs_frame.kind = ExpressionFrame::binary;
+					rhs_frame.min_precedence = precedence == lowest_precedence_ ? precedence : precedence + 1;
+					frames.push_back(rhs_frame);
 
-			ExpressionPtr rhs;
-			if (!unary(rhs))
-			{
-				errors_.add_error(Error(current_token(), "Expected expression, but got \"" + current_token().data + "\""));
-				return false;
-			}
+					action = begin_operand;
+					break;
+				}
 
-			lhs = std::make_shared<BinaryOperation>(muldiv_start, op, lhs, rhs);
-		}
+				case ExpressionFrame::paren:
+					if (accept(TokenType::rparen))
+					{
+						value_start = frame.start;
+						frames.pop_back();
 
-		out = lhs;
+						action = postfix;
+					}
+					else
+					{
+						errors_.add_error(Error(current_token(), "Expected ')', but got \"" + source_.text(current_token()) + "\""));
+						frames.pop_back();
 
-		assign_token(start_token, muldiv_start);
-		return true;
-	}
+						action = fail;
+					}
+					break;
 
-	bool Parser::unary(ExpressionPtr& out, Token* start_token)
-	{
-		return unary_plusminus(out, start_token) || unary_address(out, start_token);
-	}
+				case ExpressionFrame::array_init_list:
+					frame.operands.push_back(value);
 
-	bool Parser::func_call(ExpressionPtr& out, Token* start_token)
-	{
-		ExpressionPtr func_expr;
+					if (accept(TokenType::comma))
+					{
+						action = begin_expr;
+					}
+					else if (accept(TokenType::rbrace))
+					{
+						value = make_node<ArrayInitList>(frame.start, frame.operands);
+						value_start = frame.start;
+						frames.pop_back();
 
-		Token func_call_start;
-		if (!paren(func_expr, &func_call_start))
-		{
-			return false;
-		}
+						action = postfix;
+					}
+					else
+					{
+						errors_.add_error(Error(current_token(), "Expected '}' or ',', but got \"" + source_.text(current_token()) + "\""));
+						frames.pop_back();
 
-		while (accept(TokenType::lparen))
-		{
-			std::vector<ExpressionPtr> arg;
+						action = fail;
+					}
+					break;
 
-			while (true)
-			{
-				ExpressionPtr a_arg;
-				if (expr(a_arg))
-				{
-					arg.push_back(a_arg);
+				case ExpressionFrame::func_call:
+					frame.operands.push_back(value);
 
 					if (accept(TokenType::rparen))
 					{
-						func_expr = std::make_shared<FunctionCallOperation>(func_call_start, func_expr, arg);
+						value = make_node<FunctionCallOperation>(frame.start, frame.lhs, frame.operands);
+						value_start = frame.start;
+						frames.pop_back();
 
-						break;
+						action = postfix;
 					}
 					else if (accept(TokenType::comma))
 					{
-						continue;
+						action = begin_expr;
 					}
 					else
 					{
-						errors_.add_error(Error(current_token(), "Expected ',' or ';', but got \"" + current_token().data + "\""));
-						return false;
-					}
-				}
-				else if (accept(TokenType::rparen))
-				{
-					func_expr = std::make_shared<FunctionCallOperation>(func_call_start, func_expr, arg);
+						errors_.add_error(Error(current_token(), "Expected ',' or ';', but got \"" + source_.text(current_token()) + "\""));
+						frames.pop_back();
 
+						action = fail;
+					}
 					break;
 				}
+				break;
 			}
-		}
 
-		out = func_expr;
-		assign_token(start_token, func_call_start);
-
-		return true;
-	}
+			case fail:
+			{
+				if (frames.empty())
+				{
+					return false;
+				}
 
-	bool Parser::paren(ExpressionPtr& out, Token* start_token)
-	{
-		Token paren_start;
-		if (accept(TokenType::lparen, &paren_start))
-		{
-			ExpressionPtr expression;
-			expr(expression);
+				ExpressionFrame& frame = frames.back();
 
-			if (accept(TokenType::rparen))
-			{
-				out = expression;
+				switch (frame.kind)
+				{
+				case ExpressionFrame::binary:
+					// 첫번째 피연산자가 없다면 식이 아닌 것이므로 오류를 보고하지 않습니다.
+					if (frame.op == TokenType::none)
+					{
+						frames.pop_back();
+						break;
+					}
+					// fallthrough
 
-				assign_token(start_token, paren_start);
-				return true;
-			}
-			else
-			{
-				errors_.add_error(Error(current_token(), "Expected ')', but got \"" + current_token().data + "\""));
+				case ExpressionFrame::unsafe:
+				case ExpressionFrame::unary:
+					errors_.add_error(Error(current_token(), "Expected expression, but got \"" + source_.text(current_token()) + "\""));
+					frames.pop_back();
+					break;
 
-				return false;
-			}
-		}
-		else
-		{
-			ExpressionPtr array_list_expr;
+				case ExpressionFrame::paren:
+				case ExpressionFrame::array_init_list:
+					// 빈 식을 허용합니다.
+					value = nullptr;
+					action = reduce;
+					break;
 
-			Token list_start;
-			if (array_init_list(array_list_expr, &list_start))
-			{
-				out = array_list_expr;
+				case ExpressionFrame::func_call:
+					if (accept(TokenType::rparen))
+					{
+						value = make_node<FunctionCallOperation>(frame.start, frame.lhs, frame.operands);
+						value_start = frame.start;
+						frames.pop_back();
 
-				assign_token(start_token, list_start);
-				return true;
+						action = postfix;
+					}
+					else
+					{
+						errors_.add_error(Error(current_token(), "Expected expression, but got \"" + source_.text(current_token()) + "\""));
+						frames.pop_back();
+					}
+					break;
+				}
+				break;
 			}
-			else
-			{
-				return false;
 			}
 		}
 	}
 
-	bool Parser::array_init_list(ExpressionPtr& out, Token* start_token)
+	/**
+	 * @brief 이항 연산자의 우선순위를 가져옵니다.
+	 * @details 값이 클수록 먼저 결합합니다. 대입 연산자들은 가장 낮은 우선순위를 가지며 오른쪽부터 결합합니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param token_type 우선순위를 가져올 토큰의 타입입니다.
+	 * @return 이항 연산자의 우선순위를 반환합니다. 이항 연산자가 아니라면 0을 반환합니다.
+	 */
+	int Parser::binary_precedence_(TokenType token_type) noexcept
 	{
-		Token list_start;
-		if (accept(TokenType::lbrace, &list_start))
+		switch (token_type)
 		{
-			if (accept(TokenType::rbrace))
-			{
-				out = std::make_shared<ArrayInitList>(list_start, std::vector<ExpressionPtr>{});
-
-				assign_token(start_token, list_start);
-				return true;
-			}
-
-			std::vector<ExpressionPtr> elements;
-
-			while (true)
-			{
-				ExpressionPtr expression;
-				expr(expression);
-				elements.push_back(expression);
-
-				if (accept(TokenType::comma))
-				{
-					continue;
-				}
-				else if (accept(TokenType::rbrace))
-				{
-					break;
-				}
-				else
-				{
-					errors_.add_error(Error(current_token(), "Expected '}' or ',', but got \"" + current_token().data + "\""));
-
-					return false;
-				}
-			}
-
-			out = std::make_shared<ArrayInitList>(list_start, elements);
-
-			assign_token(start_token, list_start);
-			return true;
-		}
-		else
-		{
-			ExpressionPtr atom_expr;
-
-			Token atom_start;
-			if (atom(atom_expr, &atom_start))
-			{
-				out = atom_expr;
-
-				assign_token(start_token, atom_start);
-				return true;
-			}
-			else
-			{
-				return false;
-			}
+		case TokenType::multiply:
+		case TokenType::divide:
+		case TokenType::modulo:
+			return 11;
+
+		case TokenType::plus:
+		case TokenType::minus:
+			return 10;
+
+		case TokenType::bit_lshift:
+		case TokenType::bit_rshift:
+			return 9;
+
+		case TokenType::less:
+		case TokenType::eqless:
+		case TokenType::greater:
+		case TokenType::eqgreater:
+			return 8;
+
+		case TokenType::equal:
+		case TokenType::noteq:
+			return 7;
+
+		case TokenType::bit_and:
+			return 6;
+		case TokenType::bit_xor:
+			return 5;
+		case TokenType::bit_or:
+			return 4;
+
+		case TokenType::logic_and:
+			return 3;
+		case TokenType::logic_or:
+			return 2;
+
+		case TokenType::assign:
+		case TokenType::plus_assign:
+		case TokenType::minus_assign:
+		case TokenType::multiply_assign:
+		case TokenType::divide_assign:
+		case TokenType::modulo_assign:
+		case TokenType::bit_and_assign:
+		case TokenType::bit_or_assign:
+		case TokenType::bit_xor_assign:
+		case TokenType::bit_lshift_assign:
+		case TokenType::bit_rshift_assign:
+			return lowest_precedence_;
+
+		default:
+			return 0;
 		}
 	}
 
@@ -715,73 +849,12 @@ namespace Dlink
 
 namespace Dlink
 {
-	bool Parser::unary_plusminus(ExpressionPtr& out, Token* start_token)
-	{
-		Token plusminus_start;
-		if (accept(TokenType::plus, &plusminus_start) || accept(TokenType::minus, &plusminus_start))
-		{
-			TokenType op = previous_token().type;
-
-			ExpressionPtr rhs;
-			if (!func_call(rhs))
-			{
-				errors_.add_error(Error(current_token(), "Expected expression, but got \"" + current_token().data + "\""));
-				return false;
-			}
-
-			out = std::make_shared<UnaryOperation>(plusminus_start, op, rhs);
-			assign_token(start_token, plusminus_start);
-
-			return true;
-		}
-		else
-		{
-			Token func_call_start;
-
-			ExpressionPtr func_call_expr;
-			if (func_call(func_call_expr, &func_call_start))
-			{
-				out = func_call_expr;
-
-				assign_token(start_token, func_call_start);
-				return true;
-			}
-			else
-			{
-				return false;
-			}
-		}
-	}
-
-	bool Parser::unary_address(ExpressionPtr& out, Token* start_token)
-	{
-		Token address_start;
-		if (accept(TokenType::multiply, &address_start) || accept(TokenType::bit_and, &address_start))
-		{
-			TokenType op = previous_token().type;
-
-			ExpressionPtr rhs;
-			if (!func_call(rhs))
-			{
-				errors_.add_error(Error(current_token(), "Expected expression, but got \"" + current_token().data + "\""));
-				return false;
-			}
-
-			out = std::make_shared<UnaryOperation>(address_start, op, rhs);
-			assign_token(start_token, address_start);
-
-			return true;
-		}
-
-		return false;
-	}
-
 	bool Parser::number(ExpressionPtr& out, Token* start_token)
 	{
 		Token number_start;
 		if (accept(TokenType::dec_integer, &number_start))
 		{
-			out = std::make_shared<Integer32>(number_start, std::stoi(previous_token().data));
+			out = make_node<Integer32>(number_start, std::stoi(source_.text(previous_token())));
 
 			assign_token(start_token, number_start);
 			return true;
@@ -795,7 +868,7 @@ namespace Dlink
 		Token identifier_start;
 		if (accept(TokenType::identifier, &identifier_start))
 		{
-			out = std::make_shared<Identifier>(identifier_start, previous_token().data);
+			out = make_node<Identifier>(identifier_start, previous_token().symbol);
 
 			assign_token(start_token, identifier_start);
 			return true;
@@ -844,7 +917,7 @@ namespace Dlink
 		Token string_start;
 		if (accept(TokenType::string, &string_start))
 		{
-			out = std::make_shared<String>(string_start, unescape(previous_token().data));
+			out = make_node<String>(string_start, unescape(source_.text(previous_token())));
 
 			assign_token(start_token, string_start);
 			return true;
@@ -858,7 +931,7 @@ namespace Dlink
 		Token char_start;
 		if (accept(TokenType::character, &char_start))
 		{
-			out = std::make_shared<Character>(char_start, unescape(previous_token().data)[0]);
+			out = make_node<Character>(char_start, unescape(source_.text(previous_token()))[0]);
 
 			assign_token(start_token, char_start);
 			return true;
@@ -878,7 +951,7 @@ namespace Dlink
 	bool Parser::array_type(TypePtr& out, Token* start_token)
 	{
 		Token array_start_token;
-		TypePtr type;
+		TypePtr type = nullptr;
 
 		if (reference_type(type, &array_start_token))
 		{
@@ -887,12 +960,12 @@ namespace Dlink
 			if (accept(TokenType::lbparen))
 			{
 			loop:
-				ExpressionPtr length;
+				ExpressionPtr length = nullptr;
 				if (expr(length))
 				{
 					if (accept(TokenType::rbparen))
 					{
-						lhs_array_type = std::make_shared<StaticArray>(array_start_token, lhs_array_type, length);
+						lhs_array_type = make_node<StaticArray>(array_start_token, lhs_array_type, length);
 
 						if (accept(TokenType::lbparen))
 							goto loop;
@@ -904,7 +977,7 @@ namespace Dlink
 				}
 				else
 				{
-					errors_.add_error(Error(current_token(), "Expected expression, but got \"" + current_token().data + "\""));
+					errors_.add_error(Error(current_token(), "Expected expression, but got \"" + source_.text(current_token()) + "\""));
 					return false;
 				}
 			}
@@ -923,13 +996,13 @@ namespace Dlink
 	bool Parser::reference_type(TypePtr& out, Token* start_token)
 	{
 		Token pointer_start_token;
-		TypePtr type;
+		TypePtr type = nullptr;
 
 		if (pointer_type(type, &pointer_start_token))
 		{
 			if (accept(TokenType::bit_and))
 			{
-				out = std::make_shared<LValueReference>(pointer_start_token, type);
+				out = make_node<LValueReference>(pointer_start_token, type);
 
 				assign_token(start_token, pointer_start_token);
 				return true;
@@ -949,7 +1022,7 @@ namespace Dlink
 	bool Parser::pointer_type(TypePtr& out, Token* start_token)
 	{
 		Token pointer_start;
-		TypePtr pointer;
+		TypePtr pointer = nullptr;
 
 		if (!simple_type(pointer, &pointer_start))
 		{
@@ -958,7 +1031,7 @@ namespace Dlink
 
 		while (accept(TokenType::multiply))
 		{
-			pointer = std::make_shared<Pointer>(pointer_start, pointer);
+			pointer = make_node<Pointer>(pointer_start, pointer);
 		}
 
 		out = pointer;
@@ -985,7 +1058,7 @@ namespace Dlink
 			else if (accept(TokenType::_int))
 			{
 				// unsigned int
-				out = std::make_shared<SimpleType>(simple_type_start, "int", true);
+				out = make_node<SimpleType>(simple_type_start, "int", true);
 
 				assign_token(start_token, simple_type_start);
 				return true;
@@ -998,7 +1071,7 @@ namespace Dlink
 			else
 			{
 				// unsigned int
-				out = std::make_shared<SimpleType>(simple_type_start, "int", true);
+				out = make_node<SimpleType>(simple_type_start, "int", true);
 
 				assign_token(start_token, simple_type_start);
 				return true;
@@ -1019,7 +1092,7 @@ namespace Dlink
 			else if (accept(TokenType::_int))
 			{
 				// signed int
-				out = std::make_shared<SimpleType>(simple_type_start, "int");
+				out = make_node<SimpleType>(simple_type_start, "int");
 
 				assign_token(start_token, simple_type_start);
 				return true;
@@ -1032,7 +1105,7 @@ namespace Dlink
 			else
 			{
 				// signed int
-				out = std::make_shared<SimpleType>(simple_type_start, "int");
+				out = make_node<SimpleType>(simple_type_start, "int");
 
 				assign_token(start_token, simple_type_start);
 				return true;
@@ -1052,7 +1125,7 @@ namespace Dlink
 		else if (accept(TokenType::_int, &simple_type_start))
 		{
 			// int
-			out = std::make_shared<SimpleType>(simple_type_start, "int");
+			out = make_node<SimpleType>(simple_type_start, "int");
 
 			assign_token(start_token, simple_type_start);
 			return true;
@@ -1065,7 +1138,7 @@ namespace Dlink
 		else if (accept(TokenType::_void, &simple_type_start))
 		{
 			// void
-			out = std::make_shared<SimpleType>(simple_type_start, "void");
+			out = make_node<SimpleType>(simple_type_start, "void");
 
 			assign_token(start_token, simple_type_start);
 			return true;
@@ -0,0 +1,470 @@
+#include "Resolver.hh"
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace Dlink
+{
+	/**
+	 * @brief 빈 SymbolTable 인스턴스를 만듭니다.
+	 */
+	SymbolTable::SymbolTable()
+	{
+		grow_();
+	}
+
+	/**
+	 * @brief 현재 스코프와 상위 스코프에서 심볼을 찾습니다.
+	 * @details 하위 스코프의 심볼이 상위 스코프의 같은 이름의 심볼을 가립니다.
+	 * @param name 찾을 심볼입니다.
+	 * @return 심볼을 찾지 못하면 nullptr을, 찾으면 해당 심볼을 선언한 노드를 반환합니다.
+	 */
+	Statement* SymbolTable::find(Symbol name) const
+	{
+		return slots_[slot_(name)].declaration;
+	}
+	/**
+	 * @brief 현재 스코프와 상위 스코프에서 심볼을 찾습니다.
+	 * @param name 찾을 심볼입니다.
+	 * @return 심볼을 찾지 못하면 false를, 찾으면 true를 반환합니다.
+	 */
+	bool SymbolTable::find_bool(Symbol name) const
+	{
+		return !slots_[slot_(name)].name.empty();
+	}
+	/**
+	 * @brief 현재 스코프에 심볼을 추가합니다.
+	 * @details 상위 스코프에 같은 이름의 심볼이 있으면 현재 스코프를 나갈 때까지 가립니다.
+	 * @param name 추가할 심볼입니다.
+	 * @param declaration 심볼을 선언한 노드입니다.
+	 * @return 심볼을 추가했다면 true를, 현재 스코프에 같은 이름의 심볼이 이미 있어 추가하지 않았다면 false를 반환합니다.
+	 */
+	bool SymbolTable::insert(Symbol name, Statement* declaration)
+	{
+		if ((size_ + 1) * 2 > slots_.size())
+		{
+			grow_();
+		}
+
+		Entry_& entry = slots_[slot_(name)];
+		if (!entry.name.empty())
+		{
+			if (entry.depth == depth())
+				return false;
+
+			undo_.push_back({ name, true, entry.declaration, entry.depth });
+			entry.declaration = declaration;
+			entry.depth = depth();
+			return true;
+		}
+
+		// 전역 스코프의 심볼은 지울 일이 없으므로 기록하지 않습니다.
+		if (!scopes_.empty())
+		{
+			undo_.push_back({ name, false, nullptr, 0 });
+		}
+		entry.name = name;
+		entry.declaration = declaration;
+		entry.depth = depth();
+		++size_;
+		return true;
+	}
+
+	/**
+	 * @brief 새 하위 스코프에 들어갑니다.
+	 */
+	void SymbolTable::enter_scope()
+	{
+		scopes_.push_back(undo_.size());
+	}
+	/**
+	 * @brief 현재 스코프를 나갑니다.
+	 * @details 현재 스코프에서 추가한 심볼을 지우고, 그 심볼들이 가렸던 상위 스코프의 심볼을 복원합니다. 현재 스코프에서 추가한 심볼의 개수에 비례하는 시간이 걸립니다.
+	 */
+	void SymbolTable::leave_scope()
+	{
+		const std::size_t mark = scopes_.back();
+		scopes_.pop_back();
+
+		while (undo_.size() > mark)
+		{
+			const Undo_& undo = undo_.back();
+			const std::size_t slot = slot_(undo.name);
+
+			if (undo.is_shadowing)
+			{
+				slots_[slot].declaration = undo.declaration;
+				slots_[slot].depth = undo.depth;
+			}
+			else
+			{
+				erase_(slot);
+			}
+
+			undo_.pop_back();
+		}
+	}
+	/**
+	 * @brief 현재 스코프의 깊이를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 전역 스코프라면 0을, 아니라면 전역 스코프로부터의 깊이를 반환합니다.
+	 */
+	std::size_t SymbolTable::depth() const noexcept
+	{
+		return scopes_.size();
+	}
+	/**
+	 * @brief 모든 심볼과 스코프를 지웁니다.
+	 * @details 할당한 메모리는 해제하지 않습니다. 이 함수는 예외를 발생시키지 않습니다.
+	 */
+	void SymbolTable::clear() noexcept
+	{
+		for (Entry_& entry : slots_)
+		{
+			entry = Entry_();
+		}
+		size_ = 0;
+
+		undo_.clear();
+		scopes_.clear();
+	}
+
+	std::size_t SymbolTable::home_(Symbol name) const noexcept
+	{
+		// 식별자의 해시는 포인터 값이라 하위 비트가 고르지 않으므로, 피보나치 해싱으로 상위 비트를 사용합니다.
+		const std::uint64_t hash = static_cast<std::uint64_t>(std::hash<Symbol>()(name)) * 0x9E3779B97F4A7C15ull;
+		return static_cast<std::size_t>(hash >> shift_);
+	}
+	std::size_t SymbolTable::slot_(Symbol name) const noexcept
+	{
+		const std::size_t mask = slots_.size() - 1;
+
+		std::size_t slot = home_(name);
+		while (!slots_[slot].name.empty() && slots_[slot].name != name)
+		{
+			slot = (slot + 1) & mask;
+		}
+
+		return slot;
+	}
+	void SymbolTable::erase_(std::size_t slot) noexcept
+	{
+		const std::size_t mask = slots_.size() - 1;
+
+		// 뒤따르는 심볼 중 빈 슬롯을 지나야 찾을 수 있게 되는 심볼을 앞으로 당깁니다.
+		std::size_t hole = slot;
+		for (std::size_t next = (hole + 1) & mask; !slots_[next].name.empty(); next = (next + 1) & mask)
+		{
+			const std::size_t home = home_(slots_[next].name);
+			if (((next - home) & mask) >= ((next - hole) & mask))
+			{
+				slots_[hole] = slots_[next];
+				hole = next;
+			}
+		}
+
+		slots_[hole] = Entry_();
+		--size_;
+	}
+	void SymbolTable::grow_()
+	{
+		std::vector<Entry_> old_slots(slots_.empty() ? initial_capacity_ : slots_.size() * 2);
+		old_slots.swap(slots_);
+
+		shift_ = 64;
+		for (std::size_t capacity = slots_.size(); capacity > 1; capacity >>= 1)
+		{
+			--shift_;
+		}
+
+		for (const Entry_& entry : old_slots)
+		{
+			if (!entry.name.empty())
+			{
+				slots_[slot_(entry.name)] = entry;
+			}
+		}
+	}
+
+	/**
+	 * @brief 새 Resolver 인스턴스를 만듭니다.
+	 * @param ast 식별자를 연결할 추상 구문 트리입니다.
+	 */
+	Resolver::Resolver(AST& ast)
+		: ast_(ast)
+	{}
+
+	/**
+	 * @brief 추상 구문 트리의 모든 식별자를 선언에 연결합니다.
+	 * @details 모든 함수를 먼저 전역 스코프에 선언하므로 함수는 선언되기 전에도 호출할 수 있지만, 변수는 선언문 이후에만 사용할 수 있습니다. 트리를 명시적 스택으로 순회하므로 트리가 아무리 깊어도 네이티브 스택을 일정하게 사용합니다.
+	 * 각 식의 타입이 unsigned인지도 하위 식들을 방문한 뒤 그 결과로 계산해 Expression::is_unsigned에 저장하므로, 식 전체를 한 번만 방문합니다.
+	 * @return 모든 식별자를 연결했을 경우 true를, 연결하지 못한 식별자가 있을 경우 false를 반환합니다.
+	 */
+	bool Resolver::resolve()
+	{
+		if (!ast_.node_)
+			return true;
+
+		try
+		{
+			symbol_table_.clear();
+			declare_functions_();
+
+			stack_.clear();
+			stack_.push_back({ Action_::Visit, ast_.node_ });
+
+			while (!stack_.empty())
+			{
+				const Task_ task = stack_.back();
+				stack_.pop_back();
+
+				switch (task.action)
+				{
+				case Action_::Visit:
+					visit_(task.node);
+					break;
+
+				case Action_::Bind:
+					symbol_table_.insert(cast<VariableDeclaration>(task.node)->identifier, cast<VariableDeclaration>(task.node));
+					break;
+
+				case Action_::LeaveScope:
+					symbol_table_.leave_scope();
+					break;
+
+				case Action_::InferSign:
+					infer_sign_(cast<Expression>(task.node));
+					break;
+				}
+			}
+
+			return true;
+		}
+		catch (Error& error)
+		{
+			errors_.add_error(error);
+			return false;
+		}
+	}
+	/**
+	 * @brief 식별자를 연결하는 중 발생한 에러들을 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 에러들을 반환합니다.
+	 */
+	const Errors& Resolver::get_errors() const noexcept
+	{
+		return errors_;
+	}
+
+	void Resolver::declare_functions_()
+	{
+		// Node::preprocess와 같은 후위 순회 순서로 선언해야 이름이 같은 함수 중 어느 것이 이기는지가 바뀌지 않습니다.
+		std::vector<std::pair<Node*, bool>> stack;
+		stack.emplace_back(ast_.node_, false);
+
+		while (!stack.empty())
+		{
+			std::pair<Node*, bool> top = stack.back();
+			stack.pop_back();
+
+			if (top.second)
+			{
+				FunctionDeclaration* function;
+				if ((function = dyn_cast<FunctionDeclaration>(top.first)))
+				{
+					symbol_table_.insert(function->identifier, function);
+				}
+				continue;
+			}
+
+			stack.emplace_back(top.first, true);
+
+			children_.clear();
+			top.first->children(children_);
+			for (auto iter = children_.rbegin(); iter != children_.rend(); ++iter)
+			{
+				if (*iter)
+				{
+					stack.emplace_back(*iter, false);
+				}
+			}
+		}
+	}
+	void Resolver::visit_(Node* node)
+	{
+		// 식의 부호는 하위 식들의 부호로 정해지므로, 하위 노드들보다 먼저 넣어 나중에 계산합니다.
+		if (isa<Expression>(node))
+		{
+			stack_.push_back({ Action_::InferSign, node });
+		}
+
+		// 하위 노드는 LLVM IR 코드를 만드는 순서와 같은 순서로 방문해야 하므로 스택에 거꾸로 넣습니다.
+		switch (node->kind)
+		{
+		case NodeKind::Identifier:
+		{
+			Identifier* identifier = cast<Identifier>(node);
+			identifier->declaration = symbol_table_.find(identifier->id);
+
+			if (!identifier->declaration)
+			{
+				throw Error(identifier->token, "Unbound symbol \"" + identifier->id.str() + "\"");
+			}
+			return;
+		}
+
+		case NodeKind::Scope:
+			symbol_table_.enter_scope();
+			stack_.push_back({ Action_::LeaveScope, node });
+			break;
+
+		case NodeKind::FunctionCallOperation:
+		{
+			FunctionCallOperation* call = cast<FunctionCallOperation>(node);
+
+			Identifier* callee;
+			if ((callee = dyn_cast<Identifier>(call->func_expr)))
+			{
+				// 호출할 수 없는 식별자는 LLVM IR 코드를 만들 때 호출 오류로 보고합니다.
+				callee->declaration = symbol_table_.find(callee->id);
+
+				for (auto iter = call->argument.rbegin(); iter != call->argument.rend(); ++iter)
+				{
+					stack_.push_back({ Action_::Visit, *iter });
+				}
+				return;
+			}
+			break;
+		}
+
+		case NodeKind::VariableDeclaration:
+		{
+			VariableDeclaration* variable = cast<VariableDeclaration>(node);
+
+			// 참조 변수는 아직 LLVM IR 코드를 만들지 않으므로 심볼 테이블에 추가하지 않습니다.
+			if (isa<LValueReference>(variable->type))
+				return;
+
+			stack_.push_back({ Action_::Bind, variable });
+			if (variable->expression)
+			{
+				stack_.push_back({ Action_::Visit, variable->expression });
+			}
+			return;
+		}
+
+		case NodeKind::FunctionDeclaration:
+		{
+			FunctionDeclaration* function = cast<FunctionDeclaration>(node);
+
+			symbol_table_.enter_scope();
+			for (VariableDeclaration& param : function->parameter)
+			{
+				symbol_table_.insert(param.identifier, &param);
+			}
+
+			stack_.push_back({ Action_::LeaveScope, function });
+			if (function->body)
+			{
+				stack_.push_back({ Action_::Visit, function->body });
+			}
+			return;
+		}
+
+		default:
+			break;
+		}
+
+		children_.clear();
+		node->children(children_);
+		for (auto iter = children_.rbegin(); iter != children_.rend(); ++iter)
+		{
+			if (*iter)
+			{
+				stack_.push_back({ Action_::Visit, *iter });
+			}
+		}
+	}
+	void Resolver::infer_sign_(Expression* expression)
+	{
+		// 모든 정수 타입이 int 하나이므로, C의 일반 산술 변환과 같이 산술 연산과 비트 연산은 피연산자 중 하나라도 unsigned면 unsigned가 됩니다.
+		// 시프트 연산과 대입 연산은 좌측 피연산자의 타입을, 비교 연산과 논리 연산은 항상 signed int를 따릅니다.
+		Type* type = nullptr;
+
+		switch (expression->kind)
+		{
+		case NodeKind::Identifier:
+		{
+			Statement* declaration = cast<Identifier>(expression)->declaration;
+			if (declaration && declaration->kind == NodeKind::VariableDeclaration)
+			{
+				type = cast<VariableDeclaration>(declaration)->type;
+			}
+			break;
+		}
+
+		case NodeKind::FunctionCallOperation:
+		{
+			Identifier* func = dyn_cast<Identifier>(cast<FunctionCallOperation>(expression)->func_expr);
+			if (func && func->declaration && func->declaration->kind == NodeKind::FunctionDeclaration)
+			{
+				type = cast<FunctionDeclaration>(func->declaration)->return_type;
+			}
+			break;
+		}
+
+		case NodeKind::UnsafeExpression:
+			expression->is_unsigned = cast<UnsafeExpression>(expression)->expression->is_unsigned;
+			return;
+
+		case NodeKind::UnaryOperation:
+		{
+			UnaryOperation* operation = cast<UnaryOperation>(expression);
+			expression->is_unsigned = (operation->op == TokenType::plus || operation->op == TokenType::minus || operation->op == TokenType::bit_not) &&
+				operation->rhs->is_unsigned;
+			return;
+		}
+
+		case NodeKind::BinaryOperation:
+		{
+			BinaryOperation* operation = cast<BinaryOperation>(expression);
+			switch (operation->op)
+			{
+			case TokenType::equal:
+			case TokenType::noteq:
+			case TokenType::less:
+			case TokenType::eqless:
+			case TokenType::greater:
+			case TokenType::eqgreater:
+			case TokenType::logic_and:
+			case TokenType::logic_or:
+				expression->is_unsigned = false;
+				break;
+
+			case TokenType::plus:
+			case TokenType::minus:
+			case TokenType::multiply:
+			case TokenType::divide:
+			case TokenType::modulo:
+			case TokenType::bit_and:
+			case TokenType::bit_or:
+			case TokenType::bit_xor:
+				expression->is_unsigned = operation->lhs->is_unsigned || operation->rhs->is_unsigned;
+				break;
+
+			default: // 대입 연산과 시프트 연산
+				expression->is_unsigned = operation->lhs->is_unsigned;
+				break;
+			}
+			return;
+		}
+
+		default:
+			break;
+		}
+
+		SimpleType* simple_type = type ? dyn_cast<SimpleType>(type) : nullptr;
+		expression->is_unsigned = simple_type && simple_type->is_unsigned;
+	}
+}
@@ -0,0 +1,238 @@
+#include "Scanner.hh"
+
+#if defined(__AVX2__)
+#	define DLINK_SCANNER_AVX2
+#	include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define DLINK_SCANNER_SSE2
+#	include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#	include <intrin.h>
+#endif
+
+namespace Dlink
+{
+#define A (char_alpha | char_identifier)
+#define H (char_alpha | char_identifier | char_hex)
+#define D (char_digit | char_identifier | char_hex)
+#define U (char_identifier)
+#define S (char_space)
+
+	/**
+	 * @brief 문자 분류 테이블입니다.
+	 * @details unsigned char로 변환한 문자를 인덱스로 사용합니다.
+	 * @see Dlink::CharClass
+	 */
+	const std::uint8_t char_class_table[256] =
+	{
+	//	NUL  SOH  STX  ETX  EOT  ENQ  ACK  BEL  BS   HT   LF   VT   FF   CR   SO   SI
+		0,   0,   0,   0,   0,   0,   0,   0,   0,   S,   S,   S,   S,   S,   0,   0,
+	//	DLE  DC1  DC2  DC3  DC4  NAK  SYN  ETB  CAN  EM   SUB  ESC  FS   GS   RS   US
+		0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+	//	SP   !    "    #    $    %    &    '    (    )    *    +    ,    -    .    /
+		S,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+	//	0    1    2    3    4    5    6    7    8    9    :    ;    <    =    >    ?
+		D,   D,   D,   D,   D,   D,   D,   D,   D,   D,   0,   0,   0,   0,   0,   0,
+	//	@    A    B    C    D    E    F    G    H    I    J    K    L    M    N    O
+		0,   H,   H,   H,   H,   H,   H,   A,   A,   A,   A,   A,   A,   A,   A,   A,
+	//	P    Q    R    S    T    U    V    W    X    Y    Z    [    \    ]    ^    _
+		A,   A,   A,   A,   A,   A,   A,   A,   A,   A,   A,   0,   0,   0,   0,   U,
+	//	`    a    b    c    d    e    f    g    h    i    j    k    l    m    n    o
+		0,   H,   H,   H,   H,   H,   H,   A,   A,   A,   A,   A,   A,   A,   A,   A,
+	//	p    q    r    s    t    u    v    w    x    y    z    {    |    }    ~    DEL
+		A,   A,   A,   A,   A,   A,   A,   A,   A,   A,   A,   0,   0,   0,   0,   0,
+	};
+
+#undef A
+#undef H
+#undef D
+#undef U
+#undef S
+
+	namespace
+	{
+		inline unsigned count_trailing_zeros(std::uint32_t mask) noexcept
+		{
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return static_cast<unsigned>(index);
+#else
+			return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+		}
+
+#if defined(DLINK_SCANNER_AVX2)
+		using Block = __m256i;
+		constexpr std::size_t block_size = 32;
+
+		inline Block load(const char* ptr) noexcept
+		{
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+		}
+		inline Block equal(Block block, char ch) noexcept
+		{
+			return _mm256_cmpeq_epi8(block, _mm256_set1_epi8(ch));
+		}
+		// lo <= ch && ch <= hi 를 부호 있는 비교 한 번으로 검사합니다.
+		inline Block in_range(Block block, char lo, char hi) noexcept
+		{
+			Block shifted = _mm256_add_epi8(block, _mm256_set1_epi8(static_cast<char>(0x80 - lo)));
+			return _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(-128 + (hi - lo) + 1)), shifted);
+		}
+		inline Block either(Block lhs, Block rhs) noexcept
+		{
+			return _mm256_or_si256(lhs, rhs);
+		}
+		inline Block both(Block lhs, Block rhs) noexcept
+		{
+			return _mm256_and_si256(lhs, rhs);
+		}
+		inline Block to_lower(Block block) noexcept
+		{
+			return _mm256_or_si256(block, _mm256_set1_epi8(0x20));
+		}
+		inline std::uint32_t to_mask(Block block) noexcept
+		{
+			return static_cast<std::uint32_t>(_mm256_movemask_epi8(block));
+		}
+#elif defined(DLINK_SCANNER_SSE2)
+		using Block = __m128i;
+		constexpr std::size_t block_size = 16;
+
+		inline Block load(const char* ptr) noexcept
+		{
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+		}
+		inline Block equal(Block block, char ch) noexcept
+		{
+			return _mm_cmpeq_epi8(block, _mm_set1_epi8(ch));
+		}
+		// lo <= ch && ch <= hi 를 부호 있는 비교 한 번으로 검사합니다.
+		inline Block in_range(Block block, char lo, char hi) noexcept
+		{
+			Block shifted = _mm_add_epi8(block, _mm_set1_epi8(static_cast<char>(0x80 - lo)));
+			return _mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(-128 + (hi - lo) + 1)), shifted);
+		}
+		inline Block either(Block lhs, Block rhs) noexcept
+		{
+			return _mm_or_si128(lhs, rhs);
+		}
+		inline Block both(Block lhs, Block rhs) noexcept
+		{
+			return _mm_and_si128(lhs, rhs);
+		}
+		inline Block to_lower(Block block) noexcept
+		{
+			return _mm_or_si128(block, _mm_set1_epi8(0x20));
+		}
+		inline std::uint32_t to_mask(Block block) noexcept
+		{
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(block));
+		}
+#endif
+
+#if defined(DLINK_SCANNER_AVX2) || defined(DLINK_SCANNER_SSE2)
+		constexpr std::uint32_t full_mask = block_size == 32 ? 0xFFFFFFFFu : 0xFFFFu;
+
+		// 블록 단위로 검사하며 predicate를 만족하지 않는 첫 문자를 찾습니다. 남은 바이트는 테이블로 검사합니다.
+		template<typename Predicate_>
+		inline const char* scan_while(const char* begin, const char* end, CharClass char_class, Predicate_ predicate) noexcept
+		{
+			while (static_cast<std::size_t>(end - begin) >= block_size)
+			{
+				std::uint32_t mask = ~to_mask(predicate(load(begin))) & full_mask;
+				if (mask)
+				{
+					return begin + count_trailing_zeros(mask);
+				}
+				begin += block_size;
+			}
+
+			while (begin < end && is_char_class(*begin, char_class)) ++begin;
+			return begin;
+		}
+#else
+		template<typename Predicate_>
+		inline const char* scan_while(const char* begin, const char* end, CharClass char_class, Predicate_) noexcept
+		{
+			while (begin < end && is_char_class(*begin, char_class)) ++begin;
+			return begin;
+		}
+#endif
+	}
+
+	/**
+	 * @brief 식별자를 구성하는 문자(영문자, 숫자, '_')가 끝나는 위치를 찾습니다.
+	 * @details SSE2나 AVX2를 사용할 수 있으면 16~32바이트씩 검사합니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param begin 검사를 시작할 위치입니다.
+	 * @param end 버퍼의 끝입니다. 이 위치를 넘어서 읽지 않습니다.
+	 * @return 식별자를 구성하지 않는 첫 문자의 위치를 반환합니다. 없으면 end를 반환합니다.
+	 */
+	const char* scan_identifier(const char* begin, const char* end) noexcept
+	{
+		return scan_while(begin, end, char_identifier, [](auto block)
+		{
+			return either(either(in_range(to_lower(block), 'a', 'z'), in_range(block, '0', '9')), equal(block, '_'));
+		});
+	}
+	/**
+	 * @brief 10진 숫자가 끝나는 위치를 찾습니다.
+	 * @details SSE2나 AVX2를 사용할 수 있으면 16~32바이트씩 검사합니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param begin 검사를 시작할 위치입니다.
+	 * @param end 버퍼의 끝입니다. 이 위치를 넘어서 읽지 않습니다.
+	 * @return 10진 숫자가 아닌 첫 문자의 위치를 반환합니다. 없으면 end를 반환합니다.
+	 */
+	const char* scan_digits(const char* begin, const char* end) noexcept
+	{
+		return scan_while(begin, end, char_digit, [](auto block)
+		{
+			return in_range(block, '0', '9');
+		});
+	}
+	/**
+	 * @brief 공백 문자가 끝나는 위치를 찾습니다.
+	 * @details SSE2나 AVX2를 사용할 수 있으면 16~32바이트씩 검사합니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param begin 검사를 시작할 위치입니다.
+	 * @param end 버퍼의 끝입니다. 이 위치를 넘어서 읽지 않습니다.
+	 * @return 공백 문자가 아닌 첫 문자의 위치를 반환합니다. 없으면 end를 반환합니다.
+	 */
+	const char* scan_space(const char* begin, const char* end) noexcept
+	{
+		return scan_while(begin, end, char_space, [](auto block)
+		{
+			return either(equal(block, ' '), in_range(block, '\t', '\r'));
+		});
+	}
+	/**
+	 * @brief 여러 줄 주석을 닫는 "*\/"의 위치를 찾습니다.
+	 * @details SSE2나 AVX2를 사용할 수 있으면 16~32바이트씩 검사합니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @param begin 검사를 시작할 위치입니다. 주석을 여는 "/\*"의 바로 뒤여야 합니다.
+	 * @param end 버퍼의 끝입니다. 이 위치를 넘어서 읽지 않습니다.
+	 * @return "*\/"의 '*' 위치를 반환합니다. 주석이 닫히지 않았다면 end를 반환합니다.
+	 */
+	const char* find_comment_end(const char* begin, const char* end) noexcept
+	{
+#if defined(DLINK_SCANNER_AVX2) || defined(DLINK_SCANNER_SSE2)
+		// '/'를 한 바이트 뒤에서 읽으므로 블록보다 한 바이트가 더 남아 있어야 합니다.
+		while (static_cast<std::size_t>(end - begin) > block_size)
+		{
+			std::uint32_t mask = to_mask(both(equal(load(begin), '*'), equal(load(begin + 1), '/')));
+			if (mask)
+			{
+				return begin + count_trailing_zeros(mask);
+			}
+			begin += block_size;
+		}
+#endif
+
+		for (; begin + 1 < end; ++begin)
+		{
+			if (begin[0] == '*' && begin[1] == '/') return begin;
+		}
+
+		return end;
+	}
+}
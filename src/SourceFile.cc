@@ -0,0 +1,256 @@
+#include "SourceFile.hh"
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#ifdef _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace Dlink
+{
+	/**
+	 * @brief 빈 SourceFile 인스턴스를 만듭니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 */
+	SourceFile::SourceFile() noexcept
+		: data_(""), size_(0), mapping_(nullptr)
+#ifdef _WIN32
+		, file_handle_(nullptr), mapping_handle_(nullptr)
+#endif
+	{}
+	/**
+	 * @brief 메모리에 있는 Dlink 코드로 새 SourceFile 인스턴스를 만듭니다.
+	 * @details 파일을 매핑하지 않고 code를 복사해 보관합니다.
+	 * @param code Dlink 코드입니다.
+	 */
+	SourceFile::SourceFile(const std::string& code)
+		: SourceFile()
+	{
+		code_ = code;
+		data_ = code_.data();
+		size_ = code_.size();
+	}
+	/**
+	 * @brief 기존 인스턴스의 필드를 이동해 새 SourceFile 인스턴스를 만듭니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param source_file 이동할 기존 인스턴스입니다.
+	 */
+	SourceFile::SourceFile(SourceFile&& source_file) noexcept
+		: SourceFile()
+	{
+		*this = std::move(source_file);
+	}
+	SourceFile::~SourceFile()
+	{
+		close();
+	}
+
+	/**
+	 * @brief 다른 SourceFile 인스턴스의 필드를 현재 인스턴스로 이동합니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param source_file 이동할 다른 인스턴스입니다.
+	 * @return 현재 인스턴스를 반환합니다.
+	 */
+	SourceFile& SourceFile::operator=(SourceFile&& source_file) noexcept
+	{
+		if (this == &source_file)
+			return *this;
+
+		close();
+
+		path_ = std::move(source_file.path_);
+		code_ = std::move(source_file.code_);
+		size_ = source_file.size_;
+		mapping_ = source_file.mapping_;
+#ifdef _WIN32
+		file_handle_ = source_file.file_handle_;
+		mapping_handle_ = source_file.mapping_handle_;
+		source_file.file_handle_ = nullptr;
+		source_file.mapping_handle_ = nullptr;
+#endif
+		// 매핑하지 않은 코드는 code_가 이동하면서 주소가 바뀔 수 있습니다.
+		data_ = mapping_ ? source_file.data_ : code_.data();
+
+		source_file.data_ = "";
+		source_file.size_ = 0;
+		source_file.mapping_ = nullptr;
+
+		return *this;
+	}
+
+	/**
+	 * @brief 파일을 읽기 전용으로 메모리에 매핑합니다.
+	 * @details 이미 열려 있는 버퍼는 닫힙니다. 크기가 0인 파일은 매핑하지 않고 빈 버퍼로 취급합니다. 토큰은 32비트 오프셋을 사용하므로 4GiB 이상인 파일은 열 수 없습니다.
+	 * @param path 매핑할 파일의 경로입니다.
+	 * @return 매핑에 성공하면 true, 실패하면 false를 반환합니다.
+	 */
+	bool SourceFile::open(const std::string& path)
+	{
+		close();
+
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file, &file_size) || static_cast<unsigned long long>(file_size.QuadPart) > std::numeric_limits<std::uint32_t>::max())
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		path_ = path;
+		if (file_size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return true;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!view)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		file_handle_ = file;
+		mapping_handle_ = mapping;
+		mapping_ = view;
+		size_ = static_cast<std::size_t>(file_size.QuadPart);
+#else
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat file_stat;
+		if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) ||
+			static_cast<unsigned long long>(file_stat.st_size) > std::numeric_limits<std::uint32_t>::max())
+		{
+			::close(fd);
+			return false;
+		}
+
+		path_ = path;
+		if (file_stat.st_size == 0)
+		{
+			::close(fd);
+			return true;
+		}
+
+		void* view = mmap(nullptr, static_cast<std::size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+
+		if (view == MAP_FAILED)
+			return false;
+
+		madvise(view, static_cast<std::size_t>(file_stat.st_size), MADV_SEQUENTIAL);
+
+		mapping_ = view;
+		size_ = static_cast<std::size_t>(file_stat.st_size);
+#endif
+		data_ = static_cast<const char*>(mapping_);
+
+		return true;
+	}
+	/**
+	 * @brief 버퍼를 닫습니다. 이 인스턴스의 버퍼를 가리키던 토큰들은 더 이상 사용할 수 없습니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 */
+	void SourceFile::close() noexcept
+	{
+		if (mapping_)
+		{
+#ifdef _WIN32
+			UnmapViewOfFile(mapping_);
+			CloseHandle(mapping_handle_);
+			CloseHandle(file_handle_);
+			mapping_handle_ = nullptr;
+			file_handle_ = nullptr;
+#else
+			munmap(mapping_, size_);
+#endif
+			mapping_ = nullptr;
+		}
+
+		path_.clear();
+		code_.clear();
+		data_ = "";
+		size_ = 0;
+	}
+	/**
+	 * @brief 매핑한 파일의 내용을 복사해 보관하고 매핑을 해제합니다.
+	 * @details 파일을 매핑한 동안 다른 프로세스가 파일을 고쳐 쓰면 버퍼의 내용이 바뀔 수 있고, 파일이 잘리면 잘린 부분을 읽을 때 프로그램이 종료됩니다. 오래 보관할 버퍼는 이 함수로 파일과 분리합니다.
+	 * 경로는 그대로 유지합니다. 매핑하지 않은 버퍼라면 아무것도 하지 않습니다. 버퍼의 시작 주소가 바뀌지만, 토큰은 오프셋을 사용하므로 이 인스턴스의 토큰들은 계속 사용할 수 있습니다.
+	 */
+	void SourceFile::detach()
+	{
+		if (!mapping_)
+			return;
+
+		std::string code(data_, size_);
+		std::string path = std::move(path_);
+
+		close();
+
+		path_ = std::move(path);
+		code_ = std::move(code);
+		data_ = code_.data();
+		size_ = code_.size();
+	}
+
+	/**
+	 * @brief 버퍼의 시작 주소를 가져옵니다.
+	 * @details 버퍼는 null 문자로 끝나지 않을 수 있습니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 버퍼의 시작 주소를 반환합니다.
+	 */
+	const char* SourceFile::data() const noexcept
+	{
+		return data_;
+	}
+	/**
+	 * @brief 버퍼의 크기를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 버퍼의 크기를 바이트 단위로 반환합니다.
+	 */
+	std::size_t SourceFile::size() const noexcept
+	{
+		return size_;
+	}
+	/**
+	 * @brief 매핑한 파일의 경로를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 파일의 경로를 반환합니다. 메모리에 있는 코드라면 빈 문자열을 반환합니다.
+	 */
+	const std::string& SourceFile::path() const noexcept
+	{
+		return path_;
+	}
+	/**
+	 * @brief 토큰이 가리키는 원본 문장을 복사해 가져옵니다.
+	 * @param token 이 버퍼에서 만들어진 토큰입니다.
+	 * @return 토큰의 원본 문장을 반환합니다.
+	 */
+	std::string SourceFile::text(const Token& token) const
+	{
+		return std::string(data_ + token.offset, token.length);
+	}
+}
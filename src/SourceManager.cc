@@ -0,0 +1,68 @@
+#include "SourceManager.hh"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Dlink
+{
+	/**
+	 * @brief 새 SourceManager 인스턴스를 만듭니다.
+	 * @details 색인은 아직 만들지 않습니다. source는 SourceManager를 사용하는 동안 살아있어야 합니다.
+	 * @param source 위치를 계산할 소스 버퍼입니다.
+	 */
+	SourceManager::SourceManager(const SourceFile& source)
+		: source_(source)
+	{}
+
+	/**
+	 * @brief 오프셋에 해당하는 줄 번호와 세로단 번호를 계산합니다.
+	 * @details 줄 시작 색인에서 이진 탐색하므로 O(log n)입니다. 여러 스레드에서 동시에 호출할 수 있습니다.
+	 * @param offset 소스 버퍼에서의 오프셋입니다.
+	 * @return 오프셋의 위치를 반환합니다.
+	 */
+	SourceLocation SourceManager::location(std::uint32_t offset) const
+	{
+		std::call_once(line_index_flag_, &SourceManager::build_line_index_, this);
+
+		auto line = std::upper_bound(line_starts_.begin(), line_starts_.end(), offset) - 1;
+
+		SourceLocation result;
+		result.line = static_cast<std::size_t>(line - line_starts_.begin()) + 1;
+		result.col = static_cast<std::size_t>(offset - *line) + 1;
+		return result;
+	}
+	/**
+	 * @brief 토큰이 시작되는 위치의 줄 번호와 세로단 번호를 계산합니다.
+	 * @details 여러 스레드에서 동시에 호출할 수 있습니다.
+	 * @param token 이 소스 버퍼에서 만들어진 토큰입니다.
+	 * @return 토큰의 위치를 반환합니다.
+	 */
+	SourceLocation SourceManager::location(const Token& token) const
+	{
+		return location(token.offset);
+	}
+	/**
+	 * @brief 위치를 계산하는 소스 버퍼를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 소스 버퍼를 반환합니다.
+	 */
+	const SourceFile& SourceManager::get_source() const noexcept
+	{
+		return source_;
+	}
+
+	void SourceManager::build_line_index_() const
+	{
+		const char* code = source_.data();
+		const std::size_t size = source_.size();
+
+		line_starts_.push_back(0);
+
+		std::size_t i = 0;
+		while (const void* newline = std::memchr(code + i, '\n', size - i))
+		{
+			i = static_cast<std::size_t>(static_cast<const char*>(newline) - code) + 1;
+			line_starts_.push_back(static_cast<std::uint32_t>(i));
+		}
+	}
+}
@@ -0,0 +1,156 @@
+#include "Symbol.hh"
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace Dlink
+{
+	namespace
+	{
+		// 해시 테이블의 키입니다. 인터닝된 문자열 또는 찾고 있는 문자열의 일부분을 복사하지 않고 가리킵니다.
+		struct SymbolKey final
+		{
+			const char* data;
+			std::size_t length;
+			std::size_t hash;
+
+			bool operator==(const SymbolKey& key) const noexcept
+			{
+				return length == key.length && std::memcmp(data, key.data, length) == 0;
+			}
+		};
+		// FNV-1a 해시입니다.
+		std::size_t hash_key(const char* data, std::size_t length) noexcept
+		{
+			std::uint64_t hash = 14695981039346656037ull;
+			for (std::size_t i = 0; i < length; ++i)
+			{
+				hash ^= static_cast<unsigned char>(data[i]);
+				hash *= 1099511628211ull;
+			}
+			return static_cast<std::size_t>(hash);
+		}
+		struct SymbolKeyHash final
+		{
+			std::size_t operator()(const SymbolKey& key) const noexcept
+			{
+				return key.hash;
+			}
+		};
+
+		// 렉서가 여러 스레드에서 동시에 인터닝하므로, 해시 값에 따라 잠금을 나눠 경합을 줄입니다.
+		struct InternShard final
+		{
+			std::mutex mutex;
+			std::unordered_map<SymbolKey, const std::string*, SymbolKeyHash> map;
+			std::deque<std::string> strings;
+		};
+
+		constexpr std::size_t shard_count = 16;
+
+		InternShard& intern_shard(std::size_t hash)
+		{
+			static InternShard shards[shard_count];
+			return shards[(hash >> 8) % shard_count];
+		}
+
+		const std::string empty_string;
+	}
+
+	/**
+	 * @brief 빈 Symbol 인스턴스를 만듭니다.
+	 * @details 빈 Symbol은 Symbol::intern("", 0)과 같습니다. 이 함수는 예외를 발생시키지 않습니다.
+	 */
+	Symbol::Symbol() noexcept
+		: str_(&empty_string)
+	{}
+	/**
+	 * @brief 문자열을 인터닝해 새 Symbol 인스턴스를 만듭니다.
+	 * @param str 인터닝할 문자열입니다.
+	 */
+	Symbol::Symbol(const std::string& str)
+		: Symbol(intern(str.data(), str.size()))
+	{}
+	/**
+	 * @brief 문자열을 인터닝해 새 Symbol 인스턴스를 만듭니다.
+	 * @param str 인터닝할 null 종료 문자열입니다.
+	 */
+	Symbol::Symbol(const char* str)
+		: Symbol(intern(str, std::strlen(str)))
+	{}
+	Symbol::Symbol(const std::string* str) noexcept
+		: str_(str)
+	{}
+
+	/**
+	 * @brief 두 Symbol 인스턴스가 같은 식별자인지 비교합니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param symbol 비교할 인스턴스입니다.
+	 * @return 같으면 true, 다르면 false를 반환합니다.
+	 */
+	bool Symbol::operator==(const Symbol& symbol) const noexcept
+	{
+		return str_ == symbol.str_;
+	}
+	/**
+	 * @brief 두 Symbol 인스턴스가 다른 식별자인지 비교합니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param symbol 비교할 인스턴스입니다.
+	 * @return 같으면 false, 다르면 true를 반환합니다.
+	 */
+	bool Symbol::operator!=(const Symbol& symbol) const noexcept
+	{
+		return str_ != symbol.str_;
+	}
+
+	/**
+	 * @brief 문자열을 인터닝합니다.
+	 * @details 처음 보는 철자일 때만 문자열을 복사합니다. 여러 스레드에서 동시에 호출할 수 있습니다.
+	 * @param data 인터닝할 문자열입니다. null 문자로 끝나지 않아도 됩니다.
+	 * @param length 인터닝할 문자열의 길이입니다.
+	 * @return 인터닝된 Symbol을 반환합니다.
+	 */
+	Symbol Symbol::intern(const char* data, std::size_t length)
+	{
+		if (length == 0) return Symbol();
+
+		const std::size_t hash = hash_key(data, length);
+		InternShard& shard = intern_shard(hash);
+
+		std::lock_guard<std::mutex> lock(shard.mutex);
+
+		auto iter = shard.map.find(SymbolKey{ data, length, hash });
+		if (iter != shard.map.end())
+		{
+			return Symbol(iter->second);
+		}
+
+		shard.strings.emplace_back(data, length);
+		const std::string* str = &shard.strings.back();
+		shard.map.emplace(SymbolKey{ str->data(), str->size(), hash }, str);
+
+		return Symbol(str);
+	}
+
+	/**
+	 * @brief 식별자의 철자를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 식별자의 철자를 반환합니다.
+	 */
+	const std::string& Symbol::str() const noexcept
+	{
+		return *str_;
+	}
+	/**
+	 * @brief 빈 Symbol인지 확인합니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 비어 있으면 true, 비어 있지 않으면 false를 반환합니다.
+	 */
+	bool Symbol::empty() const noexcept
+	{
+		return str_->empty();
+	}
+}
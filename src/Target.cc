@@ -0,0 +1,129 @@
+#include "Target.hh"
+
+#include <mutex>
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/MC/SubtargetFeature.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Target/TargetOptions.h"
+
+namespace Dlink
+{
+	/**
+	 * @brief LLVM이 지원하는 모든 대상 머신을 초기화합니다.
+	 * @details 여러 번 호출하거나 여러 스레드에서 동시에 호출해도 처음 한 번만 초기화합니다.
+	 */
+	void initialize_targets()
+	{
+		static std::once_flag initialized;
+		std::call_once(initialized, []()
+		{
+			llvm::InitializeAllTargetInfos();
+			llvm::InitializeAllTargets();
+			llvm::InitializeAllTargetMCs();
+			llvm::InitializeAllAsmPrinters();
+		});
+	}
+	/**
+	 * @brief 코드를 만들 대상 플랫폼의 트리플을 가져옵니다.
+	 * @param options 컴파일 설정입니다.
+	 * @return 설정된 트리플을, 설정되지 않았다면 현재 플랫폼의 트리플을 반환합니다.
+	 */
+	std::string get_target_triple(const CompileOptions& options)
+	{
+		if (options.target_triple.empty())
+		{
+			return llvm::sys::getDefaultTargetTriple();
+		}
+		return llvm::Triple::normalize(options.target_triple);
+	}
+	/**
+	 * @brief 최적화 레벨에 맞는 코드 생성 최적화 레벨을 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @param options 컴파일 설정입니다.
+	 * @return 최적화 레벨이 0이면 None을, 1이면 Less를, 2이면 Default를, 3 이상이면 Aggressive를 반환합니다.
+	 */
+	llvm::CodeGenOpt::Level get_code_gen_opt_level(const CompileOptions& options) noexcept
+	{
+		if (options.opt_level == 1)
+		{
+			return llvm::CodeGenOpt::Less;
+		}
+		else if (options.opt_level == 2)
+		{
+			return llvm::CodeGenOpt::Default;
+		}
+		else if (options.opt_level >= 3)
+		{
+			return llvm::CodeGenOpt::Aggressive;
+		}
+		return llvm::CodeGenOpt::None;
+	}
+	/**
+	 * @brief 컴파일 설정에 맞는 대상 CPU와 기능 문자열을 가져옵니다.
+	 * @details CPU가 설정되지 않았다면 generic을 사용하며, native라면 현재 플랫폼의 CPU와 그 CPU가 지원하는 기능들을 사용합니다.
+	 * @param options 컴파일 설정입니다.
+	 * @param cpu 대상 CPU의 이름을 저장할 문자열입니다.
+	 * @param features 대상 CPU에서 켜거나 끌 기능들을 저장할 문자열입니다. native가 아니라면 빈 문자열입니다.
+	 */
+	void get_target_cpu(const CompileOptions& options, std::string& cpu, std::string& features)
+	{
+		cpu = options.target_cpu.empty() ? "generic" : options.target_cpu;
+		features.clear();
+		if (cpu == "native")
+		{
+			cpu = llvm::sys::getHostCPUName().str();
+
+			llvm::SubtargetFeatures feature_list;
+			llvm::StringMap<bool> host_features;
+			if (llvm::sys::getHostCPUFeatures(host_features))
+			{
+				for (const llvm::StringMapEntry<bool>& feature : host_features)
+				{
+					feature_list.AddFeature(feature.first(), feature.second);
+				}
+			}
+			features = feature_list.getString();
+		}
+	}
+	/**
+	 * @brief 컴파일 설정에 맞는 새 대상 머신을 만듭니다.
+	 * @details 대상 머신은 스레드 사이에 공유할 수 없으므로, 코드를 만드는 스레드마다 따로 만들어야 합니다.
+	 * 대상 CPU와 기능들은 get_target_cpu 함수로 정합니다.
+	 * @param options 컴파일 설정입니다.
+	 * @param error 대상 머신을 만들지 못했을 경우 오류 메세지를 저장할 문자열입니다.
+	 * @return 만든 대상 머신을, 만들지 못했을 경우 nullptr을 반환합니다.
+	 */
+	std::unique_ptr<llvm::TargetMachine> create_target_machine(const CompileOptions& options, std::string& error)
+	{
+		initialize_targets();
+
+		const std::string triple = get_target_triple(options);
+		const llvm::Target* target = llvm::TargetRegistry::lookupTarget(triple, error);
+		if (!target)
+			return nullptr;
+
+		std::string cpu;
+		std::string features;
+		get_target_cpu(options, cpu, features);
+
+		std::unique_ptr<llvm::TargetMachine> target_machine(target->createTargetMachine(triple, cpu, features, llvm::TargetOptions(),
+			llvm::Reloc::PIC_, llvm::None, get_code_gen_opt_level(options)));
+		if (!target_machine)
+		{
+			error = "Couldn't create a target machine for \"" + triple + "\"";
+			return nullptr;
+		}
+		if (cpu != "generic" && !target_machine->getMCSubtargetInfo()->isCPUStringValid(cpu))
+		{
+			error = "\"" + cpu + "\" is not a recognized processor for \"" + triple + "\"";
+			return nullptr;
+		}
+
+		return target_machine;
+	}
+}
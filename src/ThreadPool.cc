@@ -0,0 +1,87 @@
+#include "ThreadPool.hh"
+
+namespace Dlink
+{
+	/**
+	 * @brief 새 ThreadPool 인스턴스를 만들고 작업 스레드들을 시작합니다.
+	 * @details 작업 스레드를 만들지 못하면 이미 시작한 작업 스레드들을 종료한 뒤 예외를 다시 발생시킵니다.
+	 * @param thread_count 작업 스레드의 개수입니다. 0이면 하드웨어가 동시에 실행할 수 있는 스레드의 개수를 사용합니다.
+	 */
+	ThreadPool::ThreadPool(std::size_t thread_count)
+		: stop_(false)
+	{
+		if (thread_count == 0)
+		{
+			thread_count = std::thread::hardware_concurrency();
+			if (thread_count == 0) thread_count = 1;
+		}
+
+		threads_.reserve(thread_count);
+		try
+		{
+			for (std::size_t i = 0; i < thread_count; ++i)
+			{
+				threads_.emplace_back(&ThreadPool::work_, this);
+			}
+		}
+		catch (...)
+		{
+			// 소멸자가 호출되지 않으므로, 이미 시작한 작업 스레드들을 직접 종료해야 std::terminate가 호출되지 않습니다.
+			stop_all_();
+			throw;
+		}
+	}
+	/**
+	 * @brief 이미 제출된 작업들을 모두 끝낸 뒤 작업 스레드들을 종료합니다.
+	 */
+	ThreadPool::~ThreadPool()
+	{
+		stop_all_();
+	}
+
+	/**
+	 * @brief 작업 스레드의 개수를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 작업 스레드의 개수를 반환합니다.
+	 */
+	std::size_t ThreadPool::size() const noexcept
+	{
+		return threads_.size();
+	}
+
+	void ThreadPool::stop_all_()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+		}
+		condition_.notify_all();
+
+		for (std::thread& thread : threads_)
+		{
+			thread.join();
+		}
+	}
+	void ThreadPool::work_()
+	{
+		while (true)
+		{
+			std::function<void()> task;
+
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				condition_.wait(lock, [this]()
+				{
+					return stop_ || !tasks_.empty();
+				});
+
+				if (tasks_.empty()) return;
+
+				task = std::move(tasks_.front());
+				tasks_.pop();
+			}
+
+			task();
+		}
+	}
+}
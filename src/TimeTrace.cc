@@ -0,0 +1,143 @@
+#include "TimeTrace.hh"
+#include "JSON.hh"
+
+#include <algorithm>
+#include <system_error>
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+namespace Dlink
+{
+	namespace
+	{
+		void write_microseconds(llvm::raw_ostream& stream, std::uint64_t nanoseconds)
+		{
+			// Chrome trace-event 형식의 시간 단위는 마이크로초이므로, 나노초는 소수점 아래에 씁니다.
+			const std::uint64_t fraction = nanoseconds % 1000;
+
+			stream << nanoseconds / 1000 << '.';
+			if (fraction < 100) stream << '0';
+			if (fraction < 10) stream << '0';
+			stream << fraction;
+		}
+	}
+
+	/**
+	 * @brief 이벤트 하나의 기록을 시작합니다.
+	 * @param time_trace 이벤트를 기록할 TimeTrace 인스턴스입니다. nullptr이면 기록하지 않습니다.
+	 * @param name 이벤트의 이름입니다.
+	 * @param detail 이벤트의 대상을 나타내는 문자열입니다. 함수의 이름 등을 지정합니다.
+	 */
+	TimeTrace::Scope::Scope(TimeTrace* time_trace, const char* name, const std::string& detail)
+		: time_trace_(time_trace), name_(name), detail_(time_trace ? detail : std::string()), begin_(time_trace ? time_trace->now() : 0)
+	{}
+	/**
+	 * @brief 이벤트를 기록합니다.
+	 */
+	TimeTrace::Scope::~Scope()
+	{
+		if (time_trace_)
+		{
+			time_trace_->add_event(name_, detail_, begin_, time_trace_->now());
+		}
+	}
+
+	/**
+	 * @brief 새 TimeTrace 인스턴스를 만듭니다.
+	 * @details 이벤트의 시간은 인스턴스를 만든 때를 기준으로 기록합니다.
+	 */
+	TimeTrace::TimeTrace()
+		: start_(std::chrono::steady_clock::now())
+	{}
+
+	/**
+	 * @brief 인스턴스를 만든 때부터 지금까지 지난 시간을 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 지난 시간(나노초)을 반환합니다.
+	 */
+	std::uint64_t TimeTrace::now() const noexcept
+	{
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+	}
+	/**
+	 * @brief 현재 스레드에서 일어난 이벤트 하나를 기록합니다.
+	 * @param name 이벤트의 이름입니다.
+	 * @param detail 이벤트의 대상을 나타내는 문자열입니다. 비어 있으면 쓰지 않습니다.
+	 * @param begin 이벤트가 시작한 시간입니다. now 함수의 반환 값입니다.
+	 * @param end 이벤트가 끝난 시간입니다. now 함수의 반환 값입니다.
+	 */
+	void TimeTrace::add_event(const std::string& name, const std::string& detail, std::uint64_t begin, std::uint64_t end)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		const std::size_t thread = threads_.emplace(std::this_thread::get_id(), threads_.size()).first->second;
+		events_.push_back({ name, detail, begin, end, thread });
+	}
+	/**
+	 * @brief 기록한 이벤트들을 Chrome trace-event JSON 파일로 씁니다.
+	 * @details 이벤트는 스레드마다 시작한 시간 순서대로, 시작한 시간이 같다면 긴 것부터 씁니다. 스레드는 처음 이벤트를 기록한 순서대로 번호를 붙입니다.
+	 * @param path 파일을 쓸 경로입니다.
+	 * @return 파일을 썼을 경우 true를, 실패했을 경우 false를 반환합니다.
+	 */
+	bool TimeTrace::write(const std::string& path)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		std::error_code error_code;
+		llvm::raw_fd_ostream stream(path, error_code, llvm::sys::fs::OF_Text);
+
+		if (error_code)
+		{
+			error_ = "Couldn't open \"" + path + "\": " + error_code.message();
+			return false;
+		}
+
+		std::sort(events_.begin(), events_.end(), [](const Event_& lhs, const Event_& rhs)
+		{
+			if (lhs.thread != rhs.thread) return lhs.thread < rhs.thread;
+			if (lhs.begin != rhs.begin) return lhs.begin < rhs.begin;
+			return lhs.end > rhs.end;
+		});
+
+		stream << "{\"traceEvents\":[\n";
+		std::string escaped;
+		for (const Event_& event : events_)
+		{
+			escaped.clear();
+			append_json_string(escaped, event.name);
+			stream << "{\"name\":" << escaped;
+			stream << ",\"cat\":\"Dlink\",\"ph\":\"X\",\"ts\":";
+			write_microseconds(stream, event.begin);
+			stream << ",\"dur\":";
+			write_microseconds(stream, event.end - event.begin);
+			stream << ",\"pid\":1,\"tid\":" << event.thread;
+
+			if (!event.detail.empty())
+			{
+				escaped.clear();
+				append_json_string(escaped, event.detail);
+				stream << ",\"args\":{\"detail\":" << escaped << '}';
+			}
+			stream << "},\n";
+		}
+		for (std::size_t thread = 0; thread < threads_.size(); ++thread)
+		{
+			stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread;
+			stream << ",\"args\":{\"name\":\"Thread " << thread << "\"}},\n";
+		}
+		stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Dlink\"}}\n";
+		stream << "],\"displayTimeUnit\":\"ms\"}\n";
+
+		return true;
+	}
+	/**
+	 * @brief write 함수가 실패한 이유를 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 오류 메세지를 반환합니다.
+	 */
+	const std::string& TimeTrace::get_error() const noexcept
+	{
+		return error_;
+	}
+}
@@ -106,14 +106,24 @@ namespace Dlink
 
 #undef MAP_TOKEN
 
+	static_assert(keyword_type("unsafe", 6) == TokenType::unsafe, "keyword_type");
+	static_assert(keyword_type("case", 4) == TokenType::_case, "keyword_type");
+	static_assert(keyword_type("char", 4) == TokenType::_char, "keyword_type");
+	static_assert(keyword_type("switch", 6) == TokenType::_switch, "keyword_type");
+	static_assert(keyword_type("signed", 6) == TokenType::_signed, "keyword_type");
+	static_assert(keyword_type("unsigned", 8) == TokenType::_unsigned, "keyword_type");
+	static_assert(keyword_type("literal", 7) == TokenType::identifier, "keyword_type");
+	static_assert(keyword_type("cast", 4) == TokenType::identifier, "keyword_type");
+	static_assert(keyword_type("main", 4) == TokenType::identifier, "keyword_type");
+	static_assert(keyword_type("i", 1) == TokenType::identifier, "keyword_type");
+
 	/**
 	 *@brief 새 Token 인스턴스를 만듭니다.
-	 *@param data 토큰의 원본 문장입니다.
+	 *@param offset 토큰의 원본 문장이 소스 버퍼에서 시작되는 오프셋입니다.
+	 *@param length 토큰의 원본 문장의 길이입니다.
 	 *@param type 토큰의 타입입니다.
-	 *@param line 토큰의 줄 번호입니다.
-	 *@param end_col 토큰이 끝나는 위치의 세로단 번호입니다.
 	 */
-	Token::Token(const std::string& data, TokenType type, const std::size_t line, const std::size_t end_col)
-		:data(data), type(type), line(line), end_col(end_col), col(end_col - data.length() + 1)
+	Token::Token(std::uint32_t offset, std::uint32_t length, TokenType type)
+		:offset(offset), length(length), type(type)
 	{}
 }
\ No newline at end of file
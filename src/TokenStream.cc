@@ -0,0 +1,92 @@
+#include "TokenStream.hh"
+
+namespace Dlink
+{
+	/**
+	 * @brief 렉서로부터 토큰을 하나씩 가져오는 새 TokenStream 인스턴스를 만듭니다.
+	 * @details 렉싱 작업은 파서가 토큰을 요구할 때마다 조금씩 수행됩니다. 단, lexer가 이미 lex 함수로 토큰 목록을 만들었다면 그 목록을 읽습니다.
+	 * @param lexer 토큰을 가져올 렉서입니다.
+	 */
+	TokenStream::TokenStream(Lexer& lexer)
+		: lexer_(&lexer), token_seq_(nullptr), position_(0), fetched_(0)
+	{
+		if (!lexer.get_token_seq().empty())
+		{
+			lexer_ = nullptr;
+			token_seq_ = &lexer.get_token_seq();
+		}
+		else
+		{
+			fill_();
+		}
+	}
+	/**
+	 * @brief 이미 만들어진 토큰 목록을 읽는 새 TokenStream 인스턴스를 만듭니다.
+	 * @details 토큰 목록을 복사하지 않으므로, 스트림을 사용하는 동안에는 token_seq가 살아있어야 합니다. token_seq는 TokenType::eof 토큰으로 끝나야 합니다.
+	 * @param token_seq 읽을 토큰 목록입니다.
+	 */
+	TokenStream::TokenStream(const TokenSeq& token_seq)
+		: lexer_(nullptr), token_seq_(&token_seq), position_(0), fetched_(0)
+	{}
+
+	/**
+	 * @brief 현재 토큰을 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 현재 토큰을 반환합니다.
+	 */
+	const Token& TokenStream::current() const noexcept
+	{
+		return at_(position_);
+	}
+	/**
+	 * @brief 직전 토큰을 가져옵니다.
+	 * @details advance 함수를 한 번 이상 호출한 뒤에만 사용할 수 있습니다. 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 직전 토큰을 반환합니다.
+	 */
+	const Token& TokenStream::previous() const noexcept
+	{
+		return at_(position_ - 1);
+	}
+	/**
+	 * @brief 다음 토큰을 가져옵니다.
+	 * @details 이 함수는 예외를 발생시키지 않습니다.
+	 * @return 다음 토큰을 반환합니다.
+	 */
+	const Token& TokenStream::next() const noexcept
+	{
+		return at_(position_ + 1);
+	}
+	/**
+	 * @brief 다음 토큰으로 넘어갑니다.
+	 * @details TokenType::eof 토큰에 도달한 뒤에는 계속해서 TokenType::eof 토큰이 현재 토큰이 됩니다.
+	 */
+	void TokenStream::advance()
+	{
+		position_++;
+
+		if (lexer_)
+		{
+			fill_();
+		}
+	}
+
+	const Token& TokenStream::at_(std::size_t position) const noexcept
+	{
+		if (token_seq_)
+		{
+			return position < token_seq_->size() ? (*token_seq_)[position] : token_seq_->back();
+		}
+		else
+		{
+			return window_[position % window_size_];
+		}
+	}
+	void TokenStream::fill_()
+	{
+		while (fetched_ <= position_ + 1)
+		{
+			window_[fetched_ % window_size_] = lexer_->next_token();
+			fetched_++;
+		}
+	}
+}